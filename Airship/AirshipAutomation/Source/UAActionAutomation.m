@@ -117,6 +117,14 @@ NSString *const UAAutomationStoreFileFormat = @"Automation-%@.sqlite";
     self.automationEngine.delegate = nil;
 }
 
+- (void)airshipReady:(UAirship *)airship {
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAfter:airship.config.moduleActivationDelay block:^{
+        UA_STRONGIFY(self)
+        [self.automationEngine activateIfNeeded];
+    }];
+}
+
 - (void)onComponentEnableChange {
     if (self.componentEnabled) {
         // if component was disabled and is now enabled, resume automation engine
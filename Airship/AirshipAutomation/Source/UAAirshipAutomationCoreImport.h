@@ -31,6 +31,7 @@
 #import "UAEvent.h"
 #import "UAGlobal.h"
 #import "UAJSONMatcher.h"
+#import "UACompiledJSONPredicate.h"
 #import "UAJSONPredicate.h"
 #import "UAJSONValueMatcher.h"
 #import "UAModuleLoader.h"
@@ -6,6 +6,7 @@
 #import "UASchedule.h"
 #import "UAScheduleInfo.h"
 #import "UATimerScheduler+Internal.h"
+#import "UAScheduleTriggerPredicateCache+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -135,6 +136,11 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
  */
 @property (nonatomic, strong) UAAutomationStore *automationStore;
 
+/**
+ * Compiled trigger predicate cache. Exposes hit and miss counts.
+ */
+@property (nonatomic, readonly) UAScheduleTriggerPredicateCache *triggerPredicateCache;
+
 /**
  * Automation Engine constructor.
  *
@@ -165,10 +171,17 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
                                                date:(UADate *)date;
 
 /**
- * Starts the Automation Engine.
+ * Starts the Automation Engine. Store work is deferred until the engine is activated.
  */
 - (void)start;
 
+/**
+ * Activates the Automation Engine, opening its store and applying any trigger events
+ * received since start. Called on the first schedule query or mutation. If the engine
+ * is not started, activation happens on the next start.
+ */
+- (void)activateIfNeeded;
+
 /**
  * Stops the Automation Engine.
  */
@@ -269,6 +282,14 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
  */
 - (void)getAllSchedules:(void (^)(NSArray<UASchedule *> *))completionHandler;
 
+/**
+ * Gets the index entries of all in-app message schedules, including schedules that have ended,
+ * without building the schedules.
+ *
+ * @param completionHandler The completion handler with the result.
+ */
+- (void)getMessageScheduleIndex:(void (^)(NSArray<UAScheduleIndexEntry *> *))completionHandler;
+
 /**
  * Gets all schedules of the given group.
  *
@@ -290,6 +311,20 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
                      edits:(UAScheduleEdits *)edits
          completionHandler:(void (^)(UASchedule * __nullable))completionHandler;
 
+/**
+ * Edits existing schedules and creates new schedules in a single store transaction with one save.
+ * Delegate callbacks for the edits are delivered together once the transaction is saved.
+ *
+ * @param edits A map of schedule identifier to the edits to apply. Schedules that no longer exist are ignored.
+ * @param scheduleInfos The schedule infos for the new schedules. Invalid schedule infos are ignored.
+ * @param metadata The new schedules' optional metadata.
+ * @param completionHandler The completion handler with the new schedules that were saved.
+ */
+- (void)editSchedules:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+         newSchedules:(NSArray<UAScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(nullable void (^)(NSArray<UASchedule *> *))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -9,8 +9,11 @@
 #import "UAScheduleTrigger+Internal.h"
 #import "UAScheduleInfo+Internal.h"
 #import "UAScheduleEdits+Internal.h"
+#import "UAScheduleTriggerPredicateCache+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+#define kUAAutomationEngineMaxPendingTriggerUpdates 100
+
 @interface UAAutomationStateCondition : NSObject
 
 @property (nonatomic, copy, nonnull) BOOL (^predicate)(void);
@@ -35,6 +38,28 @@
 
 @end
 
+/**
+ * A trigger update received before the engine is activated.
+ */
+@interface UAAutomationPendingTriggerUpdate : NSObject
+
+@property (nonatomic, copy, nullable) NSString *scheduleID;
+@property (nonatomic, assign) UAScheduleTriggerType triggerType;
+@property (nonatomic, strong, nullable) id argument;
+@property (nonatomic, assign) double amount;
+
+@end
+
+@implementation UAAutomationPendingTriggerUpdate
+
+- (BOOL)matchesScheduleID:(NSString *)scheduleID type:(UAScheduleTriggerType)triggerType argument:(id)argument {
+    return self.triggerType == triggerType &&
+        (self.scheduleID == scheduleID || [self.scheduleID isEqualToString:scheduleID]) &&
+        (self.argument == argument || [self.argument isEqual:argument]);
+}
+
+@end
+
 @interface UAAutomationEngine()
 @property (nonatomic, strong) UAAppStateTracker *appStateTracker;
 @property (nonatomic, strong) UATimerScheduler *timerScheduler;
@@ -48,9 +73,13 @@
 @property (nonatomic, strong) NSMutableArray *activeTimers;
 @property (nonatomic, assign) UIBackgroundTaskIdentifier backgroundTaskIdentifier;
 @property (nonatomic, assign) BOOL isStarted;
+@property (atomic, assign) BOOL activated;
+@property (atomic, assign) BOOL activationRequested;
+@property (nonatomic, strong) NSMutableArray<UAAutomationPendingTriggerUpdate *> *pendingTriggerUpdates;
 @property (nonnull, strong) NSMutableDictionary *stateConditions;
 @property (atomic, assign) BOOL paused;
 @property (nonatomic, readonly) BOOL isForegrounded;
+@property (nonatomic, strong) UAScheduleTriggerPredicateCache *triggerPredicateCache;
 
 @end
 
@@ -82,6 +111,8 @@
 
         self.activeTimers = [NSMutableArray array];
         self.stateConditions = [NSMutableDictionary dictionary];
+        self.pendingTriggerUpdates = [NSMutableArray array];
+        self.triggerPredicateCache = [UAScheduleTriggerPredicateCache cache];
         self.paused = NO;
     }
 
@@ -148,15 +179,43 @@
                                     name:UAApplicationDidTransitionToForeground
                                   object:nil];
 
+    [self createStateConditions];
+
+    self.isStarted = YES;
+
+    // Counted now, applied once the store is activated
+    [self updateTriggersWithType:UAScheduleTriggerAppInit argument:nil incrementAmount:1.0];
+
+    if (self.activationRequested) {
+        [self activateIfNeeded];
+    }
+}
+
+- (void)activateIfNeeded {
+    NSArray<UAAutomationPendingTriggerUpdate *> *pendingTriggerUpdates;
+    @synchronized (self) {
+        self.activationRequested = YES;
+        if (self.activated || !self.isStarted) {
+            return;
+        }
+
+        self.activated = YES;
+        pendingTriggerUpdates = [self.pendingTriggerUpdates copy];
+        [self.pendingTriggerUpdates removeAllObjects];
+    }
+
+    UA_LDEBUG(@"Activating automation engine, pending trigger updates: %ld", (unsigned long)pendingTriggerUpdates.count);
+
     [self cleanSchedules];
     [self resetExecutingSchedules];
     [self rescheduleTimers];
-    [self createStateConditions];
     [self restoreCompoundTriggers];
-    [self updateTriggersWithType:UAScheduleTriggerAppInit argument:nil incrementAmount:1.0];
-    [self scheduleConditionsChanged];
 
-    self.isStarted = YES;
+    for (UAAutomationPendingTriggerUpdate *update in pendingTriggerUpdates) {
+        [self updateTriggersWithScheduleID:update.scheduleID type:update.triggerType argument:update.argument incrementAmount:update.amount];
+    }
+
+    [self scheduleConditionsChanged];
 }
 
 - (void)stop {
@@ -167,7 +226,12 @@
     [self cancelTimers];
     [self.notificationCenter removeObserver:self];
     [self.stateConditions removeAllObjects];
-    self.isStarted = NO;
+
+    @synchronized (self) {
+        self.activated = NO;
+        [self.pendingTriggerUpdates removeAllObjects];
+        self.isStarted = NO;
+    }
 }
 
 - (void)pause {
@@ -199,6 +263,7 @@
         return;
     }
 
+    [self activateIfNeeded];
     [self cleanSchedules];
 
     // Create a schedule to save
@@ -228,6 +293,7 @@
 }
 
 - (void)scheduleMultiple:(NSArray<UAScheduleInfo *> *)scheduleInfos metadata:(nullable NSDictionary *)metadata completionHandler:(void (^)(NSArray <UASchedule *> *))completionHandler {
+    [self activateIfNeeded];
     [self cleanSchedules];
 
     // Create schedules to save (only allow valid schedules)
@@ -267,6 +333,8 @@
 }
 
 - (void)cancelScheduleWithID:(NSString *)identifier completionHandler:(nullable void (^)(UASchedule * _Nullable))completionHandler {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData * _Nullable scheduleData) {
         UA_STRONGIFY(self)
@@ -281,6 +349,7 @@
     }];
 
     [self.automationStore deleteSchedule:identifier];
+    [self.triggerPredicateCache invalidateScheduleWithID:identifier];
     [self cancelTimersWithIdentifiers:[NSSet setWithArray:@[identifier]]];
 }
 
@@ -289,6 +358,8 @@
 }
 
 - (void)cancelAll {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getAllSchedules:^(NSArray<UAScheduleData *> * _Nonnull scheduleDatas) {
         UA_STRONGIFY(self)
@@ -299,16 +370,20 @@
     }];
 
     [self.automationStore deleteAllSchedules];
+    [self.triggerPredicateCache invalidateAll];
     [self cancelTimers];
 }
 
 - (void)cancelSchedulesWithGroup:(NSString *)group completionHandler:(nullable void (^)(NSArray <UASchedule *> *))completionHandler {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedules:group completionHandler:^(NSArray<UAScheduleData *> * _Nonnull scheduleDatas) {
         UA_STRONGIFY(self)
         NSMutableArray<UASchedule *> *schedules = [NSMutableArray array];
 
         for (UAScheduleData *scheduleData in scheduleDatas) {
+            [self.triggerPredicateCache invalidateScheduleWithID:scheduleData.identifier];
             UASchedule *schedule = [self scheduleFromData:scheduleData];
             [self notifyDelegateOnScheduleCancelled:schedule];
             [schedules addObject:schedule];
@@ -330,6 +405,8 @@
 }
 
 - (void)getScheduleWithID:(NSString *)identifier completionHandler:(void (^)(UASchedule *))completionHandler {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData *scheduleData) {
         UA_STRONGIFY(self)
@@ -346,6 +423,8 @@
 }
 
 - (void)getSchedules:(void (^)(NSArray<UASchedule *> *))completionHandler {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
         UA_STRONGIFY(self)
@@ -365,6 +444,8 @@
 }
 
 - (void)getAllSchedules:(void (^)(NSArray<UASchedule *> *))completionHandler {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getAllSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
         UA_STRONGIFY(self)
@@ -383,7 +464,21 @@
     }];
 }
 
+- (void)getMessageScheduleIndex:(void (^)(NSArray<UAScheduleIndexEntry *> *))completionHandler {
+    [self activateIfNeeded];
+
+    UA_WEAKIFY(self)
+    [self.automationStore getMessageScheduleIndex:^(NSArray<UAScheduleIndexEntry *> *entries) {
+        UA_STRONGIFY(self)
+        [self.dispatcher dispatchAsync:^{
+            completionHandler(entries);
+        }];
+    }];
+}
+
 - (void)getSchedulesWithGroup:(NSString *)group completionHandler:(void (^)(NSArray<UASchedule *> *))completionHandler {
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedules:group completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
         UA_STRONGIFY(self)
@@ -405,51 +500,143 @@
                      edits:(UAScheduleEdits *)edits
          completionHandler:(void (^)(UASchedule *))completionHandler {
 
+    [self activateIfNeeded];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedule:identifier includingExpired:YES completionHandler:^(UAScheduleData * _Nullable scheduleData) {
         UA_STRONGIFY(self)
 
         UASchedule *schedule = nil;
+        NSMutableArray<void (^)(void)> *callbacks = [NSMutableArray array];
         if (scheduleData) {
-            [UAAutomationEngine applyEdits:edits toData:scheduleData];
+            schedule = [self applyEdits:edits toScheduleData:scheduleData callbacks:callbacks];
+        }
 
-            BOOL overLimit = [scheduleData isOverLimit];
-            BOOL isExpired = [scheduleData isExpired];
+        if (!callbacks.count && !completionHandler) {
+            return;
+        }
 
-            // Check if the schedule needs to be rehabilitated or finished due to the edits
-            if ([scheduleData.executionState unsignedIntegerValue] == UAScheduleStateFinished && !overLimit && !isExpired) {
-                NSDate *finishDate = scheduleData.executionStateChangeDate;
-                scheduleData.executionState = @(UAScheduleStateIdle);
+        [self.dispatcher dispatchAsync:^{
+            for (void (^callback)(void) in callbacks) {
+                callback();
+            }
 
-                schedule = [self scheduleFromData:scheduleData];
+            if (completionHandler) {
+                completionHandler(schedule);
+            }
+        }];
+    }];
+}
 
-                // Handle any state changes that might have been missed while the schedule was finished
-                if (schedule) {
-                    UA_WEAKIFY(self);
-                    [self.dispatcher dispatchAsync:^{
-                        UA_STRONGIFY(self);
-                        [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:finishDate];
-                    }];
-                }
-            } else if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished && (overLimit || isExpired)) {
-                schedule = [self scheduleFromData:scheduleData];
+- (void)editSchedules:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+         newSchedules:(NSArray<UAScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(nullable void (^)(NSArray<UASchedule *> *))completionHandler {
 
-                if (overLimit) {
-                    [self notifyDelegateOnScheduleLimitReached:schedule];
-                }
-                if (isExpired) {
-                    [self notifyDelegateOnScheduleExpired:schedule];
-                }
-                [self finishSchedule:scheduleData];
+    [self activateIfNeeded];
+
+    // Create schedules to save (only allow valid schedules)
+    NSMutableArray<UASchedule *> *schedules = [NSMutableArray arrayWithCapacity:scheduleInfos.count];
+    for (UAScheduleInfo *scheduleInfo in scheduleInfos) {
+        if (scheduleInfo.isValid) {
+            [schedules addObject:[UASchedule scheduleWithIdentifier:[NSUUID UUID].UUIDString info:scheduleInfo metadata:metadata]];
+        }
+    }
+
+    if (schedules.count) {
+        [self cleanSchedules];
+    }
+
+    // Callbacks are collected while editing and run together once everything is saved
+    NSMutableArray<void (^)(void)> *callbacks = [NSMutableArray array];
+
+    UA_WEAKIFY(self)
+    [self.automationStore saveSchedules:schedules
+                   editSchedulesWithIDs:edits.allKeys
+                              editBlock:^(NSArray<UAScheduleData *> *schedulesData) {
+        UA_STRONGIFY(self)
+        for (UAScheduleData *scheduleData in schedulesData) {
+            UAScheduleEdits *scheduleEdits = edits[scheduleData.identifier];
+            if (scheduleEdits) {
+                [self applyEdits:scheduleEdits toScheduleData:scheduleData callbacks:callbacks];
             }
         }
+    } completionHandler:^(BOOL success) {
+        UA_STRONGIFY(self)
+        NSArray<UASchedule *> *savedSchedules = success ? schedules : @[];
 
-        if (completionHandler) {
-            [self.dispatcher dispatchAsync:^{
-                completionHandler(schedule);
+        [self.dispatcher dispatchAsync:^{
+            UA_STRONGIFY(self)
+            for (void (^callback)(void) in callbacks) {
+                callback();
+            }
+
+            if (savedSchedules.count) {
+                [self checkCompoundTriggerState:savedSchedules];
+            }
+
+            if (completionHandler) {
+                completionHandler(savedSchedules);
+            }
+        }];
+    }];
+}
+
+/**
+ * Applies edits to the schedule data and rehabilitates or finishes the schedule if needed.
+ * Must be called on the store's context queue.
+ *
+ * @param edits The edits.
+ * @param scheduleData The schedule data.
+ * @param callbacks Collects the delegate and trigger callbacks to run on the dispatcher.
+ * @return The schedule if the edits changed its execution state, otherwise nil.
+ */
+- (nullable UASchedule *)applyEdits:(UAScheduleEdits *)edits
+                     toScheduleData:(UAScheduleData *)scheduleData
+                          callbacks:(NSMutableArray<void (^)(void)> *)callbacks {
+    [self.triggerPredicateCache invalidateScheduleWithID:scheduleData.identifier];
+    [UAAutomationEngine applyEdits:edits toData:scheduleData];
+
+    BOOL overLimit = [scheduleData isOverLimit];
+    BOOL isExpired = [scheduleData isExpired];
+    UASchedule *schedule = nil;
+
+    UA_WEAKIFY(self)
+
+    // Check if the schedule needs to be rehabilitated or finished due to the edits
+    if ([scheduleData.executionState unsignedIntegerValue] == UAScheduleStateFinished && !overLimit && !isExpired) {
+        NSDate *finishDate = scheduleData.executionStateChangeDate;
+        scheduleData.executionState = @(UAScheduleStateIdle);
+
+        schedule = [self scheduleFromData:scheduleData];
+
+        // Handle any state changes that might have been missed while the schedule was finished
+        if (schedule) {
+            [callbacks addObject:^{
+                UA_STRONGIFY(self);
+                [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:finishDate];
             }];
         }
-    }];
+    } else if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished && (overLimit || isExpired)) {
+        schedule = [self scheduleFromData:scheduleData];
+
+        if (schedule) {
+            [callbacks addObject:^{
+                UA_STRONGIFY(self);
+                id<UAAutomationEngineDelegate> delegate = self.delegate;
+                if (overLimit && [delegate respondsToSelector:@selector(onScheduleLimitReached:)]) {
+                    [delegate onScheduleLimitReached:schedule];
+                }
+                if (isExpired && [delegate respondsToSelector:@selector(onScheduleExpired:)]) {
+                    [delegate onScheduleExpired:schedule];
+                }
+            }];
+        }
+
+        [self finishSchedule:scheduleData];
+    }
+
+    return schedule;
 }
 
 #pragma mark -
@@ -471,6 +658,7 @@
 
     // Finished schedules
     [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateFinished)] completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
+        UA_STRONGIFY(self)
         for (UAScheduleData *scheduleData in schedulesData) {
             NSDate *finishDate;
 
@@ -483,6 +671,7 @@
             }
 
             if ([finishDate compare:self.date.now] == NSOrderedAscending) {
+                [self.triggerPredicateCache invalidateScheduleWithID:scheduleData.identifier];
                 [scheduleData.managedObjectContext deleteObject:scheduleData];
             }
         }
@@ -578,6 +767,20 @@
         return;
     }
 
+    // Hold events until the store is activated
+    @synchronized (self) {
+        if (!self.activated) {
+            [self addPendingTriggerUpdateWithScheduleID:scheduleID type:triggerType argument:argument incrementAmount:amount];
+            return;
+        }
+    }
+
+    // Drop events that no stored trigger can match without hitting the store
+    if (!scheduleID && ![self.automationStore containsTriggersWithType:triggerType argument:argument]) {
+        UA_LTRACE(@"No triggers with type: %ld match the event", (long)triggerType);
+        return;
+    }
+
     UA_LDEBUG(@"Updating triggers with type: %ld", (long)triggerType);
 
     NSDate *start = self.date.now;
@@ -593,7 +796,7 @@
 
         // Process triggers
         for (UAScheduleTriggerData *trigger in triggers) {
-            UAJSONPredicate *predicate = [UAAutomationEngine predicateFromData:trigger.predicateData];
+            UACompiledJSONPredicate *predicate = [self.triggerPredicateCache predicateForTriggerData:trigger];
             if (predicate && argument) {
                 if (![predicate evaluateObject:argument]) {
                     continue;
@@ -633,10 +836,40 @@
         }
 
         NSTimeInterval executionTime = -[start timeIntervalSinceDate:self.date.now];
-        UA_LTRACE(@"Automation execution time: %f seconds, triggers: %ld, triggered schedules: %ld", executionTime, (unsigned long)triggers.count, (unsigned long)schedulesToExecute.count);
+        UA_LTRACE(@"Automation execution time: %f seconds, triggers: %ld, triggered schedules: %ld, predicate cache hits: %ld, misses: %ld", executionTime, (unsigned long)triggers.count, (unsigned long)schedulesToExecute.count, (unsigned long)self.triggerPredicateCache.hitCount, (unsigned long)self.triggerPredicateCache.missCount);
     }];
 }
 
+/**
+ * Queues a trigger update until activation. Repeated updates for the same trigger type and
+ * argument are coalesced into one, and at most kUAAutomationEngineMaxPendingTriggerUpdates
+ * distinct updates are held. Must be called while synchronized.
+ */
+- (void)addPendingTriggerUpdateWithScheduleID:(NSString *)scheduleID
+                                         type:(UAScheduleTriggerType)triggerType
+                                     argument:(id)argument
+                              incrementAmount:(double)amount {
+
+    for (UAAutomationPendingTriggerUpdate *update in self.pendingTriggerUpdates) {
+        if ([update matchesScheduleID:scheduleID type:triggerType argument:argument]) {
+            update.amount += amount;
+            return;
+        }
+    }
+
+    if (self.pendingTriggerUpdates.count >= kUAAutomationEngineMaxPendingTriggerUpdates) {
+        UA_LDEBUG(@"Too many pending trigger updates, dropping update with type: %ld", (long)triggerType);
+        return;
+    }
+
+    UAAutomationPendingTriggerUpdate *update = [[UAAutomationPendingTriggerUpdate alloc] init];
+    update.scheduleID = scheduleID;
+    update.triggerType = triggerType;
+    update.argument = argument;
+    update.amount = amount;
+    [self.pendingTriggerUpdates addObject:update];
+}
+
 - (void)updateTriggersWithType:(UAScheduleTriggerType)triggerType argument:(id)argument incrementAmount:(double)amount {
     [self updateTriggersWithScheduleID:nil type:triggerType argument:argument incrementAmount:amount];
 }
@@ -987,6 +1220,11 @@
  * Called when one of the schedule conditions changes.
  */
 - (void)scheduleConditionsChanged {
+    // Checked at activation
+    if (!self.activated) {
+        return;
+    }
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateWaitingScheduleConditions)]
                                completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
@@ -1116,6 +1354,7 @@
                 switch (prepareResult) {
                     case UAAutomationSchedulePrepareResultCancel:
                         [self notifyDelegateOnScheduleCancelled:[self scheduleFromData:scheduleData]];
+                        [self.triggerPredicateCache invalidateScheduleWithID:scheduleID];
                         [scheduleData.managedObjectContext deleteObject:scheduleData];
                         break;
                     case UAAutomationSchedulePrepareResultContinue:
@@ -1233,6 +1472,7 @@
 
     if ([scheduleData.editGracePeriod doubleValue] <= 0) {
         UA_LDEBUG(@"Deleting schedule: %@", scheduleData.identifier);
+        [self.triggerPredicateCache invalidateScheduleWithID:scheduleData.identifier];
         [scheduleData.managedObjectContext deleteObject:scheduleData];
     }
 }
@@ -1355,6 +1595,7 @@
 
     if (!schedule) {
         UA_LERR(@"Failed to parse schedule data. Deleting %@", scheduleData.identifier);
+        [self.triggerPredicateCache invalidateScheduleWithID:scheduleData.identifier];
         [scheduleData.managedObjectContext deleteObject:scheduleData];
     }
 
@@ -2,6 +2,7 @@
 
 #import <Foundation/Foundation.h>
 #import "UAScheduleTrigger+Internal.h"
+#import "UAScheduleIndexEntry+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -12,7 +13,7 @@ NS_ASSUME_NONNULL_BEGIN
 @class UARuntimeConfig;
 
 /**
- * Manager class for the Automation CoreData store.
+ * Manager class for the Automation CoreData store. The persistent store is opened on first use.
  */
 @interface UAAutomationStore : NSObject
 
@@ -62,6 +63,21 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)saveSchedules:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler;
 
+/**
+ * Edits existing schedules and saves new schedules in a single transaction with one save.
+ *
+ * @param schedules The new schedules to save.
+ * @param scheduleIDs The identifiers of the schedules to edit, including expired schedules.
+ * @param editBlock Block called on the store's context queue with the schedule data to edit.
+ * @param completionHandler Completion handler when the operation is finished. `YES` if the
+ * changes were saved, `NO` if the save failed or the new schedules would exceed the specified
+ * limit. Edits are still saved if only the new schedules are over the limit.
+ */
+- (void)saveSchedules:(NSArray<UASchedule *> *)schedules
+ editSchedulesWithIDs:(NSArray<NSString *> *)scheduleIDs
+            editBlock:(void (^)(NSArray<UAScheduleData *> *))editBlock
+    completionHandler:(void (^)(BOOL))completionHandler;
+
 /**
  * Deletes the schedule corresponding to the provided identifier.
  *
@@ -103,6 +119,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)getAllSchedules:(void (^)(NSArray<UAScheduleData *> *))completionHandler;
 
+/**
+ * Gets the index entries of all in-app message schedules, including schedules that have ended.
+ * Only the indexed columns are read, so the schedule data is not loaded or decoded.
+ *
+ * @param completionHandler Completion handler called back with the index entries.
+ */
+- (void)getMessageScheduleIndex:(void (^)(NSArray<UAScheduleIndexEntry *> *))completionHandler;
+
 /**
  * Gets the schedule corresponding to the provided identifier.
  *
@@ -146,6 +170,16 @@ NS_ASSUME_NONNULL_BEGIN
                      type:(UAScheduleTriggerType)type
         completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler;
 
+/**
+ * Checks the in-memory trigger index for triggers that could match an event, without
+ * touching the underlying store. Safe to call from any queue.
+ *
+ * @param type A trigger type.
+ * @param argument The event argument, e.g. the custom event payload.
+ * @return `NO` if no stored trigger can match the event, otherwise `YES`.
+ */
+- (BOOL)containsTriggersWithType:(UAScheduleTriggerType)type argument:(nullable id)argument;
+
 /**
  * Gets the schedule count.
  *
@@ -9,6 +9,7 @@
 #import "UASchedule+Internal.h"
 #import "UAScheduleTrigger+Internal.h"
 #import "UAScheduleDataMigrator+Internal.h"
+#import "UAScheduleTriggerIndex+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
 @interface UAAutomationStore ()
@@ -18,6 +19,8 @@
 @property (nonatomic, assign) NSUInteger scheduleLimit;
 @property (nonatomic, assign) BOOL inMemory;
 @property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL storeOpened;
+@property (nonatomic, strong) UAScheduleTriggerIndex *triggerIndex;
 @end
 
 @implementation UAAutomationStore
@@ -31,33 +34,22 @@
         self.inMemory = inMemory;
         self.date = date;
         self.finished = NO;
+        self.triggerIndex = [UAScheduleTriggerIndex index];
 
         NSBundle *bundle = [NSBundle bundleForClass:[self class]];
         NSURL *modelURL = [bundle URLForResource:@"UAAutomation" withExtension:@"momd"];
         self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
                                                                       concurrencyType:NSPrivateQueueConcurrencyType];
 
-        UA_WEAKIFY(self)
-        void (^completion)(BOOL, NSError*) = ^void(BOOL success, NSError *error) {
-            if (!success) {
-                UA_LERR(@"Failed to create automation persistent store: %@", error);
-                return;
-            }
-
-            UA_STRONGIFY(self);
-            [self migrateData];
-        };
-
-        if (inMemory) {
-            [self.managedContext addPersistentInMemoryStore:self.storeName completionHandler:completion];
-        } else {
-            [self.managedContext addPersistentSqlStore:self.storeName completionHandler:completion];
-        }
-
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(protectedDataAvailable)
                                                      name:UIApplicationProtectedDataDidBecomeAvailable
                                                    object:nil];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(managedContextDidSave:)
+                                                     name:NSManagedObjectContextDidSaveNotification
+                                                   object:self.managedContext];
     }
 
     return self;
@@ -72,49 +64,112 @@
 }
 
 - (void)protectedDataAvailable {
-    if (!self.managedContext.persistentStoreCoordinator.persistentStores.count) {
-        UA_WEAKIFY(self)
-        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:^(BOOL success, NSError *error) {
-            if (!success) {
-                UA_LERR(@"Failed to create automation persistent store: %@", error);
-                return;
-            }
+    @synchronized(self) {
+        if (self.storeOpened && !self.managedContext.persistentStoreCoordinator.persistentStores.count) {
+            [self openStore];
+        }
+    }
+}
 
-            UA_STRONGIFY(self);
-            [self migrateData];
-        }];
+/**
+ * Opens the persistent store on first use, so launches that never touch automation
+ * do not pay for the SQLite open and migration. Must be called while synchronized on self.
+ */
+- (void)openStoreIfNeeded {
+    if (self.storeOpened) {
+        return;
     }
+
+    self.storeOpened = YES;
+    [self openStore];
 }
 
-- (void)migrateData {
-    [self safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
-            return;
+- (void)openStore {
+    void (^completion)(BOOL, NSError*) = ^void(BOOL success, NSError *error) {
+        if (!success) {
+            UA_LERR(@"Failed to create automation persistent store: %@", error);
         }
+    };
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
-        request.predicate = [NSPredicate predicateWithFormat:@"dataVersion < %d", UAScheduleDataVersion];
-        NSError *error;
-        NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+    if (self.inMemory) {
+        [self.managedContext addPersistentInMemoryStore:self.storeName completionHandler:completion];
+    } else {
+        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:completion];
+    }
 
-        if (error) {
-            UA_LERR(@"Error fetching schedules %@", error);
-            return;
+    // Enqueued right after the store is added so it runs before any pending data access
+    UA_WEAKIFY(self)
+    [self.managedContext safePerformBlock:^(BOOL isSafe) {
+        UA_STRONGIFY(self)
+        if (isSafe) {
+            [self migrateData];
+            [self loadTriggerIndex];
         }
+    }];
+}
+
+/**
+ * Migrates schedule data to the current version. Called on the managed context's queue.
+ */
+- (void)migrateData {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+    request.predicate = [NSPredicate predicateWithFormat:@"dataVersion < %d", UAScheduleDataVersion];
+    NSError *error;
+    NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+
+    if (error) {
+        UA_LERR(@"Error fetching schedules %@", error);
+        return;
+    }
+
+    for (UAScheduleData *scheduleData in result) {
+        [UAScheduleDataMigrator migrateScheduleData:scheduleData
+                                         oldVersion:[scheduleData.dataVersion unsignedIntegerValue]
+                                         newVersion:UAScheduleDataVersion];
+    }
 
-        for (UAScheduleData *scheduleData in result) {
-            [UAScheduleDataMigrator migrateScheduleData:scheduleData
-                                             oldVersion:[scheduleData.dataVersion unsignedIntegerValue]
-                                             newVersion:UAScheduleDataVersion];
+    [self.managedContext safeSave];
+}
+
+/**
+ * Loads the trigger index. Called on the managed context's queue.
+ */
+- (void)loadTriggerIndex {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleTriggerData"];
+    request.predicate = [NSPredicate predicateWithFormat:@"schedule != nil"];
+
+    NSError *error;
+    NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+
+    if (error) {
+        UA_LERR(@"Error fetching triggers %@", error);
+        return;
+    }
+
+    [self.triggerIndex loadTriggers:result];
+}
+
+/**
+ * Keeps the trigger index in sync with saved changes. Called on the managed context's queue.
+ */
+- (void)managedContextDidSave:(NSNotification *)notification {
+    for (NSManagedObject *object in notification.userInfo[NSDeletedObjectsKey]) {
+        if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+            [self.triggerIndex removeTriggerWithID:object.objectID];
         }
+    }
 
-        [self.managedContext safeSave];
-    }];
+    for (NSManagedObject *object in notification.userInfo[NSInsertedObjectsKey]) {
+        if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+            [self.triggerIndex addTrigger:(UAScheduleTriggerData *)object];
+        }
+    }
 }
 
 - (void)safePerformBlock:(void (^)(BOOL))block {
     @synchronized(self) {
         if (!self.finished) {
+            [self openStoreIfNeeded];
             [self.managedContext safePerformBlock:block];
         }
     }
@@ -168,6 +223,51 @@
     }];
 }
 
+- (void)saveSchedules:(NSArray<UASchedule *> *)schedules
+ editSchedulesWithIDs:(NSArray<NSString *> *)scheduleIDs
+            editBlock:(void (^)(NSArray<UAScheduleData *> *))editBlock
+    completionHandler:(void (^)(BOOL))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(NO);
+            return;
+        }
+
+        if (scheduleIDs.count) {
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+            request.predicate = [NSPredicate predicateWithFormat:@"identifier IN %@", scheduleIDs];
+
+            NSError *error;
+            NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+
+            if (error) {
+                UA_LERR(@"Error fetching schedules %@", error);
+                result = @[];
+            }
+
+            editBlock(result);
+        }
+
+        BOOL success = YES;
+        if (schedules.count) {
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+            NSUInteger count = [self.managedContext countForFetchRequest:request error:nil];
+
+            if (count + schedules.count > self.scheduleLimit) {
+                UA_LERR(@"Max schedule limit reached. Unable to save new schedules.");
+                success = NO;
+            } else {
+                for (UASchedule *schedule in schedules) {
+                    [self addScheduleDataFromSchedule:schedule];
+                }
+            }
+        }
+
+        BOOL saved = [self.managedContext safeSave];
+        completionHandler(success && saved);
+    }];
+}
+
 - (void)deleteSchedule:(NSString *)scheduleID {
     NSPredicate *predicate = [NSPredicate predicateWithFormat:@"identifier == %@", scheduleID];
     [self deleteSchedulesWithPredicate:predicate];
@@ -220,6 +320,44 @@
     [self fetchSchedulesWithPredicate:nil limit:self.scheduleLimit completionHandler:completionHandler];
 }
 
+- (void)getMessageScheduleIndex:(void (^)(NSArray<UAScheduleIndexEntry *> *))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(@[]);
+            return;
+        }
+
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+        request.predicate = [NSPredicate predicateWithFormat:@"messageID != nil"];
+        request.resultType = NSDictionaryResultType;
+        request.propertiesToFetch = @[@"identifier", @"messageID", @"messageSource", @"lastUpdated"];
+        request.fetchLimit = self.scheduleLimit;
+
+        NSError *error;
+        NSArray<NSDictionary *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+        if (error) {
+            UA_LERR(@"Error fetching schedule index %@", error);
+            completionHandler(@[]);
+            return;
+        }
+
+        NSMutableArray<UAScheduleIndexEntry *> *entries = [NSMutableArray arrayWithCapacity:result.count];
+        for (NSDictionary *row in result) {
+            if (!row[@"identifier"]) {
+                continue;
+            }
+
+            [entries addObject:[UAScheduleIndexEntry entryWithScheduleID:row[@"identifier"]
+                                                               messageID:row[@"messageID"]
+                                                           messageSource:row[@"messageSource"]
+                                                             lastUpdated:row[@"lastUpdated"]]];
+        }
+
+        completionHandler(entries);
+    }];
+}
+
 - (void)getActiveTriggers:(NSString *)scheduleID
                      type:(UAScheduleTriggerType)type
         completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler {
@@ -234,6 +372,10 @@
     [self fetchTriggersWithPredicate:predicate completionHandler:completionHandler];
 }
 
+- (BOOL)containsTriggersWithType:(UAScheduleTriggerType)type argument:(nullable id)argument {
+    return [self.triggerIndex containsTriggersWithType:type argument:argument];
+}
+
 - (void)getScheduleCount:(void (^)(NSNumber *))completionHandler {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
@@ -274,6 +416,11 @@
         }
 
         [self.managedContext safeSave];
+
+        // Batch deletes bypass the context, so rebuild the trigger index from the store
+        if (!self.inMemory) {
+            [self loadTriggerIndex];
+        }
     }];
 }
 
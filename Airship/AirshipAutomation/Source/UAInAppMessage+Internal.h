@@ -78,6 +78,8 @@ extern NSString *const UAInAppMessageDisplayTypeModalValue;
 extern NSString *const UAInAppMessageDisplayTypeHTMLValue;
 extern NSString *const UAInAppMessageDisplayTypeCustomValue;
 
+extern NSString *const UAInAppMessageSourceRemoteDataValue;
+
 
 /**
  * In-app message source.
@@ -11,14 +11,15 @@
 
 @property(nonatomic, strong) UAInAppMessageAssetCache *assetCache;
 @property(nonatomic, strong) NSOperationQueue *queue;
+@property(nonatomic, strong) NSMutableDictionary<NSString *, NSOperation *> *scheduleOperations;
 
 @end
 
 @implementation UAInAppMessageAssetManager
 
 + (instancetype)assetManager {
+    // Operations are only ordered per schedule, so different schedules can prepare concurrently
     NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
     return [self assetManagerWithAssetCache:[UAInAppMessageAssetCache assetCache] operationQueue:queue];
 }
 
@@ -31,6 +32,7 @@
     if (self) {
         self.assetCache = assetCache;
         self.queue = queue;
+        self.scheduleOperations = [NSMutableDictionary dictionary];
         self.prepareAssetsDelegate = [[UAInAppMessageDefaultPrepareAssetsDelegate alloc] init];
     }
     return self;
@@ -69,7 +71,7 @@
             [operation finish];
         }];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation forScheduleID:schedule.identifier];
 }
 
 - (void)onPrepare:(UASchedule *)schedule completionHandler:(void (^)(UAInAppMessagePrepareResult))completionHandler {
@@ -93,7 +95,7 @@
             [operation finish];
         }];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation forScheduleID:schedule.identifier];
 }
 
 - (void)onDisplayFinished:(UASchedule *)schedule {
@@ -112,7 +114,7 @@
         [self.assetCache releaseAssets:schedule.identifier wipeFromDisk:!shouldPersistCacheAfterDisplay];
         [operation finish];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation forScheduleID:schedule.identifier];
 }
 
 - (void)onScheduleFinished:(UASchedule *)schedule {
@@ -121,7 +123,7 @@
         [self.assetCache releaseAssets:schedule.identifier wipeFromDisk:YES];
         [operation finish];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation forScheduleID:schedule.identifier];
 }
 
 - (void)assetsForSchedule:(UASchedule *)schedule completionHandler:(void (^)(UAInAppMessageAssets *))completionHandler {
@@ -130,6 +132,33 @@
         completionHandler([self.assetCache assetsForScheduleId:schedule.identifier]);
         [operation finish];
     }];
+    [self addOperation:operation forScheduleID:schedule.identifier];
+}
+
+/**
+ * Adds an operation to the queue that will not start until the previous operation
+ * for the same schedule finishes, so assets are never released while being prepared.
+ */
+- (void)addOperation:(NSOperation *)operation forScheduleID:(NSString *)scheduleID {
+    UA_WEAKIFY(self)
+    __weak NSOperation *weakOperation = operation;
+    operation.completionBlock = ^{
+        UA_STRONGIFY(self)
+        @synchronized (self) {
+            if (self.scheduleOperations[scheduleID] == weakOperation) {
+                [self.scheduleOperations removeObjectForKey:scheduleID];
+            }
+        }
+    };
+
+    @synchronized (self) {
+        NSOperation *previous = self.scheduleOperations[scheduleID];
+        if (previous && !previous.isFinished) {
+            [operation addDependency:previous];
+        }
+        self.scheduleOperations[scheduleID] = operation;
+    }
+
     [self.queue addOperation:operation];
 }
 
@@ -0,0 +1,107 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+#import "UAInAppMessageAdapterProtocol.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Downloads in-app message assets into a shared, content-addressed store.
+ *
+ * Each asset is stored once, named by the SHA-256 of its contents, and hard linked into the cache
+ * location of every schedule that references it. Concurrent requests for the same URL share a single
+ * download, downloads run on a bounded queue, and the store is kept under a byte budget by evicting
+ * the least recently used assets. Stored assets older than the revalidation interval are revalidated
+ * with a conditional GET using the ETag and Last-Modified headers of the original response.
+ */
+@interface UAInAppMessageAssetPrefetcher : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Prefetcher Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * How long a stored asset is used without revalidating it. Defaults to 24 hours.
+ */
+@property (atomic, assign) NSTimeInterval revalidationInterval;
+
+/**
+ * The total number of prefetch requests.
+ */
+@property (atomic, readonly) NSUInteger requestCount;
+
+/**
+ * The number of prefetch requests served without downloading the asset, either from the store,
+ * by a not modified revalidation, or by joining another request's download.
+ */
+@property (atomic, readonly) NSUInteger hitCount;
+
+/**
+ * The ratio of hits to requests, or 0 if there have been no requests.
+ */
+@property (atomic, readonly) double hitRate;
+
+/**
+ * The number of asset bytes that did not need to be downloaded because of a hit.
+ */
+@property (atomic, readonly) unsigned long long bytesSaved;
+
+/**
+ * The number of asset bytes downloaded.
+ */
+@property (atomic, readonly) unsigned long long bytesDownloaded;
+
+/**
+ * The size in bytes of the assets in the store.
+ */
+@property (atomic, readonly) unsigned long long storeSize;
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Prefetcher Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * The prefetcher shared by the default prepare assets delegates.
+ *
+ * @return The default prefetcher.
+ */
++ (instancetype)defaultPrefetcher;
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param storeURL The directory for the store.
+ * @param session The URL session used for downloads.
+ * @param byteBudget The maximum size of the store in bytes.
+ * @param maxConcurrentDownloads The maximum number of concurrent downloads.
+ * @return The prefetcher.
+ */
++ (instancetype)prefetcherWithStoreURL:(NSURL *)storeURL
+                               session:(NSURLSession *)session
+                            byteBudget:(unsigned long long)byteBudget
+                maxConcurrentDownloads:(NSUInteger)maxConcurrentDownloads;
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Prefetcher Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Fetches an asset and places it at the cache URL.
+ *
+ * @param assetURL The asset URL.
+ * @param cacheURL The location for the asset.
+ * @param completionHandler The completion handler called with the prepare result.
+ */
+- (void)prefetchAssetURL:(NSURL *)assetURL
+                cacheURL:(NSURL *)cacheURL
+       completionHandler:(void (^)(UAInAppMessagePrepareResult))completionHandler;
+
+/**
+ * Waits for pending index writes to finish. Use for testing.
+ */
+- (void)waitForIdle;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,535 @@
+/* Copyright Airship and Contributors */
+
+#import <CommonCrypto/CommonDigest.h>
+
+#import "UAInAppMessageAssetPrefetcher+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+#define kUAInAppMessageAssetPrefetcherDefaultByteBudget 50 * 1024 * 1024
+#define kUAInAppMessageAssetPrefetcherDefaultMaxConcurrentDownloads 4
+#define kUAInAppMessageAssetPrefetcherDefaultRevalidationInterval 24 * 60 * 60
+
+static NSString * const UAInAppMessageAssetStoreIndexFileName = @"index.plist";
+
+static NSString * const UAInAppMessageAssetStoreContentHashKey = @"content_hash";
+static NSString * const UAInAppMessageAssetStoreSizeKey = @"size";
+static NSString * const UAInAppMessageAssetStoreETagKey = @"etag";
+static NSString * const UAInAppMessageAssetStoreLastModifiedKey = @"last_modified";
+static NSString * const UAInAppMessageAssetStoreLastAccessedKey = @"last_accessed";
+static NSString * const UAInAppMessageAssetStoreLastValidatedKey = @"last_validated";
+
+/**
+ * A stored asset.
+ */
+@interface UAInAppMessageAssetStoreEntry : NSObject
+@property (nonatomic, copy) NSString *contentHash;
+@property (nonatomic, assign) unsigned long long size;
+@property (nonatomic, copy, nullable) NSString *eTag;
+@property (nonatomic, copy, nullable) NSString *lastModified;
+@property (nonatomic, strong) NSDate *lastAccessed;
+@property (nonatomic, strong) NSDate *lastValidated;
+@end
+
+@implementation UAInAppMessageAssetStoreEntry
+
++ (nullable instancetype)entryWithDictionary:(NSDictionary *)dictionary {
+    NSString *contentHash = [dictionary[UAInAppMessageAssetStoreContentHashKey] isKindOfClass:[NSString class]] ? dictionary[UAInAppMessageAssetStoreContentHashKey] : nil;
+    NSNumber *size = [dictionary[UAInAppMessageAssetStoreSizeKey] isKindOfClass:[NSNumber class]] ? dictionary[UAInAppMessageAssetStoreSizeKey] : nil;
+    NSDate *lastAccessed = [dictionary[UAInAppMessageAssetStoreLastAccessedKey] isKindOfClass:[NSDate class]] ? dictionary[UAInAppMessageAssetStoreLastAccessedKey] : nil;
+    NSDate *lastValidated = [dictionary[UAInAppMessageAssetStoreLastValidatedKey] isKindOfClass:[NSDate class]] ? dictionary[UAInAppMessageAssetStoreLastValidatedKey] : nil;
+
+    if (!contentHash || !size || !lastAccessed || !lastValidated) {
+        return nil;
+    }
+
+    UAInAppMessageAssetStoreEntry *entry = [[self alloc] init];
+    entry.contentHash = contentHash;
+    entry.size = [size unsignedLongLongValue];
+    entry.eTag = [dictionary[UAInAppMessageAssetStoreETagKey] isKindOfClass:[NSString class]] ? dictionary[UAInAppMessageAssetStoreETagKey] : nil;
+    entry.lastModified = [dictionary[UAInAppMessageAssetStoreLastModifiedKey] isKindOfClass:[NSString class]] ? dictionary[UAInAppMessageAssetStoreLastModifiedKey] : nil;
+    entry.lastAccessed = lastAccessed;
+    entry.lastValidated = lastValidated;
+    return entry;
+}
+
+- (NSDictionary *)dictionaryValue {
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    dictionary[UAInAppMessageAssetStoreContentHashKey] = self.contentHash;
+    dictionary[UAInAppMessageAssetStoreSizeKey] = @(self.size);
+    dictionary[UAInAppMessageAssetStoreETagKey] = self.eTag;
+    dictionary[UAInAppMessageAssetStoreLastModifiedKey] = self.lastModified;
+    dictionary[UAInAppMessageAssetStoreLastAccessedKey] = self.lastAccessed;
+    dictionary[UAInAppMessageAssetStoreLastValidatedKey] = self.lastValidated;
+    return dictionary;
+}
+
+@end
+
+/**
+ * A request waiting on a download.
+ */
+@interface UAInAppMessageAssetPrefetchRequest : NSObject
+@property (nonatomic, strong) NSURL *cacheURL;
+@property (nonatomic, copy) void (^completionHandler)(UAInAppMessagePrepareResult);
+@end
+
+@implementation UAInAppMessageAssetPrefetchRequest
+
++ (instancetype)requestWithCacheURL:(NSURL *)cacheURL completionHandler:(void (^)(UAInAppMessagePrepareResult))completionHandler {
+    UAInAppMessageAssetPrefetchRequest *request = [[self alloc] init];
+    request.cacheURL = cacheURL;
+    request.completionHandler = completionHandler;
+    return request;
+}
+
+@end
+
+@interface UAInAppMessageAssetPrefetcher()
+@property (nonatomic, strong) NSURL *storeURL;
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, assign) unsigned long long byteBudget;
+@property (nonatomic, strong) NSOperationQueue *downloadQueue;
+@property (nonatomic, strong) NSOperationQueue *indexQueue;
+
+// Guarded by self
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAInAppMessageAssetStoreEntry *> *entries;
+@property (nonatomic, strong) NSCountedSet<NSString *> *contentHashes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<UAInAppMessageAssetPrefetchRequest *> *> *pendingRequests;
+@property (nonatomic, assign) BOOL indexSaveScheduled;
+
+@property (atomic, assign) NSUInteger requestCount;
+@property (atomic, assign) NSUInteger hitCount;
+@property (atomic, assign) unsigned long long bytesSaved;
+@property (atomic, assign) unsigned long long bytesDownloaded;
+@property (atomic, assign) unsigned long long storeSize;
+@end
+
+@implementation UAInAppMessageAssetPrefetcher
+
++ (instancetype)defaultPrefetcher {
+    static UAInAppMessageAssetPrefetcher *defaultPrefetcher;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *cacheDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        NSURL *storeURL = [NSURL fileURLWithPath:[cacheDirectory stringByAppendingPathComponent:@"com.urbanairship.iamassetstore"]];
+        defaultPrefetcher = [self prefetcherWithStoreURL:storeURL
+                                                 session:[NSURLSession sharedSession]
+                                              byteBudget:kUAInAppMessageAssetPrefetcherDefaultByteBudget
+                                  maxConcurrentDownloads:kUAInAppMessageAssetPrefetcherDefaultMaxConcurrentDownloads];
+    });
+    return defaultPrefetcher;
+}
+
++ (instancetype)prefetcherWithStoreURL:(NSURL *)storeURL
+                               session:(NSURLSession *)session
+                            byteBudget:(unsigned long long)byteBudget
+                maxConcurrentDownloads:(NSUInteger)maxConcurrentDownloads {
+    return [[self alloc] initWithStoreURL:storeURL session:session byteBudget:byteBudget maxConcurrentDownloads:maxConcurrentDownloads];
+}
+
+- (instancetype)initWithStoreURL:(NSURL *)storeURL
+                         session:(NSURLSession *)session
+                      byteBudget:(unsigned long long)byteBudget
+          maxConcurrentDownloads:(NSUInteger)maxConcurrentDownloads {
+    self = [super init];
+    if (self) {
+        self.storeURL = storeURL;
+        self.session = session;
+        self.byteBudget = byteBudget;
+        self.revalidationInterval = kUAInAppMessageAssetPrefetcherDefaultRevalidationInterval;
+        self.downloadQueue = [[NSOperationQueue alloc] init];
+        self.downloadQueue.maxConcurrentOperationCount = maxConcurrentDownloads;
+        self.indexQueue = [[NSOperationQueue alloc] init];
+        self.indexQueue.maxConcurrentOperationCount = 1;
+        self.pendingRequests = [NSMutableDictionary dictionary];
+
+        NSError *error;
+        [[NSFileManager defaultManager] createDirectoryAtURL:storeURL withIntermediateDirectories:YES attributes:nil error:&error];
+        if (error) {
+            UA_LERR(@"Unable to create asset store directory at %@: %@", storeURL, error);
+        }
+
+        [self loadIndex];
+    }
+    return self;
+}
+
+- (double)hitRate {
+    NSUInteger requestCount = self.requestCount;
+    return requestCount ? (double)self.hitCount / requestCount : 0;
+}
+
+- (void)prefetchAssetURL:(NSURL *)assetURL
+                cacheURL:(NSURL *)cacheURL
+       completionHandler:(void (^)(UAInAppMessagePrepareResult))completionHandler {
+    NSString *key = assetURL.absoluteString;
+    NSMutableURLRequest *request;
+    UAInAppMessageAssetStoreEntry *hitEntry;
+
+    @synchronized (self) {
+        self.requestCount++;
+
+        // Share an in-flight download
+        NSMutableArray *pending = self.pendingRequests[key];
+        if (pending) {
+            [pending addObject:[UAInAppMessageAssetPrefetchRequest requestWithCacheURL:cacheURL completionHandler:completionHandler]];
+            return;
+        }
+
+        UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+        if (entry && ![[NSFileManager defaultManager] fileExistsAtPath:[self blobURLForEntry:entry].path]) {
+            [self removeEntryForKey:key];
+            entry = nil;
+        }
+
+        if (entry && [[NSDate date] timeIntervalSinceDate:entry.lastValidated] < self.revalidationInterval) {
+            entry.lastAccessed = [NSDate date];
+            hitEntry = entry;
+            [self setNeedsSaveIndex];
+        } else {
+            self.pendingRequests[key] = [NSMutableArray arrayWithObject:[UAInAppMessageAssetPrefetchRequest requestWithCacheURL:cacheURL
+                                                                                                             completionHandler:completionHandler]];
+            request = [NSMutableURLRequest requestWithURL:assetURL];
+            if (entry.eTag) {
+                [request setValue:entry.eTag forHTTPHeaderField:@"If-None-Match"];
+            }
+            if (entry.lastModified) {
+                [request setValue:entry.lastModified forHTTPHeaderField:@"If-Modified-Since"];
+            }
+        }
+    }
+
+    if (!request) {
+        // Complete asynchronously, as a download would
+        [[UADispatcher backgroundDispatcher] dispatchAsync:^{
+            UAInAppMessagePrepareResult result = [self placeEntry:hitEntry atCacheURL:cacheURL];
+            if (result == UAInAppMessagePrepareResultSuccess) {
+                [self recordHitWithSize:hitEntry.size];
+            }
+            completionHandler(result);
+        }];
+        return;
+    }
+
+    UA_WEAKIFY(self)
+    UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
+        UA_STRONGIFY(self)
+        [[self.session downloadTaskWithRequest:request completionHandler:^(NSURL * _Nullable temporaryFileLocation, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+            UA_STRONGIFY(self)
+            BOOL notModified = NO;
+            UAInAppMessagePrepareResult result = [self storeDownloadForKey:key
+                                                     temporaryFileLocation:temporaryFileLocation
+                                                                  response:response
+                                                                     error:error
+                                                               notModified:&notModified];
+            [self finishRequestsForKey:key result:result notModified:notModified];
+            [operation finish];
+        }] resume];
+    }];
+
+    [self.downloadQueue addOperation:operation];
+}
+
+- (void)waitForIdle {
+    [self.indexQueue waitUntilAllOperationsAreFinished];
+}
+
+#pragma mark -
+#pragma mark Downloads
+
+- (UAInAppMessagePrepareResult)storeDownloadForKey:(NSString *)key
+                             temporaryFileLocation:(NSURL *)temporaryFileLocation
+                                          response:(NSURLResponse *)response
+                                             error:(NSError *)error
+                                       notModified:(BOOL *)notModified {
+    if (error) {
+        UA_LERR(@"Error prefetching media at URL: %@, %@", key, error.localizedDescription);
+        return UAInAppMessagePrepareResultCancel;
+    }
+
+    NSHTTPURLResponse *httpResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+    NSInteger status = httpResponse ? httpResponse.statusCode : 200;
+
+    if (status == 304) {
+        @synchronized (self) {
+            UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+            if (!entry) {
+                // Evicted during revalidation
+                return UAInAppMessagePrepareResultRetry;
+            }
+
+            entry.lastValidated = [NSDate date];
+            entry.eTag = [self headerValue:@"ETag" response:httpResponse] ?: entry.eTag;
+            entry.lastModified = [self headerValue:@"Last-Modified" response:httpResponse] ?: entry.lastModified;
+            *notModified = YES;
+            return UAInAppMessagePrepareResultSuccess;
+        }
+    } else if (status >= 500 && status <= 599) {
+        return UAInAppMessagePrepareResultRetry;
+    } else if (status != 200) {
+        return UAInAppMessagePrepareResultCancel;
+    }
+
+    NSData *data = [NSData dataWithContentsOfURL:temporaryFileLocation options:NSDataReadingMappedIfSafe error:&error];
+    if (!data) {
+        UA_LERR(@"Error reading downloaded media for URL: %@, %@", key, error.localizedDescription);
+        return UAInAppMessagePrepareResultCancel;
+    }
+
+    UAInAppMessageAssetStoreEntry *entry = [[UAInAppMessageAssetStoreEntry alloc] init];
+    entry.contentHash = [UAInAppMessageAssetPrefetcher contentHashWithData:data];
+    entry.size = data.length;
+    entry.eTag = [self headerValue:@"ETag" response:httpResponse];
+    entry.lastModified = [self headerValue:@"Last-Modified" response:httpResponse];
+    entry.lastAccessed = [NSDate date];
+    entry.lastValidated = [NSDate date];
+
+    @synchronized (self) {
+        self.bytesDownloaded += entry.size;
+
+        NSFileManager *fm = [NSFileManager defaultManager];
+        NSString *blobPath = [self blobURLForEntry:entry].path;
+
+        // Identical content may already be stored for another URL
+        if (![fm fileExistsAtPath:blobPath]) {
+            [fm moveItemAtPath:temporaryFileLocation.path toPath:blobPath error:&error];
+            if (error) {
+                UA_LERR(@"Error moving temp file %@ to %@: %@", temporaryFileLocation.path, blobPath, error.localizedDescription);
+                return UAInAppMessagePrepareResultCancel;
+            }
+        }
+
+        // Add before releasing the previous entry so unchanged content is not removed
+        UAInAppMessageAssetStoreEntry *previous = self.entries[key];
+        [self addEntry:entry forKey:key];
+        if (previous) {
+            [self releaseEntry:previous];
+        }
+
+        [self evictEntriesKeepingKey:key];
+        [self setNeedsSaveIndex];
+    }
+
+    return UAInAppMessagePrepareResultSuccess;
+}
+
+- (void)finishRequestsForKey:(NSString *)key result:(UAInAppMessagePrepareResult)result notModified:(BOOL)notModified {
+    NSArray<UAInAppMessageAssetPrefetchRequest *> *requests;
+    UAInAppMessageAssetStoreEntry *entry;
+    NSMutableArray<NSNumber *> *results = [NSMutableArray array];
+
+    @synchronized (self) {
+        requests = self.pendingRequests[key];
+        [self.pendingRequests removeObjectForKey:key];
+
+        entry = self.entries[key];
+        if (notModified) {
+            entry.lastAccessed = [NSDate date];
+            [self setNeedsSaveIndex];
+        }
+    }
+
+    for (NSUInteger i = 0; i < requests.count; i++) {
+        UAInAppMessagePrepareResult requestResult = result;
+        if (result == UAInAppMessagePrepareResultSuccess) {
+            requestResult = [self placeEntry:entry atCacheURL:requests[i].cacheURL];
+
+            // Every request but the one that started the download is a hit, as are all of them if nothing was downloaded
+            if (requestResult == UAInAppMessagePrepareResultSuccess && (i > 0 || notModified)) {
+                [self recordHitWithSize:entry.size];
+            }
+        }
+        [results addObject:@(requestResult)];
+    }
+
+    UA_LTRACE(@"Prefetched %@ for %lu requests, hit rate: %.2f, bytes saved: %llu", key, (unsigned long)requests.count, self.hitRate, self.bytesSaved);
+
+    for (NSUInteger i = 0; i < requests.count; i++) {
+        requests[i].completionHandler([results[i] unsignedIntegerValue]);
+    }
+}
+
+#pragma mark -
+#pragma mark Store
+
+- (void)recordHitWithSize:(unsigned long long)size {
+    @synchronized (self) {
+        self.hitCount++;
+        self.bytesSaved += size;
+    }
+}
+
+/**
+ * Hard links the stored asset to the cache URL, falling back to a copy. Called without holding the lock,
+ * so the asset may be evicted while it is being placed.
+ */
+- (UAInAppMessagePrepareResult)placeEntry:(UAInAppMessageAssetStoreEntry *)entry atCacheURL:(NSURL *)cacheURL {
+    if (!entry) {
+        return UAInAppMessagePrepareResultRetry;
+    }
+
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSString *cachedPath = cacheURL.path;
+    NSString *blobPath = [self blobURLForEntry:entry].path;
+    NSError *error;
+
+    // Remove anything currently existing at the cache path
+    if ([fm fileExistsAtPath:cachedPath]) {
+        [fm removeItemAtPath:cachedPath error:&error];
+        if (error) {
+            UA_LERR(@"Error removing file %@: %@", cachedPath, error.localizedDescription);
+            return UAInAppMessagePrepareResultCancel;
+        }
+    }
+
+    if (![fm linkItemAtPath:blobPath toPath:cachedPath error:&error]) {
+        error = nil;
+        [fm copyItemAtPath:blobPath toPath:cachedPath error:&error];
+        if (error && ![fm fileExistsAtPath:blobPath]) {
+            UA_LDEBUG(@"Asset %@ was evicted before it could be placed", blobPath);
+            return UAInAppMessagePrepareResultRetry;
+        } else if (error) {
+            UA_LERR(@"Error copying %@ to %@: %@", blobPath, cachedPath, error.localizedDescription);
+            return UAInAppMessagePrepareResultCancel;
+        }
+    }
+
+    return UAInAppMessagePrepareResultSuccess;
+}
+
+/**
+ * Evicts the least recently used assets until the store is within its byte budget. Must be called while synchronized.
+ */
+- (void)evictEntriesKeepingKey:(NSString *)keptKey {
+    if (self.storeSize <= self.byteBudget) {
+        return;
+    }
+
+    NSArray<NSString *> *keys = [self.entries keysSortedByValueUsingComparator:^NSComparisonResult(UAInAppMessageAssetStoreEntry *entry1, UAInAppMessageAssetStoreEntry *entry2) {
+        return [entry1.lastAccessed compare:entry2.lastAccessed];
+    }];
+
+    for (NSString *key in keys) {
+        if (self.storeSize <= self.byteBudget) {
+            break;
+        }
+
+        if ([key isEqualToString:keptKey] || self.pendingRequests[key]) {
+            continue;
+        }
+
+        UA_LTRACE(@"Evicting asset %@", key);
+        [self removeEntryForKey:key];
+    }
+}
+
+/**
+ * Must be called while synchronized.
+ */
+- (void)addEntry:(UAInAppMessageAssetStoreEntry *)entry forKey:(NSString *)key {
+    if (![self.contentHashes countForObject:entry.contentHash]) {
+        self.storeSize += entry.size;
+    }
+    [self.contentHashes addObject:entry.contentHash];
+    self.entries[key] = entry;
+}
+
+/**
+ * Must be called while synchronized.
+ */
+- (void)removeEntryForKey:(NSString *)key {
+    UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+    if (entry) {
+        [self.entries removeObjectForKey:key];
+        [self releaseEntry:entry];
+    }
+}
+
+/**
+ * Removes the stored asset once no entries reference it. Must be called while synchronized.
+ */
+- (void)releaseEntry:(UAInAppMessageAssetStoreEntry *)entry {
+    [self.contentHashes removeObject:entry.contentHash];
+
+    if (![self.contentHashes countForObject:entry.contentHash]) {
+        self.storeSize -= MIN(entry.size, self.storeSize);
+        [[NSFileManager defaultManager] removeItemAtURL:[self blobURLForEntry:entry] error:nil];
+    }
+}
+
+- (void)loadIndex {
+    self.entries = [NSMutableDictionary dictionary];
+    self.contentHashes = [NSCountedSet set];
+
+    NSDictionary *index = [NSDictionary dictionaryWithContentsOfURL:[self.storeURL URLByAppendingPathComponent:UAInAppMessageAssetStoreIndexFileName]];
+    for (NSString *key in index) {
+        UAInAppMessageAssetStoreEntry *entry = [index[key] isKindOfClass:[NSDictionary class]] ? [UAInAppMessageAssetStoreEntry entryWithDictionary:index[key]] : nil;
+        if (entry) {
+            [self addEntry:entry forKey:key];
+        }
+    }
+}
+
+/**
+ * Schedules a save of the index on the index queue. Changes made before the save runs are
+ * written together. Must be called while synchronized.
+ */
+- (void)setNeedsSaveIndex {
+    if (self.indexSaveScheduled) {
+        return;
+    }
+
+    self.indexSaveScheduled = YES;
+    [self.indexQueue addOperationWithBlock:^{
+        [self saveIndex];
+    }];
+}
+
+/**
+ * Writes the index to disk. Only the snapshot is taken while synchronized.
+ */
+- (void)saveIndex {
+    NSMutableDictionary *index;
+    @synchronized (self) {
+        self.indexSaveScheduled = NO;
+        index = [NSMutableDictionary dictionaryWithCapacity:self.entries.count];
+        for (NSString *key in self.entries) {
+            index[key] = [self.entries[key] dictionaryValue];
+        }
+    }
+
+    if (![index writeToURL:[self.storeURL URLByAppendingPathComponent:UAInAppMessageAssetStoreIndexFileName] atomically:YES]) {
+        UA_LERR(@"Unable to save asset store index");
+    }
+}
+
+- (NSURL *)blobURLForEntry:(UAInAppMessageAssetStoreEntry *)entry {
+    return [self.storeURL URLByAppendingPathComponent:entry.contentHash];
+}
+
+#pragma mark -
+#pragma mark Utilities
+
+- (nullable NSString *)headerValue:(NSString *)name response:(nullable NSHTTPURLResponse *)response {
+    NSDictionary *headers = response.allHeaderFields;
+    for (id header in headers) {
+        if ([header isKindOfClass:[NSString class]] && [header caseInsensitiveCompare:name] == NSOrderedSame) {
+            id value = headers[header];
+            return [value isKindOfClass:[NSString class]] ? value : nil;
+        }
+    }
+    return nil;
+}
+
++ (NSString *)contentHashWithData:(NSData *)data {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+
+    NSMutableString *hash = [NSMutableString stringWithCapacity:(CC_SHA256_DIGEST_LENGTH * 2)];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hash appendFormat:@"%02x", digest[i]];
+    }
+    return hash;
+}
+
+@end
@@ -0,0 +1,21 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageAssetPrefetcher+Internal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UAInAppMessageDefaultPrepareAssetsDelegate()
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param prefetcher The asset prefetcher.
+ */
++ (instancetype)delegateWithPrefetcher:(UAInAppMessageAssetPrefetcher *)prefetcher;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -1,14 +1,34 @@
 /* Copyright Airship and Contributors */
 
-#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageDefaultPrepareAssetsDelegate+Internal.h"
 #import "UAInAppMessageMediaInfo.h"
 #import "UAInAppMessageBannerDisplayContent.h"
 #import "UAInAppMessageFullScreenDisplayContent.h"
 #import "UAInAppMessageModalDisplayContent.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+@interface UAInAppMessageDefaultPrepareAssetsDelegate()
+@property (nonatomic, strong) UAInAppMessageAssetPrefetcher *prefetcher;
+@end
+
 @implementation UAInAppMessageDefaultPrepareAssetsDelegate
 
++ (instancetype)delegateWithPrefetcher:(UAInAppMessageAssetPrefetcher *)prefetcher {
+    return [[self alloc] initWithPrefetcher:prefetcher];
+}
+
+- (instancetype)init {
+    return [self initWithPrefetcher:[UAInAppMessageAssetPrefetcher defaultPrefetcher]];
+}
+
+- (instancetype)initWithPrefetcher:(UAInAppMessageAssetPrefetcher *)prefetcher {
+    self = [super init];
+    if (self) {
+        self.prefetcher = prefetcher;
+    }
+    return self;
+}
+
 - (void)onSchedule:(nonnull UAInAppMessage *)message assets:(nonnull UAInAppMessageAssets *)assets completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
     [self onPrepare:message assets:assets completionHandler:completionHandler];
 }
@@ -59,49 +79,7 @@
 }
 
 - (void)cacheImage:(NSURL *)assetURL cacheURL:(NSURL *)cacheURL completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
-    [[[NSURLSession sharedSession] downloadTaskWithURL:assetURL completionHandler:^(NSURL * _Nullable temporaryFileLocation, NSURLResponse * _Nullable response, NSError * _Nullable error) {
-        if (error) {
-            UA_LERR(@"Error prefetching media at URL: %@, %@", assetURL, error.localizedDescription);
-            completionHandler(UAInAppMessagePrepareResultCancel);
-            return;
-        }
-        
-        if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-            NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *) response;
-            NSInteger status = httpResponse.statusCode;
-            if (status >= 500 && status <= 599) {
-                completionHandler(UAInAppMessagePrepareResultRetry);
-                return;
-            } else if (status != 200) {
-                completionHandler(UAInAppMessagePrepareResultCancel);
-                return;
-            }
-        }
-        
-        NSString *cachedPath = [cacheURL path];
-        
-        NSFileManager *fm = [NSFileManager defaultManager];
-        
-        // Remove anything currently existing at the cache path
-        if ([fm fileExistsAtPath:cachedPath]) {
-            [fm removeItemAtPath:cachedPath error:&error];
-            if (error) {
-                UA_LERR(@"Error removing file %@: %@", cachedPath, error.localizedDescription);
-                completionHandler(UAInAppMessagePrepareResultCancel);
-                return;
-            }
-        }
-        
-        // Move temp file to cache location
-        [fm moveItemAtPath:temporaryFileLocation.path toPath:cachedPath error:&error];
-        if (error) {
-            UA_LERR(@"Error moving temp file %@ to %@: %@", temporaryFileLocation.path, cachedPath, error.localizedDescription);
-            completionHandler(UAInAppMessagePrepareResultCancel);
-            return;
-        }
-        
-        completionHandler(UAInAppMessagePrepareResultSuccess);
-    }] resume];
+    [self.prefetcher prefetchAssetURL:assetURL cacheURL:cacheURL completionHandler:completionHandler];
 }
 
 @end
@@ -71,6 +71,27 @@ NS_ASSUME_NONNULL_BEGIN
                         analytics:(UAAnalytics *)analytics;
 
 
+/**
+ * Gets the index entries of all in-app message schedules, including schedules that have ended,
+ * without building the schedules.
+ *
+ * @param completionHandler The completion handler with the result.
+ */
+- (void)getMessageScheduleIndex:(void (^)(NSArray<UAScheduleIndexEntry *> *))completionHandler;
+
+/**
+ * Edits existing message schedules and schedules new messages in a single store transaction.
+ *
+ * @param edits A map of schedule identifier to the edits to apply.
+ * @param scheduleInfos The schedule info for the new messages.
+ * @param metadata The new schedules' optional metadata.
+ * @param completionHandler The completion handler with the new schedules that were saved.
+ */
+- (void)editSchedules:(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *)edits
+         newSchedules:(NSArray<UAInAppMessageScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(void (^)(NSArray<UASchedule *> *))completionHandler;
+
 // UAAutomationEngineDelegate methods for testing
 
 /**
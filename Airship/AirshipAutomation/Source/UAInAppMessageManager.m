@@ -237,6 +237,10 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     [self.automationEngine getAllSchedules:completionHandler];
 }
 
+- (void)getMessageScheduleIndex:(void (^)(NSArray<UAScheduleIndexEntry *> *))completionHandler {
+    [self.automationEngine getMessageScheduleIndex:completionHandler];
+}
+
 - (void)scheduleMessageWithScheduleInfo:(UAInAppMessageScheduleInfo *)scheduleInfo
                       completionHandler:(void (^)(UASchedule *))completionHandler {
     [self scheduleMessageWithScheduleInfo:scheduleInfo metadata:nil completionHandler:completionHandler];
@@ -299,6 +303,20 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     [self.automationEngine editScheduleWithID:identifier edits:edits completionHandler:completionHandler];
 }
 
+- (void)editSchedules:(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *)edits
+         newSchedules:(NSArray<UAInAppMessageScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(void (^)(NSArray<UASchedule *> *))completionHandler {
+    [self.automationEngine editSchedules:edits
+                            newSchedules:scheduleInfos
+                                metadata:metadata
+                       completionHandler:^(NSArray<UASchedule *> *schedules) {
+        // Schedule the assets
+        [self scheduleAssets:schedules];
+        completionHandler(schedules);
+    }];
+}
+
 - (UAScheduleInfo *)createScheduleInfoWithBuilder:(UAScheduleInfoBuilder *)builder {
     return [[UAInAppMessageScheduleInfo alloc] initWithBuilder:builder];
 }
@@ -752,6 +770,14 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     [self updateEnginePauseState];
 }
 
+- (void)airshipReady:(UAirship *)airship {
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAfter:airship.config.moduleActivationDelay block:^{
+        UA_STRONGIFY(self)
+        [self.automationEngine activateIfNeeded];
+    }];
+}
+
 - (void)applyRemoteConfig:(nullable id)config {
     UAInAppMessagingRemoteConfig *inAppConfig = nil;
     if (config) {
@@ -2,7 +2,7 @@
 
 #import "UAInAppRemoteDataClient+Internal.h"
 #import "UAInAppMessageScheduleInfo+Internal.h"
-#import "UAInAppMessageManager.h"
+#import "UAInAppMessageManager+Internal.h"
 #import "UAInAppMessageAudienceChecks+Internal.h"
 #import "UAInAppMessage+Internal.h"
 #import "UAInAppMessageScheduleEdits+Internal.h"
@@ -98,22 +98,21 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
     NSDictionary *lastMetadata = self.lastPayloadMetadata ?: @{};
     BOOL isMetadataCurrent = [thisPayloadMetadata isEqualToDictionary:lastMetadata];
 
-    // generate messageId to scheduleId map for existing schedules
+    // generate messageId to scheduleId map for existing schedules from the schedule index,
+    // which avoids decoding every schedule
     NSMutableDictionary<NSString *, NSString *> *scheduleIDMap = [NSMutableDictionary dictionary];
     dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
-    [self.inAppMessageManager getAllSchedules:^(NSArray<UASchedule *> *schedules) {
-        for (UASchedule *schedule in schedules) {
-            UAInAppMessage *message = (UAInAppMessage *)((UAInAppMessageScheduleInfo *)schedule.info).message;
-            if (message.source != UAInAppMessageSourceRemoteData) {
+    [self.inAppMessageManager getMessageScheduleIndex:^(NSArray<UAScheduleIndexEntry *> *entries) {
+        for (UAScheduleIndexEntry *entry in entries) {
+            if (![entry.messageSource isEqualToString:UAInAppMessageSourceRemoteDataValue]) {
                 continue;
             }
 
-            NSString *messageID = message.identifier;
-            if (!messageID.length) {
+            if (!entry.messageID.length) {
                 continue;
             }
 
-            scheduleIDMap[messageID] = schedule.identifier;
+            scheduleIDMap[entry.messageID] = entry.scheduleID;
         }
         dispatch_semaphore_signal(semaphore);
     }];
@@ -140,9 +139,7 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
 
     NSMutableArray<NSString *> *messageIDs = [NSMutableArray array];
     NSMutableArray<UAInAppMessageScheduleInfo *> *newSchedules = [NSMutableArray array];
-
-    // Dispatch group
-    dispatch_group_t dispatchGroup = dispatch_group_create();
+    NSMutableDictionary<NSString *, UAInAppMessageScheduleEdits *> *scheduleEdits = [NSMutableDictionary dictionary];
 
     // Validate messages and create new schedules
     for (NSDictionary *message in messages) {
@@ -201,15 +198,8 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
                 continue;
             }
 
-            dispatch_group_enter(dispatchGroup);
-            [self.inAppMessageManager editScheduleWithID:scheduleIDMap[messageID]
-                                                   edits:edits
-                                       completionHandler:^(UASchedule *schedule) {
-                dispatch_group_leave(dispatchGroup);
-                if (schedule) {
-                    UA_LTRACE("Updated in-app message: %@", messageID);
-                }
-            }];
+            UA_LTRACE("Updating in-app message: %@", messageID);
+            scheduleEdits[scheduleIDMap[messageID]] = edits;
         }
     }
 
@@ -228,29 +218,24 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
         }];
 
         for (NSString *messageID in deletedMessageIDs) {
-            dispatch_group_enter(dispatchGroup);
-            [self.inAppMessageManager editScheduleWithID:scheduleIDMap[messageID]
-                                                   edits:edits
-                                       completionHandler:^(UASchedule *schedule) {
-                dispatch_group_leave(dispatchGroup);
-                if (schedule) {
-                    UA_LTRACE("Ended in-app message: %@", messageID);
-                }
-            }];
+            UA_LTRACE("Ending in-app message: %@", messageID);
+            scheduleEdits[scheduleIDMap[messageID]] = edits;
         }
     }
 
-    // New messages
-    if (newSchedules.count) {
-        dispatch_group_enter(dispatchGroup);
-
-        [self.inAppMessageManager scheduleMessagesWithScheduleInfo:newSchedules metadata:thisPayloadMetadata completionHandler:^(NSArray<UASchedule *> *schedules) {
-            dispatch_group_leave(dispatchGroup);
+    // Apply the edits and new messages in a single transaction
+    if (scheduleEdits.count || newSchedules.count) {
+        dispatch_semaphore_t editSemaphore = dispatch_semaphore_create(0);
+        [self.inAppMessageManager editSchedules:scheduleEdits
+                                   newSchedules:newSchedules
+                                       metadata:thisPayloadMetadata
+                              completionHandler:^(NSArray<UASchedule *> *schedules) {
+            dispatch_semaphore_signal(editSemaphore);
         }];
-    }
 
-    // Wait for everything to finish
-    dispatch_group_wait(dispatchGroup,  DISPATCH_TIME_FOREVER);
+        // Wait for everything to finish
+        dispatch_semaphore_wait(editSemaphore, DISPATCH_TIME_FOREVER);
+    }
 
     // Save state
     self.lastPayloadMetadata = thisPayloadMetadata;
@@ -154,6 +154,23 @@ extern NSUInteger const UAScheduleDataVersion;
  */
 @property(nullable, nonatomic, retain) NSNumber *interval;
 
+/**
+ * The message ID from the schedule's data, if the data is an in-app message.
+ * Updated whenever the data is set.
+ */
+@property (nullable, nonatomic, retain, readonly) NSString *messageID;
+
+/**
+ * The message source from the schedule's data, if the data is an in-app message.
+ * Updated whenever the data is set.
+ */
+@property (nullable, nonatomic, retain, readonly) NSString *messageSource;
+
+/**
+ * The date the schedule's data was last set.
+ */
+@property (nullable, nonatomic, retain, readonly) NSDate *lastUpdated;
+
 /**
  * Whether the scheudle has exceeded its limit.
  */
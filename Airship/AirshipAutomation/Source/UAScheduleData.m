@@ -1,12 +1,20 @@
 /* Copyright Airship and Contributors */
 
 #import "UAScheduleData+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
 
 // Data version - for migration
-NSUInteger const UAScheduleDataVersion = 2;
+NSUInteger const UAScheduleDataVersion = 3;
+
+// In-app message JSON keys, kept local so the store does not depend on the message classes
+static NSString *const UAScheduleDataMessageIDKey = @"message_id";
+static NSString *const UAScheduleDataMessageSourceKey = @"source";
 
 @interface UAScheduleData()
 @property (nullable, nonatomic, retain) NSDate *executionStateChangeDate;
+@property (nullable, nonatomic, retain) NSString *messageID;
+@property (nullable, nonatomic, retain) NSString *messageSource;
+@property (nullable, nonatomic, retain) NSDate *lastUpdated;
 @end
 
 @implementation UAScheduleData
@@ -28,6 +36,9 @@ NSUInteger const UAScheduleDataVersion = 2;
 @dynamic executionStateChangeDate;
 @dynamic interval;
 @dynamic editGracePeriod;
+@dynamic messageID;
+@dynamic messageSource;
+@dynamic lastUpdated;
 
 -(void)setExecutionState:(NSNumber *)executionState {
     [self willChangeValueForKey:@"executionState"];
@@ -36,6 +47,35 @@ NSUInteger const UAScheduleDataVersion = 2;
     [self setExecutionStateChangeDate:[NSDate date]];
 }
 
+- (void)setData:(NSString *)data {
+    [self willChangeValueForKey:@"data"];
+    [self setPrimitiveValue:data forKey:@"data"];
+    [self didChangeValueForKey:@"data"];
+
+    // Keep the message projection in sync so it can be queried without decoding the data
+    id json = data ? [NSJSONSerialization objectWithString:data] : nil;
+    NSString *messageID;
+    NSString *messageSource;
+
+    if ([json isKindOfClass:[NSDictionary class]]) {
+        id value = json[UAScheduleDataMessageIDKey];
+        messageID = [value isKindOfClass:[NSString class]] && [value length] ? value : nil;
+
+        value = json[UAScheduleDataMessageSourceKey];
+        messageSource = [value isKindOfClass:[NSString class]] ? [value lowercaseString] : nil;
+    }
+
+    if (!(self.messageID == messageID || [self.messageID isEqualToString:messageID])) {
+        self.messageID = messageID;
+    }
+
+    if (!(self.messageSource == messageSource || [self.messageSource isEqualToString:messageSource])) {
+        self.messageSource = messageSource;
+    }
+
+    self.lastUpdated = [NSDate date];
+}
+
 - (BOOL)isOverLimit {
     NSUInteger limit = [self.limit unsignedIntegerValue];
     NSUInteger count = [self.triggeredCount unsignedIntegerValue];
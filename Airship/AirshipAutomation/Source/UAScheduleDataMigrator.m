@@ -28,6 +28,9 @@ NSString *const UAInAppMessageV2SourceRemoteDataValue = @"remote-data";
             case 1:
                 [self perform1To2MigrationForScheduleData:scheduleData];
                 break;
+            case 2:
+                [self perform2To3MigrationForScheduleData:scheduleData];
+                break;
             default:
                 UA_LERR(@"No migration available for version %lu to version %lu", (unsigned long)version, (unsigned long)(version + 1));
                 break;
@@ -85,4 +88,12 @@ NSString *const UAInAppMessageV2SourceRemoteDataValue = @"remote-data";
     scheduleData.data = [NSJSONSerialization stringWithObject:json];
 }
 
+// populate the message ID and source projection added in version 3
++ (void)perform2To3MigrationForScheduleData:(UAScheduleData *)scheduleData {
+    scheduleData.dataVersion = @(3);
+
+    // setting the data updates the projection
+    scheduleData.data = scheduleData.data;
+}
+
 @end
@@ -0,0 +1,57 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A lightweight projection of a stored schedule, read without decoding the schedule's
+ * data, triggers, or delay.
+ */
+@interface UAScheduleIndexEntry : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Index Entry Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The schedule's identifier.
+ */
+@property (nonatomic, readonly) NSString *scheduleID;
+
+/**
+ * The in-app message ID, or nil if the schedule is not an in-app message.
+ */
+@property (nonatomic, readonly, nullable) NSString *messageID;
+
+/**
+ * The in-app message source, or nil if the schedule is not an in-app message.
+ */
+@property (nonatomic, readonly, nullable) NSString *messageSource;
+
+/**
+ * The date the schedule's data was last updated.
+ */
+@property (nonatomic, readonly, nullable) NSDate *lastUpdated;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Index Entry Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param scheduleID The schedule ID.
+ * @param messageID The message ID.
+ * @param messageSource The message source.
+ * @param lastUpdated The last updated date.
+ * @return A schedule index entry.
+ */
++ (instancetype)entryWithScheduleID:(NSString *)scheduleID
+                          messageID:(nullable NSString *)messageID
+                      messageSource:(nullable NSString *)messageSource
+                        lastUpdated:(nullable NSDate *)lastUpdated;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,40 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleIndexEntry+Internal.h"
+
+@interface UAScheduleIndexEntry ()
+@property (nonatomic, copy) NSString *scheduleID;
+@property (nonatomic, copy, nullable) NSString *messageID;
+@property (nonatomic, copy, nullable) NSString *messageSource;
+@property (nonatomic, strong, nullable) NSDate *lastUpdated;
+@end
+
+@implementation UAScheduleIndexEntry
+
+- (instancetype)initWithScheduleID:(NSString *)scheduleID
+                         messageID:(NSString *)messageID
+                     messageSource:(NSString *)messageSource
+                       lastUpdated:(NSDate *)lastUpdated {
+    self = [super init];
+
+    if (self) {
+        self.scheduleID = scheduleID;
+        self.messageID = messageID;
+        self.messageSource = messageSource;
+        self.lastUpdated = lastUpdated;
+    }
+
+    return self;
+}
+
++ (instancetype)entryWithScheduleID:(NSString *)scheduleID
+                          messageID:(NSString *)messageID
+                      messageSource:(NSString *)messageSource
+                        lastUpdated:(NSDate *)lastUpdated {
+    return [[self alloc] initWithScheduleID:scheduleID
+                                  messageID:messageID
+                              messageSource:messageSource
+                                lastUpdated:lastUpdated];
+}
+
+@end
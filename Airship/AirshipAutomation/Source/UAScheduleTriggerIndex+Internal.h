@@ -0,0 +1,73 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import <CoreData/CoreData.h>
+#import "UAScheduleTrigger.h"
+
+@class UAScheduleTriggerData;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * In-memory index of stored triggers, keyed by trigger type and, for custom event
+ * triggers, by the event name the trigger's predicate requires.
+ *
+ * The index is a superset of the active triggers. It is only used to rule out
+ * events that no stored trigger could match, so a negative answer is exact while
+ * a positive answer still requires a store fetch.
+ */
+@interface UAScheduleTriggerIndex : NSObject
+
+/**
+ * Whether the index has been built from the store. Until then every lookup matches.
+ */
+@property (atomic, readonly) BOOL isLoaded;
+
+/**
+ * Factory method.
+ *
+ * @return A trigger index.
+ */
++ (instancetype)index;
+
+/**
+ * Replaces the index contents. Must be called on the triggers' managed object context queue.
+ *
+ * @param triggers All stored triggers.
+ */
+- (void)loadTriggers:(NSArray<UAScheduleTriggerData *> *)triggers;
+
+/**
+ * Adds a trigger to the index. Must be called on the trigger's managed object context queue.
+ *
+ * @param triggerData The trigger data.
+ */
+- (void)addTrigger:(UAScheduleTriggerData *)triggerData;
+
+/**
+ * Removes a trigger from the index.
+ *
+ * @param triggerID The trigger's managed object ID.
+ */
+- (void)removeTriggerWithID:(NSManagedObjectID *)triggerID;
+
+/**
+ * Checks if any stored trigger could match an event.
+ *
+ * @param type The trigger type.
+ * @param argument The event argument, e.g. the custom event payload.
+ * @return `NO` if no stored trigger can match, otherwise `YES`.
+ */
+- (BOOL)containsTriggersWithType:(UAScheduleTriggerType)type argument:(nullable id)argument;
+
+/**
+ * Extracts the custom event names a predicate requires.
+ *
+ * @param json The predicate JSON.
+ * @return The set of event names, or nil if the predicate can match any event name.
+ */
++ (nullable NSSet<NSString *> *)eventNamesForPredicateJSON:(nullable id)json;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,210 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleTriggerIndex+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+@interface UAScheduleTriggerIndexEntry : NSObject
+@property (nonatomic, strong) NSNumber *type;
+@property (nonatomic, copy, nullable) NSSet<NSString *> *eventNames;
+@end
+
+@implementation UAScheduleTriggerIndexEntry
+@end
+
+@interface UAScheduleTriggerIndex ()
+@property (nonatomic, strong) NSMutableDictionary<NSManagedObjectID *, UAScheduleTriggerIndexEntry *> *entries;
+@property (nonatomic, strong) NSCountedSet<NSNumber *> *typeCounts;
+@property (nonatomic, strong) NSCountedSet<NSNumber *> *unnamedTypeCounts;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSCountedSet<NSString *> *> *eventNameCounts;
+@property (atomic, assign) BOOL isLoaded;
+@end
+
+@implementation UAScheduleTriggerIndex
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.entries = [NSMutableDictionary dictionary];
+        self.typeCounts = [NSCountedSet set];
+        self.unnamedTypeCounts = [NSCountedSet set];
+        self.eventNameCounts = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)index {
+    return [[self alloc] init];
+}
+
+- (void)loadTriggers:(NSArray<UAScheduleTriggerData *> *)triggers {
+    @synchronized (self) {
+        [self.entries removeAllObjects];
+        [self.typeCounts removeAllObjects];
+        [self.unnamedTypeCounts removeAllObjects];
+        [self.eventNameCounts removeAllObjects];
+
+        for (UAScheduleTriggerData *triggerData in triggers) {
+            [self addTrigger:triggerData];
+        }
+
+        self.isLoaded = YES;
+    }
+}
+
+- (void)addTrigger:(UAScheduleTriggerData *)triggerData {
+    NSManagedObjectID *triggerID = triggerData.objectID;
+    if (!triggerData.type || triggerID.isTemporaryID) {
+        return;
+    }
+
+    UAScheduleTriggerIndexEntry *entry = [[UAScheduleTriggerIndexEntry alloc] init];
+    entry.type = triggerData.type;
+
+    if ([UAScheduleTriggerIndex isCustomEventType:[entry.type integerValue]] && triggerData.predicateData) {
+        id json = [NSJSONSerialization JSONObjectWithData:triggerData.predicateData options:0 error:nil];
+        entry.eventNames = [UAScheduleTriggerIndex eventNamesForPredicateJSON:json];
+    }
+
+    @synchronized (self) {
+        if (self.entries[triggerID]) {
+            return;
+        }
+
+        self.entries[triggerID] = entry;
+        [self.typeCounts addObject:entry.type];
+
+        if (!entry.eventNames) {
+            [self.unnamedTypeCounts addObject:entry.type];
+            return;
+        }
+
+        NSCountedSet *names = self.eventNameCounts[entry.type];
+        if (!names) {
+            names = [NSCountedSet set];
+            self.eventNameCounts[entry.type] = names;
+        }
+
+        for (NSString *name in entry.eventNames) {
+            [names addObject:name];
+        }
+    }
+}
+
+- (void)removeTriggerWithID:(NSManagedObjectID *)triggerID {
+    @synchronized (self) {
+        UAScheduleTriggerIndexEntry *entry = self.entries[triggerID];
+        if (!entry) {
+            return;
+        }
+
+        [self.entries removeObjectForKey:triggerID];
+        [self.typeCounts removeObject:entry.type];
+
+        if (!entry.eventNames) {
+            [self.unnamedTypeCounts removeObject:entry.type];
+            return;
+        }
+
+        NSCountedSet *names = self.eventNameCounts[entry.type];
+        for (NSString *name in entry.eventNames) {
+            [names removeObject:name];
+        }
+    }
+}
+
+- (BOOL)containsTriggersWithType:(UAScheduleTriggerType)type argument:(nullable id)argument {
+    if (!self.isLoaded) {
+        return YES;
+    }
+
+    @synchronized (self) {
+        if (![self.typeCounts countForObject:@(type)]) {
+            return NO;
+        }
+
+        if (![UAScheduleTriggerIndex isCustomEventType:type] || ![argument isKindOfClass:[NSDictionary class]]) {
+            return YES;
+        }
+
+        id eventName = argument[UACustomEventNameKey];
+        if (![eventName isKindOfClass:[NSString class]]) {
+            return YES;
+        }
+
+        return [self.unnamedTypeCounts countForObject:@(type)] || [self.eventNameCounts[@(type)] countForObject:eventName];
+    }
+}
+
++ (BOOL)isCustomEventType:(UAScheduleTriggerType)type {
+    return type == UAScheduleTriggerCustomEventCount || type == UAScheduleTriggerCustomEventValue;
+}
+
++ (nullable NSSet<NSString *> *)eventNamesForPredicateJSON:(nullable id)json {
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    NSDictionary *predicate = json;
+
+    // And: any constrained subpredicate constrains the whole predicate
+    if ([predicate[@"and"] isKindOfClass:[NSArray class]]) {
+        for (id subpredicate in predicate[@"and"]) {
+            NSSet *names = [self eventNamesForPredicateJSON:subpredicate];
+            if (names) {
+                return names;
+            }
+        }
+        return nil;
+    }
+
+    // Or: every subpredicate must be constrained
+    if ([predicate[@"or"] isKindOfClass:[NSArray class]]) {
+        NSMutableSet *result = [NSMutableSet set];
+        for (id subpredicate in predicate[@"or"]) {
+            NSSet *names = [self eventNamesForPredicateJSON:subpredicate];
+            if (!names) {
+                return nil;
+            }
+            [result unionSet:names];
+        }
+        return result.count ? result : nil;
+    }
+
+    // Not and any other compound type can match any name
+    if (predicate[@"not"]) {
+        return nil;
+    }
+
+    // Matcher: only exact, case sensitive event name matches are indexed
+    if ([predicate[@"ignore_case"] boolValue]) {
+        return nil;
+    }
+
+    NSMutableArray *paths = [NSMutableArray array];
+    id scope = predicate[@"scope"];
+    if ([scope isKindOfClass:[NSString class]]) {
+        [paths addObject:scope];
+    } else if ([scope isKindOfClass:[NSArray class]]) {
+        [paths addObjectsFromArray:scope];
+    }
+
+    if (predicate[@"key"]) {
+        [paths addObject:predicate[@"key"]];
+    }
+
+    if (![paths isEqualToArray:@[UACustomEventNameKey]]) {
+        return nil;
+    }
+
+    id value = predicate[@"value"];
+    if (![value isKindOfClass:[NSDictionary class]] || [value count] != 1 || ![value[@"equals"] isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    return [NSSet setWithObject:value[@"equals"]];
+}
+
+@end
@@ -0,0 +1,59 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UAAirshipAutomationCoreImport.h"
+
+@class UAScheduleTriggerData;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * In-memory cache of compiled trigger predicates, keyed by trigger identity.
+ *
+ * Trigger predicates are immutable once a schedule is saved, so each trigger's
+ * predicate data only needs to be parsed and compiled once. Entries are invalidated when the
+ * owning schedule is edited or deleted.
+ */
+@interface UAScheduleTriggerPredicateCache : NSObject
+
+/**
+ * The number of lookups that were served from the cache.
+ */
+@property (atomic, readonly) NSUInteger hitCount;
+
+/**
+ * The number of lookups that required parsing the trigger's predicate data.
+ */
+@property (atomic, readonly) NSUInteger missCount;
+
+/**
+ * Factory method.
+ *
+ * @return A predicate cache.
+ */
++ (instancetype)cache;
+
+/**
+ * Gets the compiled predicate for the trigger, parsing, compiling, and caching it on a miss.
+ * Must be called on the trigger's managed object context queue.
+ *
+ * @param triggerData The trigger data.
+ * @return The trigger's predicate, or nil if the trigger does not define one.
+ */
+- (nullable UACompiledJSONPredicate *)predicateForTriggerData:(UAScheduleTriggerData *)triggerData;
+
+/**
+ * Removes all cached predicates for triggers belonging to the given schedule.
+ *
+ * @param scheduleID The schedule identifier.
+ */
+- (void)invalidateScheduleWithID:(NSString *)scheduleID;
+
+/**
+ * Removes all cached predicates.
+ */
+- (void)invalidateAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
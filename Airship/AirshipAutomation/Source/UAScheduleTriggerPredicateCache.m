@@ -0,0 +1,116 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleTriggerPredicateCache+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
+#import "UAScheduleDelayData+Internal.h"
+#import "UAScheduleData+Internal.h"
+
+@interface UAScheduleTriggerPredicateCache () {
+    // Counters are only read and updated while synchronized on self
+    NSUInteger _hitCount;
+    NSUInteger _missCount;
+}
+@property (nonatomic, strong) NSMutableDictionary<NSManagedObjectID *, id> *predicates;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableSet<NSManagedObjectID *> *> *scheduleTriggers;
+@end
+
+@implementation UAScheduleTriggerPredicateCache
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.predicates = [NSMutableDictionary dictionary];
+        self.scheduleTriggers = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)cache {
+    return [[self alloc] init];
+}
+
+- (nullable UACompiledJSONPredicate *)predicateForTriggerData:(UAScheduleTriggerData *)triggerData {
+    NSManagedObjectID *triggerID = triggerData.objectID;
+
+    // Temporary IDs change on save, so only cache triggers that have been persisted
+    if (triggerID.isTemporaryID) {
+        @synchronized (self) {
+            _missCount++;
+        }
+        return [UAScheduleTriggerPredicateCache parsePredicateData:triggerData.predicateData];
+    }
+
+    @synchronized (self) {
+        id cached = self.predicates[triggerID];
+        if (cached) {
+            _hitCount++;
+            return cached == [NSNull null] ? nil : cached;
+        }
+
+        _missCount++;
+    }
+
+    UACompiledJSONPredicate *predicate = [UAScheduleTriggerPredicateCache parsePredicateData:triggerData.predicateData];
+    NSString *scheduleID = triggerData.schedule.identifier ?: triggerData.delay.schedule.identifier;
+
+    @synchronized (self) {
+        self.predicates[triggerID] = predicate ?: [NSNull null];
+
+        if (scheduleID) {
+            NSMutableSet *triggerIDs = self.scheduleTriggers[scheduleID];
+            if (!triggerIDs) {
+                triggerIDs = [NSMutableSet set];
+                self.scheduleTriggers[scheduleID] = triggerIDs;
+            }
+            [triggerIDs addObject:triggerID];
+        }
+    }
+
+    return predicate;
+}
+
+- (NSUInteger)hitCount {
+    @synchronized (self) {
+        return _hitCount;
+    }
+}
+
+- (NSUInteger)missCount {
+    @synchronized (self) {
+        return _missCount;
+    }
+}
+
+- (void)invalidateScheduleWithID:(NSString *)scheduleID {
+    if (!scheduleID) {
+        return;
+    }
+
+    @synchronized (self) {
+        NSSet *triggerIDs = self.scheduleTriggers[scheduleID];
+        if (triggerIDs) {
+            [self.predicates removeObjectsForKeys:triggerIDs.allObjects];
+            [self.scheduleTriggers removeObjectForKey:scheduleID];
+        }
+    }
+}
+
+- (void)invalidateAll {
+    @synchronized (self) {
+        [self.predicates removeAllObjects];
+        [self.scheduleTriggers removeAllObjects];
+    }
+}
+
++ (nullable UACompiledJSONPredicate *)parsePredicateData:(nullable NSData *)data {
+    if (!data) {
+        return nil;
+    }
+
+    id json = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:nil];
+    return [UACompiledJSONPredicate compiledPredicateWithJSON:json error:nil];
+}
+
+@end
@@ -23,6 +23,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) NSMutableArray *reservedEntryNames;
 
+/**
+ * Registrations that run the first time the registry is used. Guarded by self.
+ */
+@property (nonatomic, strong) NSMutableArray<void (^)(UAActionRegistry *)> *pendingRegistrations;
+
 ///---------------------------------------------------------------------------------------
 /// @name Action Registry Internal Methods
 ///---------------------------------------------------------------------------------------
@@ -54,6 +59,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)registerDefaultActions;
 
+/**
+ * Adds a block that registers actions the first time the registry is read or modified.
+ * Used for module actions so their definitions are not loaded during takeOff.
+ * @param registration The registration block.
+ */
+- (void)addPendingRegistration:(void (^)(UAActionRegistry *))registration;
+
 @end
 
 NS_ASSUME_NONNULL_END
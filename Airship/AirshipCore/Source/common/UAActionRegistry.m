@@ -18,6 +18,7 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
     if (self) {
         self.registeredActionEntries = [[NSMutableDictionary alloc] init];
         self.reservedEntryNames = [NSMutableArray array];
+        self.pendingRegistrations = [NSMutableArray array];
     }
     return self;
 }
@@ -103,6 +104,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 - (BOOL)registerEntry:(UAActionRegistryEntry *)entry
                 names:(NSArray *)names {
 
+    [self runPendingRegistrations];
+
     if (!names.count) {
         UA_LERR(@"Unable to register action class. A name must be specified.");
         return NO;
@@ -145,6 +148,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (BOOL)removeName:(NSString *)name {
+    [self runPendingRegistrations];
+
     if (!name) {
         return YES;
     }
@@ -164,6 +169,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (BOOL)removeEntryWithName:(NSString *)name {
+    [self runPendingRegistrations];
+
     if (!name) {
         return YES;
     }
@@ -190,6 +197,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (BOOL)addName:(NSString *)name forEntryWithName:(NSString *)entryName {
+    [self runPendingRegistrations];
+
     if (!name) {
         UA_LERR(@"Unable to add a nil name for entry.");
         return NO;
@@ -218,6 +227,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (UAActionRegistryEntry *)registryEntryWithName:(NSString *)name {
+    [self runPendingRegistrations];
+
     if (!name) {
         return nil;
     }
@@ -226,6 +237,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (NSSet *)registeredEntries {
+    [self runPendingRegistrations];
+
     NSMutableDictionary *entries = [NSMutableDictionary dictionaryWithDictionary:self.registeredActionEntries];
     [entries removeObjectsForKeys:self.reservedEntryNames];
     return [NSSet setWithArray:[entries allValues]];
@@ -234,6 +247,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 - (BOOL)addSituationOverride:(UASituation)situation
             forEntryWithName:(NSString *)name
                       action:(UAAction *)action {
+    [self runPendingRegistrations];
+
     if (!name) {
         return NO;
     }
@@ -251,6 +266,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (BOOL)updatePredicate:(UAActionPredicate)predicate forEntryWithName:(NSString *)name {
+    [self runPendingRegistrations];
+
     if (!name) {
         return NO;
     }
@@ -266,6 +283,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (BOOL)updateAction:(UAAction *)action forEntryWithName:(NSString *)name {
+    [self runPendingRegistrations];
+
     if (!name || !action) {
         return NO;
     }
@@ -281,6 +300,8 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 }
 
 - (BOOL)updateActionClass:(Class)actionClass forEntryWithName:(NSString *)name {
+    [self runPendingRegistrations];
+
     if (!name || !actionClass) {
         return NO;
     }
@@ -343,6 +364,31 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
     }
 }
 
+- (void)addPendingRegistration:(void (^)(UAActionRegistry *))registration {
+    @synchronized (self) {
+        [self.pendingRegistrations addObject:registration];
+    }
+}
+
+/**
+ * Runs the pending registrations. The lock is held until they finish so a concurrent
+ * reader waits for the registrations instead of seeing a partially filled registry.
+ */
+- (void)runPendingRegistrations {
+    @synchronized (self) {
+        if (!self.pendingRegistrations.count) {
+            return;
+        }
+
+        NSArray<void (^)(UAActionRegistry *)> *registrations = [self.pendingRegistrations copy];
+        [self.pendingRegistrations removeAllObjects];
+
+        for (void (^registration)(UAActionRegistry *) in registrations) {
+            registration(self);
+        }
+    }
+}
+
 - (void)registerDefaultActions {
     NSString *path = [[UAirshipCoreResources bundle] pathForResource:@"UADefaultActions" ofType:@"plist"];
     if (path) {
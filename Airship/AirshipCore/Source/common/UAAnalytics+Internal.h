@@ -94,6 +94,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)cancelUpload;
 
+/**
+ * Adds a block to append headers that only change when `invalidateAnalyticsHeaders` is called.
+ * The block's headers are cached with the device, app and locale headers, so it is not called
+ * for every upload.
+ * @param headerBlock The header block.
+ */
+- (void)addStaticAnalyticsHeadersBlock:(UAAnalyticsHeadersBlock)headerBlock;
+
+/**
+ * Invalidates the cached analytics headers. They will be rebuilt for the next upload.
+ */
+- (void)invalidateAnalyticsHeaders;
+
 @end
 
 NS_ASSUME_NONNULL_END
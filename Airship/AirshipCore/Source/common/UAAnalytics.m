@@ -33,6 +33,11 @@
 @property (nonatomic, strong) NSMutableArray<NSString *> *SDKExtensions;
 @property (nonatomic, assign) BOOL isEnteringForeground;
 @property (nonatomic, strong) NSMutableArray<UAAnalyticsHeadersBlock> *headerBlocks;
+@property (nonatomic, strong) NSMutableArray<UAAnalyticsHeadersBlock> *staticHeaderBlocks;
+
+// Headers that only change on a signal, and the channel ID they were built with. Guarded by synchronizing on self.
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *cachedHeaders;
+@property (nonatomic, copy, nullable) NSString *cachedHeadersChannelID;
 
 // Screen tracking state
 @property (nonatomic, strong) NSString *currentScreen;
@@ -71,6 +76,7 @@ NSString *const UAEventKey = @"event";
         self.dispatcher = dispatcher;
         self.SDKExtensions = [NSMutableArray array];
         self.headerBlocks = [NSMutableArray array];
+        self.staticHeaderBlocks = [NSMutableArray array];
 
         // Default analytics value
         if (![self.dataStore objectForKey:kUAAnalyticsEnabled]) {
@@ -102,6 +108,16 @@ NSString *const UAEventKey = @"event";
                                         name:UAApplicationDidBecomeActiveNotification
                                       object:nil];
 
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(invalidateAnalyticsHeaders)
+                                        name:NSCurrentLocaleDidChangeNotification
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(invalidateAnalyticsHeaders)
+                                        name:NSSystemTimeZoneDidChangeNotification
+                                      object:nil];
+
         if (!self.isEnabled) {
             [self.eventManager deleteAllEvents];
         }
@@ -339,7 +355,10 @@ NSString *const UAEventKey = @"event";
 - (void)registerSDKExtension:(UASDKExtension)extension version:(NSString *)version {
     NSString *sanitizedVersion = [version stringByReplacingOccurrencesOfString:@"," withString:@""];
     NSString *name = [UAAnalytics nameForSDKExtension:extension];
-    [self.SDKExtensions addObject:[NSString stringWithFormat:@"%@:%@", name, sanitizedVersion]];
+    @synchronized (self) {
+        [self.SDKExtensions addObject:[NSString stringWithFormat:@"%@:%@", name, sanitizedVersion]];
+        self.cachedHeaders = nil;
+    }
 }
 
 + (NSString *)nameForSDKExtension:(UASDKExtension)extension {
@@ -358,6 +377,41 @@ NSString *const UAEventKey = @"event";
 }
 
 - (NSDictionary *)analyticsHeaders {
+    NSDictionary<NSString *, NSString *> *cachedHeaders;
+    NSArray<UAAnalyticsHeadersBlock> *headerBlocks;
+
+    @synchronized (self) {
+        NSString *channelID = self.channel.identifier;
+        if (!self.cachedHeaders || !(channelID == self.cachedHeadersChannelID || [channelID isEqualToString:self.cachedHeadersChannelID])) {
+            self.cachedHeaders = [self buildCachedHeadersWithChannelID:channelID];
+            self.cachedHeadersChannelID = channelID;
+        }
+
+        cachedHeaders = self.cachedHeaders;
+        headerBlocks = [self.headerBlocks copy];
+    }
+
+    // Back to back uploads share the cached headers unless a block adds to them
+    if (!headerBlocks.count) {
+        return cachedHeaders;
+    }
+
+    NSMutableDictionary *headers = [cachedHeaders mutableCopy];
+    for (UAAnalyticsHeadersBlock block in headerBlocks) {
+        NSDictionary<NSString *, NSString *> *result = block();
+        if (result) {
+            [headers addEntriesFromDictionary:result];
+        }
+    }
+
+    return headers;
+}
+
+/**
+ * Builds the headers that only change when the locale, time zone, channel ID, SDK extensions
+ * or static header blocks change. Must be called while synchronized on self.
+ */
+- (NSDictionary<NSString *, NSString *> *)buildCachedHeadersWithChannelID:(NSString *)channelID {
     NSMutableDictionary *headers = [NSMutableDictionary dictionary];
 
     // Device info
@@ -376,7 +430,7 @@ NSString *const UAEventKey = @"event";
     [headers setValue:[[NSLocale autoupdatingCurrentLocale] objectForKey:NSLocaleVariantCode] forKey:@"X-UA-Locale-Variant"];
 
     // Airship identifiers
-    [headers setValue:self.channel.identifier forKey:@"X-UA-Channel-ID"];
+    [headers setValue:channelID forKey:@"X-UA-Channel-ID"];
     [headers setValue:self.config.appKey forKey:@"X-UA-App-Key"];
 
     // SDK Version
@@ -387,8 +441,8 @@ NSString *const UAEventKey = @"event";
         [headers setValue:[self.SDKExtensions componentsJoinedByString:@", "] forKey:@"X-UA-Frameworks"];
     }
 
-    // Header extenders
-    for (UAAnalyticsHeadersBlock block in self.headerBlocks) {
+    // Static header extenders
+    for (UAAnalyticsHeadersBlock block in self.staticHeaderBlocks) {
         NSDictionary<NSString *, NSString *> *result = block();
         if (result) {
             [headers addEntriesFromDictionary:result];
@@ -399,7 +453,22 @@ NSString *const UAEventKey = @"event";
 }
 
 - (void)addAnalyticsHeadersBlock:(nonnull UAAnalyticsHeadersBlock)headersBlock {
-    [self.headerBlocks addObject:headersBlock];
+    @synchronized (self) {
+        [self.headerBlocks addObject:headersBlock];
+    }
+}
+
+- (void)addStaticAnalyticsHeadersBlock:(nonnull UAAnalyticsHeadersBlock)headersBlock {
+    @synchronized (self) {
+        [self.staticHeaderBlocks addObject:headersBlock];
+        self.cachedHeaders = nil;
+    }
+}
+
+- (void)invalidateAnalyticsHeaders {
+    @synchronized (self) {
+        self.cachedHeaders = nil;
+    }
 }
 
 @end
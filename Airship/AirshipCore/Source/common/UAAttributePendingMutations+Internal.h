@@ -37,6 +37,13 @@ extern NSString *const UAAttributeRemoveActionKey;
 */
 + (instancetype)pendingMutationsWithMutations:(UAAttributeMutations *)mutations date:(UADate *)date;
 
+/**
+ Generates a mutations object from already timestamped mutation payloads.
+ @param mutationsPayload The timestamped mutation payloads.
+ @return A mutation.
+*/
++ (instancetype)pendingMutationsWithMutationsPayload:(NSArray<NSDictionary *> *)mutationsPayload;
+
 /**
  The collection of all current mutations comprising a mutations object.
 */
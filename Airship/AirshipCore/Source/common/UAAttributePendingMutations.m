@@ -32,6 +32,10 @@ NSString *const UAAttributeRemoveActionKey = @"remove";
     return [[UAAttributePendingMutations alloc] initWithMutations:mutations date:date];
 }
 
++ (instancetype)pendingMutationsWithMutationsPayload:(NSArray<NSDictionary *> *)mutationsPayload {
+    return [[UAAttributePendingMutations alloc] initWithPendingMutationsPayload:mutationsPayload];
+}
+
 - (instancetype)initWithMutations:(UAAttributeMutations *)mutations date:(UADate *)date {
     self = [super init];
 
@@ -119,20 +123,19 @@ NSString *const UAAttributeRemoveActionKey = @"remove";
 
 + (NSArray<NSDictionary *> *)collapseMutationsArray:(NSArray<NSDictionary *> *)mutations {
     NSMutableArray *result = [NSMutableArray array];
+    NSMutableSet<NSString *> *attributeNames = [NSMutableSet set];
 
     for (id mutation in [mutations reverseObjectEnumerator]) {
         NSString *attributeName = mutation[UAAttributeNameKey];
-        NSPredicate *keyPredicate = [NSPredicate predicateWithFormat:@"key == %@", attributeName];
-
-        NSArray *filtered = [result filteredArrayUsingPredicate:keyPredicate];
 
         // Only add latest instance of any key operation
-        if (filtered.count == 0) {
-            [result insertObject:mutation atIndex:0];
+        if (![attributeNames containsObject:attributeName]) {
+            [attributeNames addObject:attributeName];
+            [result addObject:mutation];
         }
     }
 
-    return [result copy];
+    return [[result reverseObjectEnumerator] allObjects];
 }
 
 - (nullable NSDictionary *)payload {
@@ -19,6 +19,27 @@ NSString *const PersistentQueueKey = @"com.urbanairship.channel_attributes.regis
 @property(nonatomic, strong) NSOperationQueue *operationQueue;
 @property(nonatomic, strong) UIApplication *application;
 @property(nonatomic, strong) UADate *date;
+
+/**
+ The latest queued mutation payload for each attribute, collapsed as mutations are saved.
+ Does not include the uploading mutations.
+ */
+@property(nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *collapsedMutationsPayload;
+
+/**
+ The attribute names of the collapsed mutation payloads, in upload order.
+ */
+@property(nonatomic, strong) NSMutableOrderedSet<NSString *> *collapsedAttributeNames;
+
+/**
+ The collapsed mutations at the top of the queue that are being uploaded, if any.
+ */
+@property(nonatomic, strong, nullable) UAAttributePendingMutations *uploadingMutations;
+
+/**
+ A flag indicating if the queued mutations have been collapsed.
+ */
+@property(nonatomic, assign) BOOL queuedMutationsLoaded;
 @end
 
 @implementation UAAttributeRegistrar
@@ -58,6 +79,8 @@ NSString *const PersistentQueueKey = @"com.urbanairship.channel_attributes.regis
         self.client.enabled = self.componentEnabled;
         self.date = date;
         self.pendingAttributeMutationsQueue = [UAPersistentQueue persistentQueueWithDataStore:dataStore key:PersistentQueueKey];
+        self.collapsedMutationsPayload = [NSMutableDictionary dictionary];
+        self.collapsedAttributeNames = [NSMutableOrderedSet orderedSet];
         self.operationQueue = operationQueue;
         self.operationQueue.maxConcurrentOperationCount = 1;
     }
@@ -75,20 +98,96 @@ NSString *const PersistentQueueKey = @"com.urbanairship.channel_attributes.regis
         return;
     }
 
-    [self.pendingAttributeMutationsQueue addObject:mutations];
-}
+    @synchronized (self) {
+        [self loadQueuedMutations];
 
-- (void)collapseQueuedPendingMutations {
-    UAPersistentQueue *queue = self.pendingAttributeMutationsQueue;
-    NSArray<UAAttributePendingMutations *> *mutationsToCollapse = [[queue objects] mutableCopy];
+        // Only the new mutations are appended, the queue is compacted before the next upload
+        [self.pendingAttributeMutationsQueue addObject:mutations];
+        [self collapseMutations:mutations];
+    }
+}
 
-    if (mutationsToCollapse.count == 0) {
-        // Nothing in the queue to collapse
+/**
+ Collapses the mutations in the queue the first time. Must be called while synchronized on self.
+ */
+- (void)loadQueuedMutations {
+    if (self.queuedMutationsLoaded) {
         return;
     }
 
-    UAAttributePendingMutations *mutations = [UAAttributePendingMutations collapseMutations:mutationsToCollapse];
-    [queue setObjects:@[mutations]];
+    for (UAAttributePendingMutations *mutations in [self.pendingAttributeMutationsQueue objects]) {
+        [self collapseMutations:mutations];
+    }
+
+    self.queuedMutationsLoaded = YES;
+}
+
+/**
+ Collapses mutations into the collapsed mutation payloads. Must be called while synchronized on self.
+ @param mutations The mutations.
+ */
+- (void)collapseMutations:(UAAttributePendingMutations *)mutations {
+    for (NSDictionary *mutationPayload in mutations.mutationsPayload) {
+        NSString *attributeName = mutationPayload[UAAttributeNameKey];
+
+        // Only keep the latest mutation of each attribute, ordered by when it was made
+        [self.collapsedAttributeNames removeObject:attributeName];
+        [self.collapsedAttributeNames addObject:attributeName];
+        self.collapsedMutationsPayload[attributeName] = mutationPayload;
+    }
+}
+
+/**
+ Returns the mutations to upload next. Any collapsed mutations are combined with mutations that
+ failed to upload, and the queue is compacted to a single entry holding the result.
+ @return The mutations to upload, or nil if there are no pending mutations.
+ */
+- (nullable UAAttributePendingMutations *)nextUploadingMutations {
+    @synchronized (self) {
+        [self loadQueuedMutations];
+
+        if (!self.collapsedAttributeNames.count) {
+            return self.uploadingMutations;
+        }
+
+        NSMutableArray<NSDictionary *> *mutationsPayload = [NSMutableArray arrayWithCapacity:self.collapsedAttributeNames.count];
+        for (NSString *attributeName in self.collapsedAttributeNames) {
+            [mutationsPayload addObject:self.collapsedMutationsPayload[attributeName]];
+        }
+
+        UAAttributePendingMutations *mutations = [UAAttributePendingMutations pendingMutationsWithMutationsPayload:mutationsPayload];
+        if (self.uploadingMutations) {
+            mutations = [UAAttributePendingMutations collapseMutations:@[self.uploadingMutations, mutations]];
+        }
+
+        [self.pendingAttributeMutationsQueue setObjects:@[mutations]];
+        [self.collapsedAttributeNames removeAllObjects];
+        [self.collapsedMutationsPayload removeAllObjects];
+
+        self.uploadingMutations = mutations;
+        return mutations;
+    }
+}
+
+/**
+ Removes the uploading mutations from the queue. Mutations saved during the upload are kept.
+ */
+- (void)removeUploadingMutations {
+    @synchronized (self) {
+        [self.pendingAttributeMutationsQueue popObject];
+        self.uploadingMutations = nil;
+    }
+}
+
+/**
+ Checks if there are mutations that have not been uploaded.
+ @return YES if there are pending mutations, otherwise NO.
+ */
+- (BOOL)hasPendingMutations {
+    @synchronized (self) {
+        [self loadQueuedMutations];
+        return self.uploadingMutations || self.collapsedAttributeNames.count;
+    }
 }
 
 - (void)updateAttributesForChannel:(NSString *)identifier {
@@ -113,23 +212,21 @@ NSString *const PersistentQueueKey = @"com.urbanairship.channel_attributes.regis
             return;
         }
 
-        // Collapse queued pending mutations
-        [self collapseQueuedPendingMutations];
+        // Pending mutations are collapsed as they are saved
+        UAAttributePendingMutations *nextPendingMutation = [self nextUploadingMutations];
 
-        if (self.pendingAttributeMutationsQueue.objects.count == 0) {
+        if (!nextPendingMutation) {
             [self endBackgroundTask:backgroundTaskIdentifier];
             [operation finish];
             return;
         }
 
-        UAAttributePendingMutations *nextPendingMutation = (UAAttributePendingMutations *)[self.pendingAttributeMutationsQueue peekObject];
-
         [self.client updateChannel:identifier withAttributePayload:nextPendingMutation.payload onSuccess:^{
             // Success - pop uploaded mutation
-            [self.pendingAttributeMutationsQueue popObject];
+            [self removeUploadingMutations];
 
             // Continue updating attributes for channel if operation has not been canceled and there are remaining mutations to upload
-            if (!operation.isCancelled && self.pendingAttributeMutationsQueue.objects.count > 0) {
+            if (!operation.isCancelled && [self hasPendingMutations]) {
                 [self updateAttributesForChannel:identifier];
             }
 
@@ -140,7 +237,7 @@ NSString *const PersistentQueueKey = @"com.urbanairship.channel_attributes.regis
 
             if (statusCode == 400 || statusCode == 403) {
                 // Unrecoverable failure - pop mutation and end the background task
-                [self.pendingAttributeMutationsQueue popObject];
+                [self removeUploadingMutations];
                 [self endBackgroundTask:backgroundTaskIdentifier];
             }
 
@@ -33,6 +33,31 @@ NSString *const UALastSuccessfulPayloadKey = @"payload-key";
  */
 @property (nonatomic, strong, nullable) UAChannelRegistrationPayload *lastSuccessfulPayload;
 
+/**
+ * In-memory copy of the last successful payload, loaded from the data store once.
+ */
+@property (nonatomic, strong, nullable) UAChannelRegistrationPayload *cachedLastSuccessfulPayload;
+
+/**
+ * Content digest of the last successful payload.
+ */
+@property (nonatomic, copy, nullable) NSData *lastSuccessfulPayloadDigest;
+
+/**
+ * A flag indicating if the last successful payload has been loaded from the data store.
+ */
+@property (nonatomic, assign) BOOL lastSuccessfulPayloadLoaded;
+
+/**
+ * The payload last compared against the last successful payload.
+ */
+@property (nonatomic, strong, nullable) UAChannelRegistrationPayload *diffedPayload;
+
+/**
+ * The fields of the diffed payload that changed from the last successful payload.
+ */
+@property (nonatomic, copy, nullable) NSSet<NSString *> *diffedPayloadChangedFields;
+
 /**
  * The date of the last successful update.
  */
@@ -186,12 +211,18 @@ UARuntimeConfig *config;
 - (BOOL)shouldUpdateRegistration:(UAChannelRegistrationPayload *)payload {
     NSTimeInterval timeSinceLastUpdate = [[self.date now] timeIntervalSinceDate:self.lastSuccessfulUpdateDate];
 
-    if (self.lastSuccessfulPayload == nil) {
+    UAChannelRegistrationPayload *lastPayload = self.lastSuccessfulPayload;
+    if (lastPayload == nil) {
         UA_LTRACE(@"Should update registration. Last payload is nil.");
         return true;
     }
 
-    if (![payload isEqualToPayload:self.lastSuccessfulPayload]) {
+    // Keep the field diff around for the update payload
+    self.diffedPayload = payload;
+    if ([[payload contentDigest] isEqualToData:self.lastSuccessfulPayloadDigest]) {
+        self.diffedPayloadChangedFields = [NSSet set];
+    } else {
+        self.diffedPayloadChangedFields = [payload changedFieldsFromPayload:lastPayload];
         UA_LTRACE(@"Should update registration. Channel registration payload has changed.");
         return true;
     }
@@ -229,7 +260,12 @@ UARuntimeConfig *config;
 - (void)updateChannelWithPayload:(UAChannelRegistrationPayload *)payload {
     UA_WEAKIFY(self);
 
-    UAChannelRegistrationPayload *minPayload = [payload minimalUpdatePayloadWithLastPayload:self.lastSuccessfulPayload];
+    UAChannelRegistrationPayload *minPayload;
+    if (payload == self.diffedPayload && self.lastSuccessfulPayload) {
+        minPayload = [payload minimalUpdatePayloadWithChangedFields:self.diffedPayloadChangedFields];
+    } else {
+        minPayload = [payload minimalUpdatePayloadWithLastPayload:self.lastSuccessfulPayload];
+    }
 
     UAChannelAPIClientUpdateSuccessBlock updateChannelSuccessBlock = ^{
         UA_STRONGIFY(self);
@@ -341,19 +377,36 @@ UARuntimeConfig *config;
 }
 
 - (UAChannelRegistrationPayload *)lastSuccessfulPayload {
-    NSData *payloadData = [self.dataStore objectForKey:UALastSuccessfulPayloadKey];
+    if (!self.lastSuccessfulPayloadLoaded) {
+        NSData *payloadData = [self.dataStore objectForKey:UALastSuccessfulPayloadKey];
 
-    if (payloadData == nil || ![payloadData isKindOfClass:[NSData class]]) {
-        return nil;
+        if ([payloadData isKindOfClass:[NSData class]]) {
+            [self cacheLastSuccessfulPayload:[UAChannelRegistrationPayload channelRegistrationPayloadWithData:payloadData]];
+        } else {
+            [self cacheLastSuccessfulPayload:nil];
+        }
     }
 
-    return [UAChannelRegistrationPayload channelRegistrationPayloadWithData:payloadData];
+    return self.cachedLastSuccessfulPayload;
 }
 
 - (void)setLastSuccessfulPayload:(UAChannelRegistrationPayload *)payload {
+    // Copy so later changes to the registered payload do not leak into the cache
+    payload = [payload copy];
+    [self cacheLastSuccessfulPayload:payload];
     [self.dataStore setObject:payload.asJSONData forKey:UALastSuccessfulPayloadKey];
 }
 
+- (void)cacheLastSuccessfulPayload:(nullable UAChannelRegistrationPayload *)payload {
+    self.cachedLastSuccessfulPayload = payload;
+    self.lastSuccessfulPayloadDigest = [payload contentDigest];
+    self.lastSuccessfulPayloadLoaded = YES;
+
+    // Any cached diff was against the previous payload
+    self.diffedPayload = nil;
+    self.diffedPayloadChangedFields = nil;
+}
+
 - (NSDate *)lastSuccessfulUpdateDate {
     return [self.dataStore objectForKey:UALastSuccessfulUpdateKey] ?: [NSDate distantPast];
 }
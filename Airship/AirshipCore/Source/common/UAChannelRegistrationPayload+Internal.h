@@ -75,6 +75,30 @@ extern NSString *const UABackgroundEnabledJSONKey;
  */
 - (UAChannelRegistrationPayload *)minimalUpdatePayloadWithLastPayload:(nullable UAChannelRegistrationPayload *)lastPayload;
 
+/**
+ * A SHA-256 digest of the payload contents. The digest is computed from the payload serialized
+ * with sorted keys, so payloads with equal contents always have equal digests.
+ * @return The content digest.
+ */
+- (NSData *)contentDigest;
+
+/**
+ * The optional fields of the payload that differ from another payload. Fields are identified by
+ * their channel JSON keys.
+ * @param payload The payload to compare with.
+ * @return The JSON keys of the changed optional fields.
+ */
+- (NSSet<NSString *> *)changedFieldsFromPayload:(UAChannelRegistrationPayload *)payload;
+
+/**
+ * Creates a new payload for an update that only contains the required data and the given
+ * optional fields.
+ * @param changedFields The JSON keys of the optional fields to include, as returned
+ * by `changedFieldsFromPayload:`.
+ * @return The minimal update payload.
+ */
+- (UAChannelRegistrationPayload *)minimalUpdatePayloadWithChangedFields:(NSSet<NSString *> *)changedFields;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -4,6 +4,8 @@
 #import "UAJSONSerialization.h"
 #import "UAGlobal.h"
 
+#import <CommonCrypto/CommonDigest.h>
+
 NSString *const UAChannelIOSPlatform= @"ios";
 
 NSString *const UAChannelIdentityHintsKey = @"identity_hints";
@@ -199,63 +201,87 @@ NSString *const UABackgroundEnabledJSONKey = @"background";
     return [[self payloadDictionary] description];
 }
 
-- (UAChannelRegistrationPayload *)minimalUpdatePayloadWithLastPayload:(UAChannelRegistrationPayload *)lastPayload {
-    UAChannelRegistrationPayload *minPayload = [self copy];
+/**
+ * The optional fields that are left out of an update when unchanged, mapped
+ * from their JSON keys to their property names.
+ */
++ (NSDictionary<NSString *, NSString *> *)optionalFieldProperties {
+    static NSDictionary *properties;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        properties = @{ UAChannelTopLevelCountryJSONKey: @"country",
+                        UAChannelTopLevelLanguageJSONKey: @"language",
+                        UAChannelTopLevelTimeZoneJSONKey: @"timeZone",
+                        UAChannelTopLevelLocationSettingsJSONKey: @"locationSettings",
+                        UAChannelTopLevelAppVersionJSONKey: @"appVersion",
+                        UAChannelTopLevelSDKVersionJSONKey: @"SDKVersion",
+                        UAChannelTopLevelDeviceModelJSONKey: @"deviceModel",
+                        UAChannelTopLevelDeviceOSJSONKey: @"deviceOS",
+                        UAChannelTopLevelCarrierJSONKey: @"carrier" };
+    });
+
+    return properties;
+}
 
-    if (!lastPayload) {
-        return minPayload;
-    }
+- (NSData *)contentDigest {
+    NSData *data = [UAJSONSerialization dataWithJSONObject:[self payloadDictionary]
+                                                   options:NSJSONWritingSortedKeys
+                                                     error:nil];
 
-    // Strip out tags if they have not changed
-    if (lastPayload.setTags && self.setTags) {
-        if ([lastPayload.tags isEqualToArray:self.tags]) {
-            minPayload.setTags = NO;
-            minPayload.tags = nil;
-        }
-    }
+    NSMutableData *digest = [NSMutableData dataWithLength:CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest.mutableBytes);
+    return digest;
+}
 
-    // Strip identity hints
-    minPayload.userID = nil;
-    minPayload.deviceID = nil;
+- (NSSet<NSString *> *)changedFieldsFromPayload:(UAChannelRegistrationPayload *)payload {
+    NSMutableSet *changedFields = [NSMutableSet set];
 
-    // Optional attributes
-    if ([self.country isEqual:lastPayload.country]) {
-        minPayload.country = nil;
+    // Tags are only unchanged if both payloads set the same tags
+    if (!(payload.setTags && self.setTags && [payload.tags isEqualToArray:self.tags])) {
+        [changedFields addObject:UAChannelTagsJSONKey];
     }
 
-    if ([self.language isEqual:lastPayload.language]) {
-        minPayload.language = nil;
+    NSDictionary *properties = [UAChannelRegistrationPayload optionalFieldProperties];
+    for (NSString *key in properties) {
+        id value = [self valueForKey:properties[key]];
+        if (![value isEqual:[payload valueForKey:properties[key]]]) {
+            [changedFields addObject:key];
+        }
     }
 
-    if ([self.timeZone isEqual:lastPayload.timeZone]) {
-        minPayload.timeZone = nil;
-    }
+    return changedFields;
+}
 
-    if ([self.locationSettings isEqual:lastPayload.locationSettings]) {
-        minPayload.locationSettings = nil;
-    }
+- (UAChannelRegistrationPayload *)minimalUpdatePayloadWithChangedFields:(NSSet<NSString *> *)changedFields {
+    UAChannelRegistrationPayload *minPayload = [self copy];
 
-    if ([self.appVersion isEqual:lastPayload.appVersion]) {
-        minPayload.appVersion = nil;
+    // Strip out tags if they have not changed
+    if (![changedFields containsObject:UAChannelTagsJSONKey]) {
+        minPayload.setTags = NO;
+        minPayload.tags = nil;
     }
 
-    if ([self.SDKVersion isEqual:lastPayload.SDKVersion]) {
-        minPayload.SDKVersion = nil;
-    }
+    // Strip identity hints
+    minPayload.userID = nil;
+    minPayload.deviceID = nil;
 
-    if ([self.deviceModel isEqual:lastPayload.deviceModel]) {
-        minPayload.deviceModel = nil;
+    // Optional attributes
+    NSDictionary *properties = [UAChannelRegistrationPayload optionalFieldProperties];
+    for (NSString *key in properties) {
+        if (![changedFields containsObject:key]) {
+            [minPayload setValue:nil forKey:properties[key]];
+        }
     }
 
-    if ([self.deviceOS isEqual:lastPayload.deviceOS]) {
-        minPayload.deviceOS = nil;
-    }
+    return minPayload;
+}
 
-    if ([self.carrier isEqual:lastPayload.carrier]) {
-        minPayload.carrier = nil;
+- (UAChannelRegistrationPayload *)minimalUpdatePayloadWithLastPayload:(UAChannelRegistrationPayload *)lastPayload {
+    if (!lastPayload) {
+        return [self copy];
     }
 
-    return minPayload;
+    return [self minimalUpdatePayloadWithChangedFields:[self changedFieldsFromPayload:lastPayload]];
 }
 
 @end
@@ -0,0 +1,64 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UAJSONPredicate.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A UAJSONPredicate compiled into a flat instruction array.
+ *
+ * And, or, and not nodes become conditional jumps over a single result register, and
+ * each JSON matcher is resolved once into its key path and the value checks it needs.
+ * Evaluation is a loop over the instructions with no type string comparisons or
+ * per-node allocations, and gives the same results as evaluating the source predicate.
+ *
+ * Compiled predicates are immutable and safe to evaluate from any thread.
+ */
+@interface UACompiledJSONPredicate : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Compiled JSON Predicate Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The source predicate.
+ */
+@property(nonatomic, readonly) UAJSONPredicate *predicate;
+
+///---------------------------------------------------------------------------------------
+/// @name Compiled JSON Predicate Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * Compiles a predicate.
+ *
+ * @param predicate The predicate.
+ * @return The compiled predicate.
+ */
++ (instancetype)compiledPredicateWithPredicate:(UAJSONPredicate *)predicate;
+
+/**
+ * Parses and compiles a predicate from JSON.
+ *
+ * @param json The predicate JSON.
+ * @param error The error if the JSON is not a valid predicate.
+ * @return The compiled predicate, or nil if the JSON is invalid.
+ */
++ (nullable instancetype)compiledPredicateWithJSON:(id)json error:(NSError * _Nullable *)error;
+
+///---------------------------------------------------------------------------------------
+/// @name Compiled JSON Predicate Evaluation
+///---------------------------------------------------------------------------------------
+
+/**
+ * Evaluates the object with the predicate.
+ *
+ * @param object The object to evaluate.
+ * @return `YES` if the predicate matches the object, otherwise `NO`.
+ */
+- (BOOL)evaluateObject:(nullable id)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
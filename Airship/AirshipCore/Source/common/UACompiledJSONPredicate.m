@@ -0,0 +1,420 @@
+/* Copyright Airship and Contributors */
+
+#import "UACompiledJSONPredicate.h"
+#import "UAVersionMatcher.h"
+
+// Payload keys, defined with the predicate and matchers
+extern NSString *const UAJSONPredicateAndType;
+extern NSString *const UAJSONPredicateOrType;
+extern NSString *const UAJSONPredicateNotType;
+extern NSString *const UAJSONMatcherKey;
+extern NSString *const UAJSONMatcherScope;
+extern NSString *const UAJSONMatcherValue;
+extern NSString *const UAJSONMatcherIgnoreCase;
+extern NSString *const UAJSONValueMatcherAtMost;
+extern NSString *const UAJSONValueMatcherAtLeast;
+extern NSString *const UAJSONValueMatcherEquals;
+extern NSString *const UAJSONValueMatcherIsPresent;
+extern NSString *const UAJSONValueMatcherVersionConstraint;
+extern NSString *const UAJSONValueMatcherArrayContains;
+extern NSString *const UAJSONValueMatcherArrayIndex;
+
+typedef NS_ENUM(uint8_t, UACompiledJSONPredicateOpcode) {
+    // result = matchers[operand](object)
+    UACompiledJSONPredicateOpcodeMatch,
+    // if (!result) jump to operand
+    UACompiledJSONPredicateOpcodeJumpIfFalse,
+    // if (result) jump to operand
+    UACompiledJSONPredicateOpcodeJumpIfTrue,
+    // result = !result
+    UACompiledJSONPredicateOpcodeNot,
+    // result = operand
+    UACompiledJSONPredicateOpcodeSet
+};
+
+typedef struct {
+    UACompiledJSONPredicateOpcode opcode;
+    uint32_t operand;
+} UACompiledJSONPredicateInstruction;
+
+typedef NS_OPTIONS(uint8_t, UACompiledJSONMatcherCheck) {
+    UACompiledJSONMatcherCheckIsPresent = 1 << 0,
+    UACompiledJSONMatcherCheckEquals = 1 << 1,
+    UACompiledJSONMatcherCheckAtLeast = 1 << 2,
+    UACompiledJSONMatcherCheckAtMost = 1 << 3,
+    UACompiledJSONMatcherCheckVersion = 1 << 4,
+    UACompiledJSONMatcherCheckArrayContains = 1 << 5,
+    UACompiledJSONMatcherCheckArrayIndex = 1 << 6
+};
+
+/**
+ * A JSON matcher and its value matcher, resolved into the checks it performs.
+ */
+@interface UACompiledJSONMatcher : NSObject {
+@public
+    NSArray<NSString *> *_path;
+    UACompiledJSONMatcherCheck _checks;
+    BOOL _ignoreCase;
+    BOOL _isPresent;
+    id _equals;
+    NSNumber *_atLeast;
+    NSNumber *_atMost;
+    UAVersionMatcher *_versionMatcher;
+    UACompiledJSONPredicate *_arrayPredicate;
+    NSInteger _arrayIndex;
+}
+@end
+
+@implementation UACompiledJSONMatcher
+@end
+
+@interface UACompiledJSONPredicate () {
+    UACompiledJSONPredicateInstruction *_instructions;
+    NSUInteger _instructionCount;
+    __unsafe_unretained UACompiledJSONMatcher **_matcherTable;
+}
+
+@property(nonatomic, strong) UAJSONPredicate *predicate;
+
+// Retains the matchers referenced by the matcher table
+@property(nonatomic, copy) NSArray<UACompiledJSONMatcher *> *matchers;
+
+@end
+
+/**
+ * Walks a matcher's key path and applies its value checks. Mirrors UAJSONMatcher and
+ * UAJSONValueMatcher evaluation.
+ */
+static BOOL UACompiledJSONMatcherEvaluate(UACompiledJSONMatcher *matcher, id object);
+
+/**
+ * Compares two values, optionally ignoring string case. Mirrors UAJSONValueMatcher.
+ */
+static BOOL UACompiledJSONValuesEqual(id valueOne, id valueTwo, BOOL ignoreCase);
+
+@implementation UACompiledJSONPredicate
+
+- (instancetype)initWithPredicate:(UAJSONPredicate *)predicate {
+    self = [super init];
+
+    if (self) {
+        self.predicate = predicate;
+
+        NSMutableData *instructions = [NSMutableData data];
+        NSMutableArray<UACompiledJSONMatcher *> *matchers = [NSMutableArray array];
+        NSMutableDictionary<NSString *, NSString *> *keys = [NSMutableDictionary dictionary];
+
+        [UACompiledJSONPredicate compilePredicatePayload:predicate.payload
+                                            instructions:instructions
+                                                matchers:matchers
+                                                    keys:keys];
+
+        _instructionCount = instructions.length / sizeof(UACompiledJSONPredicateInstruction);
+        _instructions = malloc(MAX(instructions.length, 1));
+        memcpy(_instructions, instructions.bytes, instructions.length);
+
+        self.matchers = matchers;
+        _matcherTable = (__unsafe_unretained UACompiledJSONMatcher **)calloc(MAX(matchers.count, 1), sizeof(id));
+        for (NSUInteger i = 0; i < self.matchers.count; i++) {
+            _matcherTable[i] = self.matchers[i];
+        }
+    }
+
+    return self;
+}
+
++ (instancetype)compiledPredicateWithPredicate:(UAJSONPredicate *)predicate {
+    return [[self alloc] initWithPredicate:predicate];
+}
+
++ (nullable instancetype)compiledPredicateWithJSON:(id)json error:(NSError **)error {
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:json error:error];
+    if (!predicate) {
+        return nil;
+    }
+
+    return [self compiledPredicateWithPredicate:predicate];
+}
+
+- (void)dealloc {
+    free(_instructions);
+    free(_matcherTable);
+}
+
+#pragma mark -
+#pragma mark Evaluation
+
+- (BOOL)evaluateObject:(id)object {
+    const UACompiledJSONPredicateInstruction *instructions = _instructions;
+    NSUInteger count = _instructionCount;
+    BOOL result = NO;
+
+    NSUInteger pc = 0;
+    while (pc < count) {
+        UACompiledJSONPredicateInstruction instruction = instructions[pc];
+        switch (instruction.opcode) {
+            case UACompiledJSONPredicateOpcodeMatch:
+                result = UACompiledJSONMatcherEvaluate(_matcherTable[instruction.operand], object);
+                pc++;
+                break;
+            case UACompiledJSONPredicateOpcodeJumpIfFalse:
+                pc = result ? pc + 1 : instruction.operand;
+                break;
+            case UACompiledJSONPredicateOpcodeJumpIfTrue:
+                pc = result ? instruction.operand : pc + 1;
+                break;
+            case UACompiledJSONPredicateOpcodeNot:
+                result = !result;
+                pc++;
+                break;
+            case UACompiledJSONPredicateOpcodeSet:
+                result = instruction.operand != 0;
+                pc++;
+                break;
+        }
+    }
+
+    return result;
+}
+
+static BOOL UACompiledJSONMatcherEvaluate(UACompiledJSONMatcher *matcher, id object) {
+    NSArray<NSString *> *path = matcher->_path;
+    for (NSUInteger i = 0; i < path.count; i++) {
+        if (![object isKindOfClass:[NSDictionary class]]) {
+            object = nil;
+            break;
+        }
+
+        object = [(NSDictionary *)object objectForKey:path[i]];
+    }
+
+    UACompiledJSONMatcherCheck checks = matcher->_checks;
+
+    if (checks & UACompiledJSONMatcherCheckIsPresent) {
+        return matcher->_isPresent == (object != nil);
+    }
+
+    if ((checks & UACompiledJSONMatcherCheckEquals) && !UACompiledJSONValuesEqual(matcher->_equals, object, matcher->_ignoreCase)) {
+        return NO;
+    }
+
+    if (checks & (UACompiledJSONMatcherCheckAtLeast | UACompiledJSONMatcherCheckAtMost)) {
+        if (![object isKindOfClass:[NSNumber class]]) {
+            return NO;
+        }
+
+        if ((checks & UACompiledJSONMatcherCheckAtLeast) && [matcher->_atLeast compare:object] == NSOrderedDescending) {
+            return NO;
+        }
+
+        if ((checks & UACompiledJSONMatcherCheckAtMost) && [matcher->_atMost compare:object] == NSOrderedAscending) {
+            return NO;
+        }
+    }
+
+    if (checks & UACompiledJSONMatcherCheckVersion) {
+        if (![object isKindOfClass:[NSString class]] || ![matcher->_versionMatcher evaluateObject:object]) {
+            return NO;
+        }
+    }
+
+    if (checks & UACompiledJSONMatcherCheckArrayContains) {
+        if (![object isKindOfClass:[NSArray class]]) {
+            return NO;
+        }
+
+        NSArray *array = object;
+
+        if (checks & UACompiledJSONMatcherCheckArrayIndex) {
+            NSInteger index = matcher->_arrayIndex;
+            if (index < 0 || index >= (NSInteger)array.count) {
+                return NO;
+            }
+            return [matcher->_arrayPredicate evaluateObject:array[(NSUInteger)index]];
+        }
+
+        for (id value in array) {
+            if ([matcher->_arrayPredicate evaluateObject:value]) {
+                return YES;
+            }
+        }
+        return NO;
+    }
+
+    return YES;
+}
+
+static BOOL UACompiledJSONValuesEqual(id valueOne, id valueTwo, BOOL ignoreCase) {
+    if (valueOne == valueTwo) {
+        return YES;
+    }
+
+    if (!ignoreCase) {
+        return [valueOne isEqual:valueTwo];
+    }
+
+    if ([valueOne isKindOfClass:[NSString class]]) {
+        if (![valueTwo isKindOfClass:[NSString class]]) {
+            return NO;
+        }
+
+        return [valueOne caseInsensitiveCompare:valueTwo] == NSOrderedSame;
+    }
+
+    if ([valueOne isKindOfClass:[NSArray class]]) {
+        if (![valueTwo isKindOfClass:[NSArray class]] || [valueTwo count] != [valueOne count]) {
+            return NO;
+        }
+
+        for (NSUInteger i = 0; i < [valueOne count]; i++) {
+            if (!UACompiledJSONValuesEqual(valueOne[i], valueTwo[i], ignoreCase)) {
+                return NO;
+            }
+        }
+
+        return YES;
+    }
+
+    if ([valueOne isKindOfClass:[NSDictionary class]]) {
+        if (![valueTwo isKindOfClass:[NSDictionary class]] || [valueTwo count] != [valueOne count]) {
+            return NO;
+        }
+
+        for (NSString *key in valueOne) {
+            if (!UACompiledJSONValuesEqual(valueOne[key], valueTwo[key], ignoreCase)) {
+                return NO;
+            }
+        }
+
+        return YES;
+    }
+
+    return [valueOne isEqual:valueTwo];
+}
+
+#pragma mark -
+#pragma mark Compilation
+
+/**
+ * Appends the instructions for a predicate payload. The instructions leave the
+ * predicate's result in the result register.
+ *
+ * And/or nodes jump to the end of the node on the first child that decides the result,
+ * carrying that child's result. Not nodes invert the result of their single child.
+ */
++ (void)compilePredicatePayload:(NSDictionary *)payload
+                   instructions:(NSMutableData *)instructions
+                       matchers:(NSMutableArray<UACompiledJSONMatcher *> *)matchers
+                           keys:(NSMutableDictionary<NSString *, NSString *> *)keys {
+
+    NSArray *subpredicates;
+    UACompiledJSONPredicateOpcode jump;
+    if ((subpredicates = payload[UAJSONPredicateAndType])) {
+        jump = UACompiledJSONPredicateOpcodeJumpIfFalse;
+    } else if ((subpredicates = payload[UAJSONPredicateOrType])) {
+        jump = UACompiledJSONPredicateOpcodeJumpIfTrue;
+    } else if ((subpredicates = payload[UAJSONPredicateNotType])) {
+        [self compilePredicatePayload:subpredicates.firstObject instructions:instructions matchers:matchers keys:keys];
+        [self appendOpcode:UACompiledJSONPredicateOpcodeNot operand:0 instructions:instructions];
+        return;
+    } else {
+        UACompiledJSONMatcher *matcher = [self compileMatcherPayload:payload keys:keys];
+        [self appendOpcode:UACompiledJSONPredicateOpcodeMatch operand:(uint32_t)matchers.count instructions:instructions];
+        [matchers addObject:matcher];
+        return;
+    }
+
+    // Matches the tree's result for an empty node: and is YES, or is NO
+    if (!subpredicates.count) {
+        uint32_t result = jump == UACompiledJSONPredicateOpcodeJumpIfFalse ? 1 : 0;
+        [self appendOpcode:UACompiledJSONPredicateOpcodeSet operand:result instructions:instructions];
+        return;
+    }
+
+    // Jumps are patched to the end of the node once its length is known
+    NSMutableArray<NSNumber *> *jumps = [NSMutableArray array];
+    for (NSUInteger i = 0; i < subpredicates.count; i++) {
+        [self compilePredicatePayload:subpredicates[i] instructions:instructions matchers:matchers keys:keys];
+
+        if (i < subpredicates.count - 1) {
+            [jumps addObject:@(instructions.length / sizeof(UACompiledJSONPredicateInstruction))];
+            [self appendOpcode:jump operand:0 instructions:instructions];
+        }
+    }
+
+    UACompiledJSONPredicateInstruction *compiled = instructions.mutableBytes;
+    uint32_t end = (uint32_t)(instructions.length / sizeof(UACompiledJSONPredicateInstruction));
+    for (NSNumber *index in jumps) {
+        compiled[index.unsignedIntegerValue].operand = end;
+    }
+}
+
++ (UACompiledJSONMatcher *)compileMatcherPayload:(NSDictionary *)payload
+                                            keys:(NSMutableDictionary<NSString *, NSString *> *)keys {
+    UACompiledJSONMatcher *matcher = [[UACompiledJSONMatcher alloc] init];
+
+    // Scope followed by the key, with each key interned so matchers share strings
+    NSMutableArray<NSString *> *path = [NSMutableArray array];
+    [path addObjectsFromArray:payload[UAJSONMatcherScope]];
+    if (payload[UAJSONMatcherKey]) {
+        [path addObject:payload[UAJSONMatcherKey]];
+    }
+
+    for (NSUInteger i = 0; i < path.count; i++) {
+        NSString *key = keys[path[i]];
+        if (!key) {
+            key = [path[i] copy];
+            keys[key] = key;
+        }
+        path[i] = key;
+    }
+
+    matcher->_path = [path copy];
+    matcher->_ignoreCase = [payload[UAJSONMatcherIgnoreCase] boolValue];
+
+    NSDictionary *value = payload[UAJSONMatcherValue];
+    if (value[UAJSONValueMatcherIsPresent]) {
+        matcher->_checks |= UACompiledJSONMatcherCheckIsPresent;
+        matcher->_isPresent = [value[UAJSONValueMatcherIsPresent] boolValue];
+    }
+
+    if (value[UAJSONValueMatcherEquals]) {
+        matcher->_checks |= UACompiledJSONMatcherCheckEquals;
+        matcher->_equals = value[UAJSONValueMatcherEquals];
+    }
+
+    if (value[UAJSONValueMatcherAtLeast]) {
+        matcher->_checks |= UACompiledJSONMatcherCheckAtLeast;
+        matcher->_atLeast = value[UAJSONValueMatcherAtLeast];
+    }
+
+    if (value[UAJSONValueMatcherAtMost]) {
+        matcher->_checks |= UACompiledJSONMatcherCheckAtMost;
+        matcher->_atMost = value[UAJSONValueMatcherAtMost];
+    }
+
+    if (value[UAJSONValueMatcherVersionConstraint]) {
+        matcher->_checks |= UACompiledJSONMatcherCheckVersion;
+        matcher->_versionMatcher = [UAVersionMatcher matcherWithVersionConstraint:value[UAJSONValueMatcherVersionConstraint]];
+    }
+
+    if (value[UAJSONValueMatcherArrayContains]) {
+        matcher->_checks |= UACompiledJSONMatcherCheckArrayContains;
+        UAJSONPredicate *arrayPredicate = [UAJSONPredicate predicateWithJSON:value[UAJSONValueMatcherArrayContains] error:nil];
+        matcher->_arrayPredicate = [UACompiledJSONPredicate compiledPredicateWithPredicate:arrayPredicate];
+
+        if (value[UAJSONValueMatcherArrayIndex]) {
+            matcher->_checks |= UACompiledJSONMatcherCheckArrayIndex;
+            matcher->_arrayIndex = [value[UAJSONValueMatcherArrayIndex] integerValue];
+        }
+    }
+
+    return matcher;
+}
+
++ (void)appendOpcode:(UACompiledJSONPredicateOpcode)opcode operand:(uint32_t)operand instructions:(NSMutableData *)instructions {
+    UACompiledJSONPredicateInstruction instruction = { opcode, operand };
+    [instructions appendBytes:&instruction length:sizeof(instruction)];
+}
+
+@end
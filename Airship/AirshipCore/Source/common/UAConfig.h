@@ -201,6 +201,15 @@ typedef NS_ENUM(NSUInteger, UACloudSite) {
  */
 @property (nonatomic, assign) BOOL requestAuthorizationToUseNotifications;
 
+/**
+ * The delay in seconds after takeOff before modules that were not used during launch,
+ * such as Message Center and automation, open their stores and load their data. Modules that are used
+ * sooner are activated on first use.
+ *
+ * Defaults to `10`.
+ */
+@property (nonatomic, assign) NSTimeInterval moduleActivationDelay;
+
 ///---------------------------------------------------------------------------------------
 /// @name Internal Configuration Options
 ///---------------------------------------------------------------------------------------
@@ -54,6 +54,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
         self.customConfig = @{};
         self.channelCreationDelayEnabled = NO;
         self.defaultDetectProvisioningMode = YES;
+        self.moduleActivationDelay = 10;
     }
 
     return self;
@@ -93,6 +94,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
         _defaultDetectProvisioningMode = config.defaultDetectProvisioningMode;
         _messageCenterStyleConfig = config.messageCenterStyleConfig;
         _itunesID = config.itunesID;
+        _moduleActivationDelay = config.moduleActivationDelay;
     }
 
     return config;
@@ -128,6 +130,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
             "Delay Channel Creation: %d\n"
             "Default Message Center Style Config File: %@\n"
             "Use iTunes ID: %@\n"
+            "Module Activation Delay: %f\n"
             "Site:  %ld\n",
             self.inProduction,
             _inProduction,
@@ -158,6 +161,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
             self.channelCreationDelayEnabled,
             self.messageCenterStyleConfig,
             self.itunesID,
+            self.moduleActivationDelay,
             (long) self.site];
 }
 
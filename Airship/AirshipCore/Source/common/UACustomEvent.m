@@ -4,6 +4,7 @@
 #import "UAAnalytics.h"
 #import "UAirship.h"
 #import "NSJSONSerialization+UAAdditions.h"
+#import "UAJSONWriter+Internal.h"
 
 @interface UACustomEvent()
 @property(nonatomic, strong) NSMutableDictionary *mutableProperties;
@@ -209,20 +210,7 @@ NSString *const UACustomEventTemplateTypeKey = @"template_type";
     [dictionary setValue:self.templateType forKey:UACustomEventTemplateTypeKey];
 
     // Event value
-    if (self.eventValue) {
-
-        // Move the decimal position over 6 positions
-        NSDecimalNumber *number = [self.eventValue decimalNumberByMultiplyingByPowerOf10:6];
-
-        /*
-         We use long long value here because on a 32 bit machine int and long
-         have the same range. We clamp eventValue to [-2^31, 2^31-1] so we know
-         for sure that the value multiplied by 10^6 (~2^20) will have an approximate
-         range of [-2^51, 2^51-1] so it will always fit into the range warp9
-         is expecting [-2^63, 2^63-1].
-         */
-        [dictionary setValue:@([number longLongValue]) forKey:UACustomEventValueKey];
-    }
+    [dictionary setValue:[self dataEventValue] forKey:UACustomEventValueKey];
 
     NSMutableDictionary *stringifiedProperties = [NSMutableDictionary dictionary];
 
@@ -244,6 +232,73 @@ NSString *const UACustomEventTemplateTypeKey = @"template_type";
     return [dictionary mutableCopy];
 }
 
+- (BOOL)writeDataFieldsWithWriter:(UAJSONWriter *)writer {
+    // Same fields as `data`, written straight to the payload
+    void (^writeString)(NSString *, NSString *) = ^(NSString *key, NSString *value) {
+        if (value) {
+            [writer writeKey:key];
+            [writer writeString:value];
+        }
+    };
+
+    writeString(UACustomEventNameKey, self.eventName);
+    writeString(UACustomEventConversionSendIDKey, self.conversionSendID ?: [UAirship analytics].conversionSendID);
+    writeString(UACustomEventConversionMetadataKey, self.conversionPushMetadata ?: [UAirship analytics].conversionPushMetadata);
+    writeString(UACustomEventInteractionIDKey, self.interactionID);
+    writeString(UACustomEventInteractionTypeKey, self.interactionType);
+    writeString(UACustomEventTransactionIDKey, self.transactionID);
+    writeString(UACustomEventTemplateTypeKey, self.templateType);
+
+    NSNumber *eventValue = [self dataEventValue];
+    if (eventValue) {
+        [writer writeKey:UACustomEventValueKey];
+        [writer writeNumber:eventValue];
+    }
+
+    // Properties other than arrays are sent as their JSON encoded string. Values that can not be
+    // encoded are left out, and so is the properties object if none are left, as they are in `data`.
+    [writer writeKey:UACustomEventPropertiesKey valueBlock:^BOOL{
+        NSUInteger count = 0;
+        [writer beginObject];
+
+        for (id key in self.mutableProperties) {
+            id value = [self.mutableProperties valueForKey:key];
+            BOOL written = [value isKindOfClass:[NSArray class]] ? [writer writeKey:key value:value] : [writer writeKey:key stringifiedValue:value];
+            if (written) {
+                count++;
+            } else {
+                UA_LDEBUG(@"Omitting custom event property %@ that can not be encoded", key);
+            }
+        }
+
+        [writer endObject];
+        return count > 0;
+    }];
+
+    return YES;
+}
+
+/**
+ * The event value as it is sent, in millionths.
+ */
+- (nullable NSNumber *)dataEventValue {
+    if (!self.eventValue) {
+        return nil;
+    }
+
+    // Move the decimal position over 6 positions
+    NSDecimalNumber *number = [self.eventValue decimalNumberByMultiplyingByPowerOf10:6];
+
+    /*
+     We use long long value here because on a 32 bit machine int and long
+     have the same range. We clamp eventValue to [-2^31, 2^31-1] so we know
+     for sure that the value multiplied by 10^6 (~2^20) will have an approximate
+     range of [-2^51, 2^51-1] so it will always fit into the range warp9
+     is expecting [-2^63, 2^63-1].
+     */
+    return @([number longLongValue]);
+}
+
 - (NSDictionary *)payload {
     /*
      * We are unable to use the event.data for automation because we modify some
@@ -2,6 +2,8 @@
 
 #import "UAEvent.h"
 
+@class UAJSONWriter;
+
 NS_ASSUME_NONNULL_BEGIN
 
 
@@ -27,7 +29,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) NSDictionary *data;
 
 /**
- * The JSON event size in bytes.
+ * The JSON event size in bytes, without a session ID.
  */
 @property (nonatomic, readonly) NSUInteger jsonEventSize;
 
@@ -50,6 +52,23 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSString *)notificationAuthorization;
 
+/**
+ * Encodes the event as its upload payload in a single pass.
+ *
+ * @param sessionID The session ID to include in the event's data.
+ * @return The JSON encoded event, or `nil` if the event's data is not valid JSON.
+ */
+- (nullable NSData *)payloadWithSessionID:(nullable NSString *)sessionID;
+
+/**
+ * Writes the fields of the event's data. Defaults to writing the `data` dictionary. Subclasses
+ * can override to encode their fields without building the dictionary.
+ *
+ * @param writer The writer, inside the data object.
+ * @return `YES` if the fields were written, otherwise `NO`.
+ */
+- (BOOL)writeDataFieldsWithWriter:(UAJSONWriter *)writer;
+
 
 @end
 
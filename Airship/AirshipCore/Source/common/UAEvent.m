@@ -3,7 +3,7 @@
 #import "UAEvent+Internal.h"
 #import "UAPush.h"
 #import "UAirship.h"
-#import "UAJSONSerialization.h"
+#import "UAJSONWriter+Internal.h"
 
 @implementation UAEvent
 
@@ -90,17 +90,58 @@
 }
 
 - (NSUInteger)jsonEventSize {
-    NSMutableDictionary *eventDictionary = [NSMutableDictionary dictionary];
-    [eventDictionary setValue:self.eventType forKey:@"type"];
-    [eventDictionary setValue:self.time forKey:@"time"];
-    [eventDictionary setValue:self.eventID forKey:@"event_id"];
-    [eventDictionary setValue:self.data forKey:@"data"];
+    return [self payloadWithSessionID:nil].length;
+}
+
+- (NSData *)payloadWithSessionID:(NSString *)sessionID {
+    UAJSONWriter *writer = [UAJSONWriter writer];
+    [writer beginObject];
+
+    [writer writeKey:@"event_id"];
+    [writer writeString:self.eventID];
+    [writer writeKey:@"time"];
+    [writer writeString:self.time];
+    [writer writeKey:@"type"];
+    [writer writeString:self.eventType];
+
+    [writer writeKey:@"data"];
+    [writer beginObject];
 
-    NSData *jsonData = [UAJSONSerialization dataWithJSONObject:eventDictionary
-                                                       options:0
-                                                         error:nil];
+    if (![self writeDataFieldsWithWriter:writer]) {
+        UA_LERR(@"Unable to encode event %@", self.eventID);
+        return nil;
+    }
+
+    if (sessionID) {
+        [writer writeKey:@"session_id"];
+        [writer writeString:sessionID];
+    }
 
-    return [jsonData length];
+    [writer endObject];
+    [writer endObject];
+
+    return writer.data;
+}
+
+- (BOOL)writeDataFieldsWithWriter:(UAJSONWriter *)writer {
+    NSDictionary *data = self.data;
+    for (id key in data) {
+        if (![key isKindOfClass:[NSString class]]) {
+            return NO;
+        }
+
+        // Replaced by the session ID the event is stored with
+        if ([key isEqualToString:@"session_id"]) {
+            continue;
+        }
+
+        [writer writeKey:key];
+        if (![writer writeValue:data[key]]) {
+            return NO;
+        }
+    }
+
+    return YES;
 }
 
 - (id)debugQuickLookObject {
@@ -36,11 +36,25 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Uploads analytic events.
- * @param events The events to upload.
+ *
+ * The request body is built by splicing the already encoded event payloads into a
+ * JSON array, so the events are never decoded or re-encoded.
+ *
+ * @param payloads The JSON encoded event payloads to upload.
  * @param headers The event headers.
  * @param completionHandler A completion handler.
  */
--(void)uploadEvents:(NSArray *)events headers:(NSDictionary<NSString *, NSString *> *)headers completionHandler:(void (^)(NSHTTPURLResponse * nullable))completionHandler;
+- (void)uploadEventPayloads:(NSArray<NSData *> *)payloads
+                    headers:(NSDictionary<NSString *, NSString *> *)headers
+          completionHandler:(void (^)(NSHTTPURLResponse * nullable))completionHandler;
+
+/**
+ * Splices JSON encoded event payloads into a JSON array.
+ *
+ * @param payloads The JSON encoded event payloads.
+ * @return The request body.
+ */
++ (NSData *)bodyWithEventPayloads:(NSArray<NSData *> *)payloads;
 
 @end
 
@@ -3,8 +3,6 @@
 #import <UIKit/UIKit.h>
 
 #import "UAEventAPIClient+Internal.h"
-#import "NSJSONSerialization+UAAdditions.h"
-#import "UAJSONSerialization.h"
 #import "UAAnalytics+Internal.h"
 
 @implementation UAEventAPIClient
@@ -17,14 +15,18 @@
     return [[UAEventAPIClient alloc] initWithConfig:config session:session];
 }
 
--(void)uploadEvents:(NSArray *)events headers:(NSDictionary *)headers completionHandler:(void (^)(NSHTTPURLResponse *))completionHandler {
-    UARequest *request = [self requestWithEvents:events headers:headers];
+- (void)uploadEventPayloads:(NSArray<NSData *> *)payloads
+                    headers:(NSDictionary<NSString *, NSString *> *)headers
+          completionHandler:(void (^)(NSHTTPURLResponse *))completionHandler {
+
+    NSData *body = [UAEventAPIClient bodyWithEventPayloads:payloads];
+    UARequest *request = [self requestWithBody:body headers:headers];
 
     if (uaLogLevel >= UALogLevelTrace) {
-        UA_LTRACE(@"Sending analytics events with IDs: %@", [events valueForKey:@"event_id"]);
+        UA_LTRACE(@"Sending %lu analytics events", (unsigned long)payloads.count);
         UA_LTRACE(@"Sending to server: %@", self.config.analyticsURL);
         UA_LTRACE(@"Sending analytics headers: %@", [request.headers descriptionWithLocale:nil indent:1]);
-        UA_LTRACE(@"Sending analytics body: %@", [NSJSONSerialization stringWithObject:events options:NSJSONWritingPrettyPrinted]);
+        UA_LTRACE(@"Sending analytics body: %@", [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding]);
     }
 
     // Perform the upload
@@ -37,14 +39,34 @@
     }];
 }
 
-- (UARequest *)requestWithEvents:(NSArray *)events headers:(NSDictionary<NSString *, NSString *> *)headers {
++ (NSData *)bodyWithEventPayloads:(NSArray<NSData *> *)payloads {
+    NSUInteger length = 2 + (payloads.count ? payloads.count - 1 : 0);
+    for (NSData *payload in payloads) {
+        length += payload.length;
+    }
+
+    NSMutableData *body = [NSMutableData dataWithCapacity:length];
+    [body appendBytes:"[" length:1];
+
+    for (NSUInteger i = 0; i < payloads.count; i++) {
+        if (i > 0) {
+            [body appendBytes:"," length:1];
+        }
+        [body appendData:payloads[i]];
+    }
+
+    [body appendBytes:"]" length:1];
+    return body;
+}
+
+- (UARequest *)requestWithBody:(NSData *)body headers:(NSDictionary<NSString *, NSString *> *)headers {
     UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
         builder.URL = [NSURL URLWithString:[NSString stringWithFormat:@"%@%@", self.config.analyticsURL, @"/warp9/"]];
         builder.method = @"POST";
 
         // Body
         builder.compressBody = YES;
-        builder.body = [UAJSONSerialization dataWithJSONObject:events options:0 error:nil];
+        builder.body = body;
 
         // Headers
         [builder addHeaders:headers];
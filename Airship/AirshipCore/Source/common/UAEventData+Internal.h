@@ -25,6 +25,13 @@
  */
 @property (nullable, nonatomic, retain) NSData *data;
 
+/**
+ * The event's upload payload. Contains the complete JSON encoded event, including
+ * the session ID, so it can be sent without being decoded. Events stored before the
+ * payload was added will only have `data`.
+ */
+@property (nullable, nonatomic, retain) NSData *payload;
+
 /**
  * The event's creation time.
  */
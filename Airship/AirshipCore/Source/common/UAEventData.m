@@ -6,6 +6,7 @@
 
 @dynamic sessionID;
 @dynamic data;
+@dynamic payload;
 @dynamic bytes;
 @dynamic time;
 @dynamic type;
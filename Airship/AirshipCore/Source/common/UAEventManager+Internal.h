@@ -57,6 +57,16 @@
  */
 @property (atomic, strong, readonly) NSDate *lastSendTime;
 
+/**
+ * The number of upload schedule requests received while uploads were enabled.
+ */
+@property (atomic, readonly) NSUInteger uploadScheduleRequestCount;
+
+/**
+ * The number of upload schedule requests folded into an already pending upload.
+ */
+@property (atomic, readonly) NSUInteger coalescedUploadScheduleRequestCount;
+
 /**
  * Flag indicating whether evant manager uploads are enabled. Clear to disable. Default is enabled.
  */
@@ -33,6 +33,8 @@
 @property (atomic, strong, nonnull) NSDate *lastSendTime;
 @property (nonatomic, strong, nonnull) NSOperationQueue *queue;
 @property (atomic, strong, nullable) NSDate *nextUploadDate;
+@property (atomic, assign) NSUInteger uploadScheduleRequestCount;
+@property (atomic, assign) NSUInteger coalescedUploadScheduleRequestCount;
 
 @end
 
@@ -42,6 +44,9 @@ const NSTimeInterval HighPriorityUploadDelay = 1;
 const NSTimeInterval BackgroundUploadDelay = 5;
 const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
 
+// Requests landing this close after the pending upload are folded into it
+const NSTimeInterval UploadScheduleCoalesceWindow = 1;
+
 @implementation UAEventManager
 
 - (instancetype)initWithConfig:(UARuntimeConfig *)config
@@ -263,9 +268,12 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
 #pragma mark Event upload
 
 - (void)cancelUpload {
-    [self.queue cancelAllOperations];
+    @synchronized (self) {
+        [self.queue cancelAllOperations];
+        self.nextUploadDate = nil;
+    }
+
     [self.client cancelAllRequests];
-    self.nextUploadDate = nil;
 }
 
 - (void)scheduleUpload {
@@ -298,34 +306,31 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
         return;
     }
 
-    UA_LTRACE(@"Enqueuing attempt to schedule event upload with delay on main queue.");
-
-    UA_WEAKIFY(self);
-    [[UADispatcher mainDispatcher] dispatchAsync:^{
-        UA_STRONGIFY(self);
-        if (!self.uploadsEnabled) {
-            return;
-        }
+    NSDate *uploadDate = [NSDate dateWithTimeIntervalSinceNow:delay];
 
-        UA_LTRACE(@"Attempting to schedule event upload with delay: %f seconds.", delay);
+    // The pending upload only ever moves earlier, so requests that land on or after it
+    // are coalesced without touching the queue. Runs on the calling thread.
+    @synchronized (self) {
+        self.uploadScheduleRequestCount++;
 
-        NSDate *uploadDate = [NSDate dateWithTimeIntervalSinceNow:delay];
-        NSTimeInterval timeDifference = [self.nextUploadDate timeIntervalSinceDate:uploadDate];
-        if (self.nextUploadDate && timeDifference >= 0 && timeDifference <= 1) {
-            UA_LTRACE("Upload already scheduled for an earlier time.");
+        NSDate *nextUploadDate = self.nextUploadDate;
+        if (nextUploadDate && [nextUploadDate timeIntervalSinceDate:uploadDate] <= UploadScheduleCoalesceWindow) {
+            self.coalescedUploadScheduleRequestCount++;
             return;
         }
 
-        if (self.nextUploadDate) {
+        UA_LTRACE(@"Scheduling event upload with delay: %f seconds.", delay);
+
+        if (nextUploadDate) {
             [self.queue cancelAllOperations];
-            self.nextUploadDate = nil;
         }
 
-        UA_LTRACE(@"Scheduling upload.");
-        if ([self enqueueUploadOperationWithDelay:delay]) {
-            self.nextUploadDate = uploadDate;
+        // Set before enqueuing so an operation that starts right away clears it
+        self.nextUploadDate = uploadDate;
+        if (![self enqueueUploadOperationWithDelay:delay]) {
+            self.nextUploadDate = nil;
         }
-    }];
+    }
 }
 
 - (BOOL)enqueueUploadOperationWithDelay:(NSTimeInterval)delay {
@@ -338,7 +343,9 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
             return;
         }
 
-        self.nextUploadDate = nil;
+        @synchronized (self) {
+            self.nextUploadDate = nil;
+        }
 
         UA_LTRACE("Preparing events for upload");
 
@@ -351,87 +358,131 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
         // Clean up store
         [self.eventStore trimEventsToStoreSize:self.maxTotalDBSize];
 
-        // Fetch events
-        [self.eventStore fetchEventsWithMaxBatchSize:self.maxBatchSize completionHandler:^(NSArray<UAEventData *> *result) {
+        [self uploadNextBatchWithOperation:operation previousEventIDs:[NSSet set]];
+    }];
 
-            // Make sure we are not cancelled
-            if (operation.isCancelled) {
-                [operation finish];
-                return;
-            }
+    return [self.queue addBackgroundOperation:operation delay:delay];
+}
+
+/**
+ * Uploads the next batch of events. Batches are sent back to back until the store
+ * is drained, an upload fails, or the operation is cancelled.
+ *
+ * @param operation The upload operation.
+ * @param previousEventIDs The event IDs of the previously uploaded batch.
+ */
+- (void)uploadNextBatchWithOperation:(UAAsyncOperation *)operation previousEventIDs:(NSSet<NSString *> *)previousEventIDs {
+    UA_WEAKIFY(self);
+    [self.eventStore fetchEventsWithMaxBatchSize:self.maxBatchSize completionHandler:^(NSArray<UAEventData *> *result) {
+        UA_STRONGIFY(self);
+
+        // Make sure we are not cancelled
+        if (operation.isCancelled) {
+            [operation finish];
+            return;
+        }
+
+        if (!result.count) {
+            [operation finish];
+            return;
+        }
+
+        NSMutableArray<NSData *> *payloads = [NSMutableArray arrayWithCapacity:result.count];
+        NSMutableArray<NSString *> *eventIDs = [NSMutableArray arrayWithCapacity:result.count];
 
-            if (!result.count) {
+        for (UAEventData *eventData in result) {
+            // Guard against resending events that failed to delete
+            if ([previousEventIDs containsObject:eventData.identifier]) {
+                UA_LTRACE(@"Event %@ already uploaded. Stopping batch upload.", eventData.identifier);
                 [operation finish];
                 return;
             }
 
-            NSMutableArray *preparedEvents = [NSMutableArray arrayWithCapacity:result.count];
+            NSData *payload = eventData.payload ?: [UAEventManager payloadWithLegacyEventData:eventData];
+            if (!payload || !eventData.identifier) {
+                [[eventData managedObjectContext] deleteObject:eventData];
+                continue;
+            }
 
-            for (UAEventData *eventData in result) {
-                NSMutableDictionary *eventBody = [NSMutableDictionary dictionary];
-                [eventBody setValue:eventData.identifier forKey:@"event_id"];
-                [eventBody setValue:eventData.time forKey:@"time"];
-                [eventBody setValue:eventData.type forKey:@"type"];
+            [payloads addObject:payload];
+            [eventIDs addObject:eventData.identifier];
+        }
 
-                NSError *error = nil;
-                NSMutableDictionary *data = [[NSJSONSerialization JSONObjectWithData:eventData.data options:0 error:&error] mutableCopy];
-                if (error) {
-                    UA_LERR(@"Failed to deserialize event %@: %@", eventData, error);
-                    [[eventData managedObjectContext] deleteObject:eventData];
-                }
+        if (!payloads.count) {
+            [operation finish];
+            return;
+        }
 
-                [data setValue:eventData.sessionID forKey:@"session_id"];
-                [eventBody setValue:data forKey:@"data"];
+        // Make sure we are not cancelled
+        if (operation.isCancelled) {
+            [operation finish];
+            return;
+        }
 
-                [preparedEvents addObject:eventBody];
-            }
+        UA_LTRACE("Uploading events.");
 
-            // Make sure we are not cancelled
+        // Make sure the event upload request is queueed and on the main thread as it needs to access application state
+        [[UADispatcher mainDispatcher] dispatchAsync: ^{
+            // Make sure we are still not cancelled
             if (operation.isCancelled) {
                 [operation finish];
                 return;
             }
 
-            UA_LTRACE("Uploading events.");
+            UA_STRONGIFY(self);
+            NSDictionary *headers = [self.delegate analyticsHeaders] ?: @{};
 
-            // Make sure the event upload request is queueed and on the main thread as it needs to access application state
-            [[UADispatcher mainDispatcher] dispatchAsync: ^{
-                // Make sure we are still not cancelled
-                if (operation.isCancelled) {
-                    [operation finish];
-                    return;
-                }
-
-                NSDictionary *headers = [self.delegate analyticsHeaders] ?: @{};
+            [self.client uploadEventPayloads:payloads headers:headers completionHandler:^(NSHTTPURLResponse *response) {
 
                 UA_STRONGIFY(self);
-                [self.client uploadEvents:preparedEvents headers:headers completionHandler:^(NSHTTPURLResponse *response) {
-
-                    UA_STRONGIFY(self);
-                    self.lastSendTime = [NSDate date];
-
-                    if (response.statusCode == 200) {
-                        UA_LTRACE(@"Analytic upload success");
-                        UA_LTRACE(@"Response: %@", response);
-                        [self.eventStore deleteEventsWithIDs:[preparedEvents valueForKey:@"event_id"]];
-                        [self updateAnalyticsParametersWithResponse:response];
-                    } else {
-                        UA_LTRACE(@"Analytics upload request failed: %ld", (unsigned long)response.statusCode);
-                        [self scheduleUploadWithDelay:FailedUploadRetryDelay];
-                    }
-
+                self.lastSendTime = [NSDate date];
+
+                if (response.statusCode == 200) {
+                    UA_LTRACE(@"Analytic upload success");
+                    UA_LTRACE(@"Response: %@", response);
+                    [self.eventStore deleteEventsWithIDs:eventIDs];
+                    [self updateAnalyticsParametersWithResponse:response];
+
+                    // Deletes and fetches are serialized on the store, so the next batch starts after this one
+                    [self uploadNextBatchWithOperation:operation previousEventIDs:[NSSet setWithArray:eventIDs]];
+                } else {
+                    UA_LTRACE(@"Analytics upload request failed: %ld", (unsigned long)response.statusCode);
+                    [self scheduleUploadWithDelay:FailedUploadRetryDelay];
                     [operation finish];
-                }];
+                }
             }];
         }];
     }];
-
-    return [self.queue addBackgroundOperation:operation delay:delay];
 }
 
 #pragma mark -
 #pragma mark Helper methods
 
+/**
+ * Builds the upload payload for an event stored before payloads were persisted.
+ *
+ * @param eventData The event data.
+ * @return The JSON encoded payload, or nil if the event data is invalid.
+ */
++ (nullable NSData *)payloadWithLegacyEventData:(UAEventData *)eventData {
+    NSError *error = nil;
+    NSMutableDictionary *data = [[NSJSONSerialization JSONObjectWithData:eventData.data options:0 error:&error] mutableCopy];
+    if (error || ![data isKindOfClass:[NSDictionary class]]) {
+        UA_LERR(@"Failed to deserialize event %@: %@", eventData, error);
+        return nil;
+    }
+
+    [data setValue:eventData.sessionID forKey:@"session_id"];
+
+    NSMutableDictionary *eventBody = [NSMutableDictionary dictionary];
+    [eventBody setValue:eventData.identifier forKey:@"event_id"];
+    [eventBody setValue:eventData.time forKey:@"time"];
+    [eventBody setValue:eventData.type forKey:@"type"];
+    [eventBody setValue:data forKey:@"data"];
+
+    return [NSJSONSerialization dataWithJSONObject:eventBody options:0 error:nil];
+}
+
 + (NSUInteger)clampValue:(NSUInteger)value min:(NSUInteger)min max:(NSUInteger)max {
     if (value < min) {
         return min;
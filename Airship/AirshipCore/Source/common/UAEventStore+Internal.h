@@ -24,7 +24,8 @@
 + (instancetype)eventStoreWithConfig:(UARuntimeConfig *)config;
 
 /**
- * Saves an event.
+ * Saves an event. Events saved while a save is pending on the store's context are
+ * written with that save, so bursts of events only save the context once.
  *
  * @param event The event to store.
  * @param sessionID The event's session ID.
@@ -32,9 +33,11 @@
 - (void)saveEvent:(UAEvent *)event sessionID:(NSString *)sessionID;
 
 /**
- * Fetches a batch of events.
+ * Fetches a batch of events, oldest first. Events are added to the batch until
+ * their stored byte sizes would exceed the max batch size. The batch always contains
+ * at least one event if the store is not empty.
  *
- * @param maxBatchSize The max event batch size.
+ * @param maxBatchSize The max event batch size in bytes.
  * @param completionHandler A completion handler with the event data.
  */
 - (void)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize
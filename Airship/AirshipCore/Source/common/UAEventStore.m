@@ -7,7 +7,7 @@
 #import "NSManagedObjectContext+UAAdditions.h"
 #import <CoreData/CoreData.h>
 #import "UARuntimeConfig.h"
-#import "UAEvent.h"
+#import "UAEvent+Internal.h"
 #import "UAirship.h"
 #import "UASQLite+Internal.h"
 #import "UAJSONSerialization.h"
@@ -16,10 +16,17 @@
 NSString *const UAEventStoreFileFormat = @"Events-%@.sqlite";
 NSString *const UAEventDataEntityName = @"UAEventData";
 
+// Number of rows faulted in at a time when filling a batch
+NSUInteger const UAEventStoreFetchBatchSize = 50;
+
 @interface UAEventStore ()
 @property (nonatomic, strong) NSManagedObjectContext *managedContext;
 @property (nonatomic, copy) NSString *storeName;
 
+// Events waiting for the next save, guarded by synchronizing on the array
+@property (nonatomic, strong) NSMutableArray<NSArray *> *pendingEvents;
+@property (nonatomic, assign) BOOL saveScheduled;
+
 @end
 
 @implementation UAEventStore
@@ -29,6 +36,7 @@ NSString *const UAEventDataEntityName = @"UAEventData";
 
     if (self) {
         self.storeName = [NSString stringWithFormat:UAEventStoreFileFormat, config.appKey];
+        self.pendingEvents = [NSMutableArray array];
         NSURL *modelURL = [[UAirshipCoreResources bundle] URLForResource:@"UAEvents" withExtension:@"momd"];
         self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
                                                                       concurrencyType:NSPrivateQueueConcurrencyType];
@@ -63,18 +71,47 @@ NSString *const UAEventDataEntityName = @"UAEventData";
 }
 
 - (void)saveEvent:(UAEvent *)event sessionID:(NSString *)sessionID {
+    // Events saved before the context gets to the pending save are written with it
+    @synchronized (self.pendingEvents) {
+        [self.pendingEvents addObject:@[event, sessionID ?: [NSNull null]]];
+        if (self.saveScheduled) {
+            return;
+        }
+        self.saveScheduled = YES;
+    }
+
     [self.managedContext safePerformBlock:^(BOOL isSafe) {
+        NSArray<NSArray *> *events;
+        @synchronized (self.pendingEvents) {
+            events = [self.pendingEvents copy];
+            [self.pendingEvents removeAllObjects];
+            self.saveScheduled = NO;
+        }
+
         if (!isSafe) {
-            UA_LERR(@"Unable to save event: %@. Persistent store unavailable", event);
+            UA_LERR(@"Unable to save %lu events. Persistent store unavailable", (unsigned long)events.count);
             return;
         }
 
-        [self storeEventWithID:event.eventID
-                     eventType:event.eventType
-                     eventTime:event.time
-                     eventBody:event.data
-                     sessionID:sessionID];
+        for (NSArray *pending in events) {
+            UAEvent *event = pending[0];
+            NSString *sessionID = pending[1] == [NSNull null] ? nil : pending[1];
+
+            // Encoded once, straight to the bytes that are stored and uploaded
+            NSData *payload = [event payloadWithSessionID:sessionID];
+            if (!payload) {
+                UA_LERR(@"Unable to save event %@", event.eventID);
+                continue;
+            }
 
+            [self storeEventWithID:event.eventID
+                         eventType:event.eventType
+                         eventTime:event.time
+                           payload:payload
+                         sessionID:sessionID];
+        }
+
+        UA_LTRACE(@"Saving %lu events", (unsigned long)events.count);
         [self.managedContext safeSave];
     }];
 }
@@ -89,8 +126,11 @@ NSString *const UAEventDataEntityName = @"UAEventData";
             return;
         }
 
+        // Oldest first. The batch size makes the result lazily fault in rows, so only
+        // the rows needed to fill the batch are read from the store.
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
-        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:NO] ];
+        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:YES] ];
+        request.fetchBatchSize = UAEventStoreFetchBatchSize;
 
         NSError *error;
         NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
@@ -98,10 +138,26 @@ NSString *const UAEventDataEntityName = @"UAEventData";
         if (error) {
             UA_LERR(@"Error fetching events %@", error);
             completionHandler(@[]);
-        } else {
-            completionHandler(result);
-            [self.managedContext safeSave];
+            return;
+        }
+
+        NSMutableArray<UAEventData *> *batch = [NSMutableArray array];
+        NSUInteger batchBytes = 0;
+
+        for (UAEventData *eventData in result) {
+            NSUInteger eventBytes = [eventData.bytes unsignedIntegerValue];
+
+            // Always include at least one event so an oversized event can not block the queue
+            if (batch.count && batchBytes + eventBytes > maxBatchSize) {
+                break;
+            }
+
+            batchBytes += eventBytes;
+            [batch addObject:eventData];
         }
+
+        completionHandler(batch);
+        [self.managedContext safeSave];
     }];
 }
 
@@ -235,13 +291,27 @@ NSString *const UAEventDataEntityName = @"UAEventData";
 }
 
 - (void)storeEventWithID:(NSString *)eventID eventType:(NSString *)eventType eventTime:(NSString *)eventTime eventBody:(id)eventBody sessionID:(NSString *)sessionID {
+    // Encode the event exactly as it will be uploaded so the upload path can send the stored bytes as is
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:eventBody];
+    [data setValue:sessionID forKey:@"session_id"];
+
+    NSMutableDictionary *payload = [NSMutableDictionary dictionary];
+    [payload setValue:eventID forKey:@"event_id"];
+    [payload setValue:eventTime forKey:@"time"];
+    [payload setValue:eventType forKey:@"type"];
+    [payload setValue:data forKey:@"data"];
+
     NSError *error;
-    id json = [UAJSONSerialization dataWithJSONObject:eventBody options:0 error:&error];
+    NSData *json = [UAJSONSerialization dataWithJSONObject:payload options:0 error:&error];
     if (error) {
         UA_LERR(@"Unable to save event. %@", error);
         return;
     }
 
+    [self storeEventWithID:eventID eventType:eventType eventTime:eventTime payload:json sessionID:sessionID];
+}
+
+- (void)storeEventWithID:(NSString *)eventID eventType:(NSString *)eventType eventTime:(NSString *)eventTime payload:(NSData *)payload sessionID:(NSString *)sessionID {
     UAEventData *eventData = [NSEntityDescription insertNewObjectForEntityForName:UAEventDataEntityName
                                                            inManagedObjectContext:self.managedContext];
 
@@ -249,11 +319,11 @@ NSString *const UAEventDataEntityName = @"UAEventData";
     eventData.type = eventType;
     eventData.time = eventTime;
     eventData.identifier = eventID;
-    eventData.data = json;
+    eventData.payload = payload;
     eventData.storeDate = [NSDate date];
 
-    // Approximate size
-    eventData.bytes = @(eventData.sessionID.length + eventData.type.length + eventData.time.length + eventData.identifier.length + eventData.data.length);
+    // The payload is what gets uploaded, so its length is the event's size
+    eventData.bytes = @(payload.length);
 
     UA_LTRACE(@"Event saved: %@", eventID);
 }
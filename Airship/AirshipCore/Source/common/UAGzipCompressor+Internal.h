@@ -0,0 +1,86 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Default compression level. Maps to zlib's default level.
+ */
+extern const NSInteger UAGzipCompressionLevelDefault;
+
+/**
+ * Streaming GZIP compressor.
+ *
+ * Data is compressed as it is appended, so the uncompressed input never needs to be held
+ * in memory at once. The underlying z_stream is reset instead of reallocated after
+ * each finish, so a single compressor can be reused for many bodies.
+ *
+ * Instances are not thread safe.
+ */
+@interface UAGzipCompressor : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Gzip Compressor Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The compression level, from 0 (no compression) to 9 (best compression), or
+ * UAGzipCompressionLevelDefault.
+ */
+@property (nonatomic, readonly) NSInteger level;
+
+///---------------------------------------------------------------------------------------
+/// @name Gzip Compressor Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param level The compression level.
+ * @return A compressor, or nil if the stream could not be initialized.
+ */
++ (nullable instancetype)compressorWithLevel:(NSInteger)level;
+
+/**
+ * Compresses data using a pooled compressor for the level. Safe to call from any thread;
+ * concurrent calls use separate compressors.
+ *
+ * @param data The data to compress.
+ * @param level The compression level.
+ * @return The compressed data, or nil if the data is empty or compression failed.
+ */
++ (nullable NSData *)compressData:(NSData *)data level:(NSInteger)level;
+
+/**
+ * Compresses a chunk of data.
+ *
+ * @param data The data.
+ * @return YES if the chunk was compressed, otherwise NO.
+ */
+- (BOOL)appendData:(NSData *)data;
+
+/**
+ * Compresses the remaining contents of a stream. The stream is opened if needed
+ * and read in fixed size chunks. The stream is not closed.
+ *
+ * @param stream The input stream.
+ * @return YES if the stream was read and compressed, otherwise NO.
+ */
+- (BOOL)appendStream:(NSInputStream *)stream;
+
+/**
+ * Finishes the current stream and resets the compressor for reuse.
+ *
+ * @return The compressed data, or nil if nothing was appended or compression failed.
+ */
+- (nullable NSData *)finish;
+
+/**
+ * Discards any pending output and resets the compressor for reuse.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,212 @@
+/* Copyright Airship and Contributors */
+
+#import <zlib.h>
+
+#import "UAGzipCompressor+Internal.h"
+#import "UAGlobal.h"
+
+const NSInteger UAGzipCompressionLevelDefault = Z_DEFAULT_COMPRESSION;
+
+// Size of the scratch buffer used for compressed output and stream reads
+#define kUAGzipCompressorChunkSize 16384
+
+// Maximum number of idle compressors kept for reuse per compression level
+#define kUAGzipCompressorPoolSize 4
+
+@interface UAGzipCompressor () {
+    z_stream _stream;
+    Bytef _outputBuffer[kUAGzipCompressorChunkSize];
+}
+
+@property (nonatomic, assign) NSInteger level;
+@property (nonatomic, strong, nullable) NSMutableData *output;
+@property (nonatomic, assign) BOOL failed;
+
+@end
+
+@implementation UAGzipCompressor
+
+- (nullable instancetype)initWithLevel:(NSInteger)level {
+    self = [super init];
+
+    if (self) {
+        self.level = level;
+
+        _stream.zalloc = Z_NULL;
+        _stream.zfree = Z_NULL;
+        _stream.opaque = Z_NULL;
+
+        // 15 window bits + 16 for a gzip header and trailer
+        if (deflateInit2(&_stream, (int)level, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            UA_LERR(@"Unable to initialize gzip stream with level %ld", (long)level);
+            return nil;
+        }
+    }
+
+    return self;
+}
+
++ (nullable instancetype)compressorWithLevel:(NSInteger)level {
+    return [[self alloc] initWithLevel:level];
+}
+
+- (void)dealloc {
+    deflateEnd(&_stream);
+}
+
++ (nullable NSData *)compressData:(NSData *)data level:(NSInteger)level {
+    if (!data.length) {
+        return nil;
+    }
+
+    static NSMutableDictionary<NSNumber *, NSMutableArray<UAGzipCompressor *> *> *pools;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pools = [NSMutableDictionary dictionary];
+    });
+
+    // The pool lock is only held to check a compressor out or in, so concurrent calls
+    // compress in parallel on separate streams
+    UAGzipCompressor *compressor;
+    @synchronized (pools) {
+        compressor = [pools[@(level)] lastObject];
+        [pools[@(level)] removeLastObject];
+    }
+
+    if (!compressor) {
+        compressor = [UAGzipCompressor compressorWithLevel:level];
+        if (!compressor) {
+            return nil;
+        }
+    }
+
+    [compressor appendData:data];
+    NSData *compressed = [compressor finish];
+
+    @synchronized (pools) {
+        NSMutableArray<UAGzipCompressor *> *pool = pools[@(level)];
+        if (!pool) {
+            pool = [NSMutableArray array];
+            pools[@(level)] = pool;
+        }
+
+        if (pool.count < kUAGzipCompressorPoolSize) {
+            [pool addObject:compressor];
+        }
+    }
+
+    return compressed;
+}
+
+- (BOOL)appendData:(NSData *)data {
+    return [self appendBytes:data.bytes length:data.length];
+}
+
+- (BOOL)appendStream:(NSInputStream *)stream {
+    if (stream.streamStatus == NSStreamStatusNotOpen) {
+        [stream open];
+    }
+
+    uint8_t buffer[kUAGzipCompressorChunkSize];
+    while (YES) {
+        NSInteger bytesRead = [stream read:buffer maxLength:sizeof(buffer)];
+        if (bytesRead < 0) {
+            UA_LERR(@"Unable to read body stream: %@", stream.streamError);
+            self.failed = YES;
+            return NO;
+        }
+
+        if (bytesRead == 0) {
+            return YES;
+        }
+
+        if (![self appendBytes:buffer length:(NSUInteger)bytesRead]) {
+            return NO;
+        }
+    }
+}
+
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length {
+    if (self.failed) {
+        return NO;
+    }
+
+    if (!length) {
+        return YES;
+    }
+
+    if (!self.output) {
+        // Text bodies typically compress well, so start small and let the buffer grow
+        self.output = [NSMutableData dataWithCapacity:MAX(length / 4, kUAGzipCompressorChunkSize)];
+    }
+
+    // avail_in is 32 bits, so feed large inputs in slices
+    const Bytef *next = bytes;
+    NSUInteger remaining = length;
+    while (remaining) {
+        uInt slice = (uInt)MIN(remaining, (NSUInteger)UINT32_MAX);
+        _stream.next_in = (Bytef *)next;
+        _stream.avail_in = slice;
+
+        if (![self deflateWithFlush:Z_NO_FLUSH]) {
+            return NO;
+        }
+
+        next += slice;
+        remaining -= slice;
+    }
+
+    return YES;
+}
+
+- (nullable NSData *)finish {
+    if (!self.output || self.failed) {
+        [self reset];
+        return nil;
+    }
+
+    _stream.next_in = Z_NULL;
+    _stream.avail_in = 0;
+
+    NSData *result = nil;
+    if ([self deflateWithFlush:Z_FINISH]) {
+        result = self.output;
+    }
+
+    self.output = nil;
+    [self reset];
+    return result;
+}
+
+- (void)reset {
+    self.output = nil;
+    self.failed = NO;
+    deflateReset(&_stream);
+}
+
+/**
+ * Runs deflate until the pending input is consumed, or the stream ends when finishing.
+ *
+ * @param flush The zlib flush mode.
+ * @return YES on success, otherwise NO.
+ */
+- (BOOL)deflateWithFlush:(int)flush {
+    int status;
+    do {
+        _stream.next_out = _outputBuffer;
+        _stream.avail_out = kUAGzipCompressorChunkSize;
+
+        status = deflate(&_stream, flush);
+        if (status == Z_STREAM_ERROR) {
+            UA_LERR(@"Failed to compress data");
+            self.failed = YES;
+            return NO;
+        }
+
+        [self.output appendBytes:_outputBuffer length:kUAGzipCompressorChunkSize - _stream.avail_out];
+    } while (_stream.avail_out == 0);
+
+    return YES;
+}
+
+@end
@@ -0,0 +1,129 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Streaming JSON writer. Values are encoded straight into a single buffer, so an object can be
+ * written without building intermediate dictionaries or strings.
+ *
+ * Callers are responsible for pairing begin and end calls, and for writing a key before each
+ * value in an object.
+ */
+@interface UAJSONWriter : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Writer Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The encoded JSON.
+ */
+@property (nonatomic, readonly) NSData *data;
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Writer Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @return A JSON writer.
+ */
++ (instancetype)writer;
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Writer Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Begins an object.
+ */
+- (void)beginObject;
+
+/**
+ * Ends the current object.
+ */
+- (void)endObject;
+
+/**
+ * Begins an array.
+ */
+- (void)beginArray;
+
+/**
+ * Ends the current array.
+ */
+- (void)endArray;
+
+/**
+ * Writes an object key.
+ *
+ * @param key The key.
+ */
+- (void)writeKey:(NSString *)key;
+
+/**
+ * Writes a string.
+ *
+ * @param string The string.
+ */
+- (void)writeString:(NSString *)string;
+
+/**
+ * Writes a number. Boolean numbers are written as `true` or `false`.
+ *
+ * @param number The number.
+ * @return `YES` if the number was written, `NO` if it is not finite.
+ */
+- (BOOL)writeNumber:(NSNumber *)number;
+
+/**
+ * Writes a JSON value. Supports strings, numbers, `NSNull`, and arrays and dictionaries of them.
+ *
+ * @param value The value.
+ * @return `YES` if the value was written, `NO` if it contains an unsupported object.
+ */
+- (BOOL)writeValue:(id)value;
+
+/**
+ * Writes an object key and value. If the value can not be written, neither is.
+ *
+ * @param key The key.
+ * @param value The value.
+ * @return `YES` if the value was written, otherwise `NO`.
+ */
+- (BOOL)writeKey:(NSString *)key value:(id)value;
+
+/**
+ * Writes an object key and stringified value. If the value can not be written, neither is.
+ *
+ * @param key The key.
+ * @param value The string or number.
+ * @return `YES` if the value was written, otherwise `NO`.
+ */
+- (BOOL)writeKey:(NSString *)key stringifiedValue:(id)value;
+
+/**
+ * Writes an object key followed by whatever the block writes. If the block returns `NO`, the key
+ * and everything the block wrote are discarded.
+ *
+ * @param key The key.
+ * @param valueBlock Writes the value and returns whether it succeeded.
+ * @return The result of the block.
+ */
+- (BOOL)writeKey:(NSString *)key valueBlock:(BOOL (^)(void))valueBlock;
+
+/**
+ * Writes the JSON encoding of a string or number as a string, the same as writing the result of
+ * `NSJSONSerialization stringWithObject:acceptingFragments:` without creating it.
+ *
+ * @param value The string or number.
+ * @return `YES` if the value was written, otherwise `NO`.
+ */
+- (BOOL)writeStringifiedValue:(id)value;
+
+@end
+
+NS_ASSUME_NONNULL_END
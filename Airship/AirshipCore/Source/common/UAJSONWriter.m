@@ -0,0 +1,340 @@
+/* Copyright Airship and Contributors */
+
+#import "UAJSONWriter+Internal.h"
+
+@interface UAJSONWriter()
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, assign) BOOL needsSeparator;
+@property (nonatomic, assign) BOOL afterKey;
+@end
+
+@implementation UAJSONWriter
+
+static inline BOOL UAJSONNeedsEscape(unichar c) {
+    return c == '"' || c == '\\' || c < 0x20;
+}
+
++ (instancetype)writer {
+    return [[self alloc] init];
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.buffer = [NSMutableData dataWithCapacity:256];
+    }
+    return self;
+}
+
+- (NSData *)data {
+    return self.buffer;
+}
+
+#pragma mark -
+#pragma mark Structure
+
+- (void)beginObject {
+    [self beginValue];
+    [self appendByte:'{'];
+    self.needsSeparator = NO;
+}
+
+- (void)endObject {
+    [self appendByte:'}'];
+    self.needsSeparator = YES;
+}
+
+- (void)beginArray {
+    [self beginValue];
+    [self appendByte:'['];
+    self.needsSeparator = NO;
+}
+
+- (void)endArray {
+    [self appendByte:']'];
+    self.needsSeparator = YES;
+}
+
+- (void)writeKey:(NSString *)key {
+    if (self.needsSeparator) {
+        [self appendByte:','];
+    }
+
+    [self appendQuotedString:key escapes:1];
+    [self appendByte:':'];
+    self.afterKey = YES;
+}
+
+/**
+ * Writes the separator a value needs, if any.
+ */
+- (void)beginValue {
+    if (self.afterKey) {
+        self.afterKey = NO;
+    } else if (self.needsSeparator) {
+        [self appendByte:','];
+    }
+}
+
+#pragma mark -
+#pragma mark Values
+
+- (void)writeString:(NSString *)string {
+    [self beginValue];
+    [self appendQuotedString:string escapes:1];
+    self.needsSeparator = YES;
+}
+
+- (BOOL)writeNumber:(NSNumber *)number {
+    NSString *literal = [UAJSONWriter literalForNumber:number];
+    if (!literal) {
+        return NO;
+    }
+
+    [self beginValue];
+    [self appendString:literal escapes:0];
+    self.needsSeparator = YES;
+    return YES;
+}
+
+- (BOOL)writeValue:(id)value {
+    if ([value isKindOfClass:[NSString class]]) {
+        [self writeString:value];
+        return YES;
+    }
+
+    if ([value isKindOfClass:[NSNumber class]]) {
+        return [self writeNumber:value];
+    }
+
+    if ([value isKindOfClass:[NSNull class]]) {
+        [self beginValue];
+        [self appendString:@"null" escapes:0];
+        self.needsSeparator = YES;
+        return YES;
+    }
+
+    if ([value isKindOfClass:[NSArray class]]) {
+        [self beginArray];
+        for (id element in value) {
+            if (![self writeValue:element]) {
+                return NO;
+            }
+        }
+        [self endArray];
+        return YES;
+    }
+
+    if ([value isKindOfClass:[NSDictionary class]]) {
+        [self beginObject];
+        for (id key in value) {
+            if (![key isKindOfClass:[NSString class]]) {
+                return NO;
+            }
+
+            [self writeKey:key];
+            if (![self writeValue:value[key]]) {
+                return NO;
+            }
+        }
+        [self endObject];
+        return YES;
+    }
+
+    return NO;
+}
+
+- (BOOL)writeKey:(NSString *)key value:(id)value {
+    return [self writeKey:key valueBlock:^BOOL{
+        return [self writeValue:value];
+    }];
+}
+
+- (BOOL)writeKey:(NSString *)key stringifiedValue:(id)value {
+    return [self writeKey:key valueBlock:^BOOL{
+        return [self writeStringifiedValue:value];
+    }];
+}
+
+- (BOOL)writeKey:(NSString *)key valueBlock:(BOOL (^)(void))valueBlock {
+    NSUInteger length = self.buffer.length;
+    BOOL needsSeparator = self.needsSeparator;
+
+    [self writeKey:key];
+    if (valueBlock()) {
+        return YES;
+    }
+
+    self.buffer.length = length;
+    self.needsSeparator = needsSeparator;
+    self.afterKey = NO;
+    return NO;
+}
+
+- (BOOL)writeStringifiedValue:(id)value {
+    if ([value isKindOfClass:[NSString class]]) {
+        // The quotes of the inner string are escaped once, its contents twice
+        [self beginValue];
+        [self appendString:@"\"\\\"" escapes:0];
+        [self appendString:value escapes:2];
+        [self appendString:@"\\\"\"" escapes:0];
+        self.needsSeparator = YES;
+        return YES;
+    }
+
+    if ([value isKindOfClass:[NSNumber class]]) {
+        NSString *literal = [UAJSONWriter literalForNumber:value];
+        if (!literal) {
+            return NO;
+        }
+
+        [self beginValue];
+        [self appendQuotedString:literal escapes:0];
+        self.needsSeparator = YES;
+        return YES;
+    }
+
+    return NO;
+}
+
++ (nullable NSString *)literalForNumber:(NSNumber *)number {
+    if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+        return number.boolValue ? @"true" : @"false";
+    }
+
+    if ([number isKindOfClass:[NSDecimalNumber class]]) {
+        return [number isEqualToNumber:[NSDecimalNumber notANumber]] ? nil : number.stringValue;
+    }
+
+    const char *type = number.objCType;
+    BOOL isFloat = strcmp(type, @encode(float)) == 0;
+    if (!isFloat && strcmp(type, @encode(double)) != 0) {
+        return number.stringValue;
+    }
+
+    double value = number.doubleValue;
+    if (!isfinite(value)) {
+        return nil;
+    }
+
+    // Shortest precision that reads back as the same value, stringValue rounds to 15 digits
+    char literal[32];
+    for (int precision = isFloat ? 6 : 15; precision <= 17; precision++) {
+        snprintf(literal, sizeof(literal), "%.*g", precision, value);
+        if (isFloat ? strtof(literal, NULL) == (float)value : strtod(literal, NULL) == value) {
+            break;
+        }
+    }
+
+    return [NSString stringWithUTF8String:literal];
+}
+
+#pragma mark -
+#pragma mark Buffer
+
+- (void)appendByte:(char)byte {
+    [self.buffer appendBytes:&byte length:1];
+}
+
+- (void)appendQuotedString:(NSString *)string escapes:(NSUInteger)escapes {
+    [self appendByte:'"'];
+    [self appendString:string escapes:escapes];
+    [self appendByte:'"'];
+}
+
+/**
+ * Appends a string as UTF-8, escaping it the given number of times. Runs of characters that do
+ * not need escaping are copied straight into the buffer.
+ */
+- (void)appendString:(NSString *)string escapes:(NSUInteger)escapes {
+    static NSCharacterSet *escapeCharacters;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableCharacterSet *characters = [NSMutableCharacterSet characterSetWithRange:NSMakeRange(0, 0x20)];
+        [characters addCharactersInString:@"\"\\"];
+        escapeCharacters = [characters copy];
+    });
+
+    NSUInteger length = string.length;
+    NSUInteger location = 0;
+
+    while (location < length) {
+        NSRange searchRange = NSMakeRange(location, length - location);
+        NSRange escapeRange = escapes ? [string rangeOfCharacterFromSet:escapeCharacters options:NSLiteralSearch range:searchRange] : NSMakeRange(NSNotFound, 0);
+        NSUInteger end = escapeRange.location == NSNotFound ? length : escapeRange.location;
+
+        [self appendUTF8FromString:string range:NSMakeRange(location, end - location)];
+
+        if (end == length) {
+            break;
+        }
+
+        [self appendCharacter:[string characterAtIndex:end] escapes:escapes];
+        location = end + 1;
+    }
+}
+
+- (void)appendUTF8FromString:(NSString *)string range:(NSRange)range {
+    if (!range.length) {
+        return;
+    }
+
+    // A UTF-16 code unit never takes more than 3 bytes in UTF-8
+    NSUInteger offset = self.buffer.length;
+    self.buffer.length = offset + range.length * 3;
+
+    NSUInteger usedLength = 0;
+    [string getBytes:(uint8_t *)self.buffer.mutableBytes + offset
+           maxLength:self.buffer.length - offset
+          usedLength:&usedLength
+            encoding:NSUTF8StringEncoding
+             options:0
+               range:range
+      remainingRange:NULL];
+
+    self.buffer.length = offset + usedLength;
+}
+
+/**
+ * Appends an ASCII character escaped the given number of times.
+ */
+- (void)appendCharacter:(unichar)character escapes:(NSUInteger)escapes {
+    if (!escapes || !UAJSONNeedsEscape(character)) {
+        [self appendByte:(char)character];
+        return;
+    }
+
+    char sequence[7];
+    switch (character) {
+        case '"':
+            strcpy(sequence, "\\\"");
+            break;
+        case '\\':
+            strcpy(sequence, "\\\\");
+            break;
+        case '\n':
+            strcpy(sequence, "\\n");
+            break;
+        case '\r':
+            strcpy(sequence, "\\r");
+            break;
+        case '\t':
+            strcpy(sequence, "\\t");
+            break;
+        case '\b':
+            strcpy(sequence, "\\b");
+            break;
+        case '\f':
+            strcpy(sequence, "\\f");
+            break;
+        default:
+            snprintf(sequence, sizeof(sequence), "\\u%04x", character);
+            break;
+    }
+
+    for (char *c = sequence; *c; c++) {
+        [self appendCharacter:(unichar)*c escapes:escapes - 1];
+    }
+}
+
+@end
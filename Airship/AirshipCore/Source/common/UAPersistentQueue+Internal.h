@@ -6,9 +6,14 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * A queue which serializes to a preference data store objects that conform to the
- * NSCoding protocol. Useful for sequentially feeding data to API clients, or other
- * queue-like operations that also require persistence.
+ * A persistent queue of objects that conform to the NSCoding protocol. Useful for
+ * sequentially feeding data to API clients, or other queue-like operations that also
+ * require persistence.
+ *
+ * Objects are stored in an append-only log file so adding and popping objects are O(1).
+ * The log's file name is derived from the data store's key prefix and the queue's key.
+ * Objects previously archived in the data store are migrated to the log on first use,
+ * and the log is emptied if the data store has been cleared since it was last used.
  */
 @interface UAPersistentQueue : NSObject
 
@@ -17,6 +22,7 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * @param dataStore A preference dataStore.
  * @param key A key string used to differentiate the queue in the data store.
+ * @return A persistent queue.
  */
 + (instancetype)persistentQueueWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key;
 
@@ -67,6 +73,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)clear;
 
+/**
+ * The URL of the log file for a queue.
+ *
+ * @param dataStore The preference data store.
+ * @param key The queue's key.
+ * @return The log file URL, or nil if the log directory is unavailable.
+ */
++ (nullable NSURL *)logURLWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key;
+
 @end
 
 NS_ASSUME_NONNULL_END
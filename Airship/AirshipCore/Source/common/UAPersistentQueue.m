@@ -1,10 +1,21 @@
 /* Copyright Airship and Contributors */
 
 #import "UAPersistentQueue+Internal.h"
+#import "UAPersistentQueueLog+Internal.h"
+#import "UAUtils.h"
+#import "UAGlobal.h"
+
+// Data store key suffix for the name of the queue's log file, set once the log is in use
+NSString *const UAPersistentQueueLogFileKeySuffix = @"_log_file";
+
+// Directory for queue log files, relative to the library directory
+NSString *const UAPersistentQueueLogDirectory = @"com.urbanairship.no-backup/queues";
 
 @interface UAPersistentQueue ()
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, copy) NSString *key;
+@property (nonatomic, strong, nullable) UAPersistentQueueLog *log;
+@property (nonatomic, assign) BOOL logLoaded;
 @end
 
 @implementation UAPersistentQueue
@@ -25,77 +36,201 @@
 }
 
 - (void)addObject:(id<NSCoding>)object {
-    @synchronized(self) {
-        NSMutableArray<id<NSCoding>> *objects = [[self objects] mutableCopy];
-        [objects addObject:object];
-        [self setObjects:objects];
-    }
+    [self addObjects:@[object]];
 }
 
 - (void)addObjects:(NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSArray<id<NSCoding>> *newObjects = [self objects];
-        newObjects = [newObjects arrayByAddingObjectsFromArray:objects];
-        [self setObjects:newObjects];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (!log) {
+            [self setLegacyObjects:[[self legacyObjects] arrayByAddingObjectsFromArray:objects]];
+            return;
+        }
+
+        [log appendRecords:[UAPersistentQueue recordsWithObjects:objects]];
     }
 }
 
 - (nullable id<NSCoding>)peekObject {
     @synchronized(self) {
-        NSArray<id<NSCoding>> *objects = [self objects];
-
-        if (!objects.count) {
-            return nil;
+        UAPersistentQueueLog *log = [self queueLog];
+        if (!log) {
+            return [self legacyObjects].firstObject;
         }
 
-        return objects[0];
+        NSData *record = [log peekRecord];
+        return record ? [NSKeyedUnarchiver unarchiveObjectWithData:record] : nil;
     }
 }
 
 - (nullable id<NSCoding>)popObject {
     @synchronized(self) {
-        NSMutableArray<id<NSCoding>> *objects = [[self objects] mutableCopy];
-
-        if (!objects.count) {
-            return nil;
+        UAPersistentQueueLog *log = [self queueLog];
+        if (!log) {
+            NSMutableArray<id<NSCoding>> *objects = [[self legacyObjects] mutableCopy];
+            if (!objects.count) {
+                return nil;
+            }
+
+            id<NSCoding> object = objects[0];
+            [objects removeObjectAtIndex:0];
+            [self setLegacyObjects:objects];
+            return object;
         }
 
-        id<NSCoding> object = objects[0];
-        [objects removeObjectAtIndex:0];
-
-        if (objects.count) {
-            [self setObjects:objects];
-        } else {
-            [self clear];
-        }
-
-        return object;
+        NSData *record = [log popRecord];
+        return record ? [NSKeyedUnarchiver unarchiveObjectWithData:record] : nil;
     }
 }
 
 - (NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSData *encodedItems = [self.dataStore objectForKey:self.key];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (!log) {
+            return [self legacyObjects];
+        }
 
-        if (!encodedItems) {
-            return @[];
+        NSMutableArray<id<NSCoding>> *objects = [NSMutableArray arrayWithCapacity:log.count];
+        for (NSData *record in [log records]) {
+            id<NSCoding> object = [NSKeyedUnarchiver unarchiveObjectWithData:record];
+            if (object) {
+                [objects addObject:object];
+            }
         }
 
-        return [NSKeyedUnarchiver unarchiveObjectWithData:encodedItems];
+        return objects;
     }
 }
 
 - (void)setObjects:(NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSData *encodedObjects = [NSKeyedArchiver archivedDataWithRootObject:objects];
-        [self.dataStore setObject:encodedObjects forKey:self.key];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (!log) {
+            [self setLegacyObjects:objects];
+            return;
+        }
+
+        [log replaceRecords:[UAPersistentQueue recordsWithObjects:objects]];
     }
 }
 
 - (void)clear {
     @synchronized(self) {
+        UAPersistentQueueLog *log = [self queueLog];
+        if (!log) {
+            [self.dataStore removeObjectForKey:self.key];
+            return;
+        }
+
+        [log removeAllRecords];
+    }
+}
+
+#pragma mark -
+#pragma mark Log
+
+/**
+ * Lazily opens the queue's log, migrating any objects stored under the data store key.
+ *
+ * @return The log, or nil if the log file is unavailable and the data store should be used instead.
+ */
+- (nullable UAPersistentQueueLog *)queueLog {
+    if (self.logLoaded) {
+        return self.log;
+    }
+
+    self.logLoaded = YES;
+
+    NSURL *logURL = [UAPersistentQueue logURLWithDataStore:self.dataStore key:self.key];
+    if (!logURL) {
+        return nil;
+    }
+
+    UAPersistentQueueLog *log = [UAPersistentQueueLog logWithURL:logURL];
+    if (!log) {
+        return nil;
+    }
+
+    // The file name is only recorded once the log is in use, so clearing the data store also discards the queue
+    NSString *fileNameKey = [self.key stringByAppendingString:UAPersistentQueueLogFileKeySuffix];
+    NSString *fileName = logURL.lastPathComponent;
+    if (![[self.dataStore stringForKey:fileNameKey] isEqualToString:fileName]) {
+        // Replace whatever a cleared data store or an interrupted migration left in the file. The data store
+        // key is only removed once the file name is stored, so an interrupted migration runs again.
+        NSArray<id<NSCoding>> *legacyObjects = [self legacyObjects];
+        if (![log replaceRecords:[UAPersistentQueue recordsWithObjects:legacyObjects]]) {
+            return nil;
+        }
+
+        [self.dataStore setObject:fileName forKey:fileNameKey];
         [self.dataStore removeObjectForKey:self.key];
     }
+
+    self.log = log;
+    return log;
+}
+
++ (nullable NSURL *)logURLWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key {
+    NSURL *directory = [UAPersistentQueue logDirectory];
+    if (!directory) {
+        return nil;
+    }
+
+    // Derived from the prefixed key so each queue always maps to the same file
+    NSString *fileName = [UAUtils sha256HashWithString:[dataStore.keyPrefix stringByAppendingString:key]];
+    return [directory URLByAppendingPathComponent:fileName];
+}
+
++ (nullable NSURL *)logDirectory {
+    static NSURL *directory;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        NSURL *libraryDirectoryURL = [[fileManager URLsForDirectory:NSLibraryDirectory inDomains:NSUserDomainMask] lastObject];
+        NSURL *url = [libraryDirectoryURL URLByAppendingPathComponent:UAPersistentQueueLogDirectory isDirectory:YES];
+
+        NSError *error;
+        if (![fileManager createDirectoryAtURL:url withIntermediateDirectories:YES attributes:nil error:&error]) {
+            UA_LERR(@"Unable to create persistent queue directory: %@", error);
+            return;
+        }
+
+        [UAUtils addSkipBackupAttributeToItemAtURL:url];
+        directory = url;
+    });
+
+    return directory;
+}
+
++ (NSArray<NSData *> *)recordsWithObjects:(NSArray<id<NSCoding>> *)objects {
+    NSMutableArray<NSData *> *records = [NSMutableArray arrayWithCapacity:objects.count];
+    for (id<NSCoding> object in objects) {
+        [records addObject:[NSKeyedArchiver archivedDataWithRootObject:object]];
+    }
+    return records;
+}
+
+#pragma mark -
+#pragma mark Data store
+
+- (NSArray<id<NSCoding>> *)legacyObjects {
+    NSData *encodedItems = [self.dataStore objectForKey:self.key];
+
+    if (!encodedItems) {
+        return @[];
+    }
+
+    return [NSKeyedUnarchiver unarchiveObjectWithData:encodedItems] ?: @[];
+}
+
+- (void)setLegacyObjects:(NSArray<id<NSCoding>> *)objects {
+    if (!objects.count) {
+        [self.dataStore removeObjectForKey:self.key];
+        return;
+    }
+
+    NSData *encodedObjects = [NSKeyedArchiver archivedDataWithRootObject:objects];
+    [self.dataStore setObject:encodedObjects forKey:self.key];
 }
 
 @end
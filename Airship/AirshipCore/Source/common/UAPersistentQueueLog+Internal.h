@@ -0,0 +1,90 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * An append-only file of length-prefixed records, read from a persisted head offset.
+ *
+ * Appends write to the end of the file and pops only move the head offset, so both
+ * are O(1). Consumed records are reclaimed by compacting the file once they make up
+ * most of it, or by truncating it once the log is empty. The file is synced after
+ * every change, and a partially written record left by a crash is discarded when the
+ * log is opened.
+ *
+ * Instances are not thread safe.
+ */
+@interface UAPersistentQueueLog : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Persistent Queue Log Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The number of records in the log.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ * The log's file URL.
+ */
+@property (nonatomic, readonly) NSURL *URL;
+
+///---------------------------------------------------------------------------------------
+/// @name Persistent Queue Log Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Opens the log at the given URL, creating it if it does not exist.
+ *
+ * @param URL The file URL.
+ * @return The log, or nil if the file could not be opened.
+ */
++ (nullable instancetype)logWithURL:(NSURL *)URL;
+
+/**
+ * Appends records to the end of the log.
+ *
+ * @param records The records.
+ * @return YES if the records were written, otherwise NO.
+ */
+- (BOOL)appendRecords:(NSArray<NSData *> *)records;
+
+/**
+ * Reads the first record.
+ *
+ * @return The first record, or nil if the log is empty.
+ */
+- (nullable NSData *)peekRecord;
+
+/**
+ * Reads and removes the first record.
+ *
+ * @return The first record, or nil if the log is empty.
+ */
+- (nullable NSData *)popRecord;
+
+/**
+ * Reads all records.
+ *
+ * @return The records.
+ */
+- (NSArray<NSData *> *)records;
+
+/**
+ * Atomically replaces the log's records.
+ *
+ * @param records The records.
+ * @return YES if the records were written, otherwise NO.
+ */
+- (BOOL)replaceRecords:(NSArray<NSData *> *)records;
+
+/**
+ * Removes all records.
+ */
+- (void)removeAllRecords;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,352 @@
+/* Copyright Airship and Contributors */
+
+#import <fcntl.h>
+#import <unistd.h>
+#import <sys/stat.h>
+
+#import "UAPersistentQueueLog+Internal.h"
+#import "UAGlobal.h"
+
+// File layout: a header followed by records.
+// Header: 4 byte magic, 4 reserved bytes, 8 byte head offset (little endian).
+// Record: 4 byte length (little endian) followed by the record bytes.
+static const uint32_t UAPersistentQueueLogMagic = 0x31514155; // "UAQ1"
+static const off_t UAPersistentQueueLogHeaderSize = 16;
+static const off_t UAPersistentQueueLogHeadPosition = 8;
+static const off_t UAPersistentQueueLogLengthSize = sizeof(uint32_t);
+
+// Consumed bytes required before the log is compacted
+static const off_t UAPersistentQueueLogCompactionThreshold = 64 * 1024;
+
+@interface UAPersistentQueueLog ()
+@property (nonatomic, strong) NSURL *URL;
+@property (nonatomic, assign) int fd;
+@property (nonatomic, assign) off_t head;
+@property (nonatomic, assign) off_t end;
+@property (nonatomic, assign) NSUInteger count;
+@end
+
+@implementation UAPersistentQueueLog
+
+- (nullable instancetype)initWithURL:(NSURL *)URL {
+    self = [super init];
+
+    if (self) {
+        self.URL = URL;
+        self.fd = -1;
+
+        if (![self openFile]) {
+            return nil;
+        }
+    }
+
+    return self;
+}
+
++ (nullable instancetype)logWithURL:(NSURL *)URL {
+    return [[self alloc] initWithURL:URL];
+}
+
+- (void)dealloc {
+    if (self.fd >= 0) {
+        close(self.fd);
+    }
+}
+
+#pragma mark -
+#pragma mark Records
+
+- (BOOL)appendRecords:(NSArray<NSData *> *)records {
+    if (!records.count) {
+        return YES;
+    }
+
+    NSMutableData *data = [NSMutableData data];
+    for (NSData *record in records) {
+        [UAPersistentQueueLog appendRecord:record toData:data];
+    }
+
+    if (![self writeData:data toFD:self.fd offset:self.end] || fsync(self.fd) != 0) {
+        UA_LERR(@"Unable to append to queue log %@: %s", self.URL.lastPathComponent, strerror(errno));
+
+        // Drop anything partially written
+        ftruncate(self.fd, self.end);
+        return NO;
+    }
+
+    self.end += (off_t)data.length;
+    self.count += records.count;
+    return YES;
+}
+
+- (nullable NSData *)peekRecord {
+    if (!self.count) {
+        return nil;
+    }
+
+    return [self readRecordAtOffset:self.head];
+}
+
+- (nullable NSData *)popRecord {
+    if (!self.count) {
+        return nil;
+    }
+
+    NSData *record = [self readRecordAtOffset:self.head];
+    if (!record) {
+        return nil;
+    }
+
+    // Truncate instead of moving the head once the log is empty
+    if (self.count == 1 && [self resetFile]) {
+        return record;
+    }
+
+    off_t head = self.head + UAPersistentQueueLogLengthSize + (off_t)record.length;
+    if (![self writeHead:head]) {
+        return nil;
+    }
+
+    self.head = head;
+    self.count--;
+
+    [self compactIfNeeded];
+    return record;
+}
+
+- (NSArray<NSData *> *)records {
+    if (!self.count) {
+        return @[];
+    }
+
+    NSData *data = [self readDataAtOffset:self.head length:(NSUInteger)(self.end - self.head)];
+    if (!data) {
+        return @[];
+    }
+
+    NSMutableArray<NSData *> *records = [NSMutableArray arrayWithCapacity:self.count];
+    NSUInteger offset = 0;
+    while (offset + sizeof(uint32_t) <= data.length) {
+        uint32_t length;
+        [data getBytes:&length range:NSMakeRange(offset, sizeof(length))];
+        length = CFSwapInt32LittleToHost(length);
+        offset += sizeof(length);
+
+        [records addObject:[data subdataWithRange:NSMakeRange(offset, length)]];
+        offset += length;
+    }
+
+    return records;
+}
+
+- (BOOL)replaceRecords:(NSArray<NSData *> *)records {
+    NSMutableData *data = [NSMutableData data];
+    for (NSData *record in records) {
+        [UAPersistentQueueLog appendRecord:record toData:data];
+    }
+
+    return [self replaceFileWithRecordData:data count:records.count];
+}
+
+- (void)removeAllRecords {
+    [self resetFile];
+}
+
+#pragma mark -
+#pragma mark File
+
+- (BOOL)openFile {
+    self.fd = open(self.URL.fileSystemRepresentation, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (self.fd < 0) {
+        UA_LERR(@"Unable to open queue log %@: %s", self.URL.lastPathComponent, strerror(errno));
+        return NO;
+    }
+
+    struct stat info;
+    if (fstat(self.fd, &info) != 0) {
+        UA_LERR(@"Unable to read queue log %@: %s", self.URL.lastPathComponent, strerror(errno));
+        return NO;
+    }
+
+    NSData *header = [self readDataAtOffset:0 length:UAPersistentQueueLogHeaderSize];
+    uint32_t magic = 0;
+    uint64_t head = 0;
+    [header getBytes:&magic range:NSMakeRange(0, sizeof(magic))];
+    [header getBytes:&head range:NSMakeRange(UAPersistentQueueLogHeadPosition, sizeof(head))];
+    head = CFSwapInt64LittleToHost(head);
+
+    if (!header || CFSwapInt32LittleToHost(magic) != UAPersistentQueueLogMagic ||
+        head < (uint64_t)UAPersistentQueueLogHeaderSize || head > (uint64_t)info.st_size) {
+        return [self resetFile];
+    }
+
+    self.head = (off_t)head;
+    [self recoverWithFileSize:info.st_size];
+    return YES;
+}
+
+/**
+ * Counts the records after the head, truncating a partially written record at the end.
+ *
+ * @param fileSize The file size.
+ */
+- (void)recoverWithFileSize:(off_t)fileSize {
+    off_t offset = self.head;
+    NSUInteger count = 0;
+
+    while (offset + UAPersistentQueueLogLengthSize <= fileSize) {
+        uint32_t length;
+        if (pread(self.fd, &length, sizeof(length), offset) != sizeof(length)) {
+            break;
+        }
+
+        off_t next = offset + UAPersistentQueueLogLengthSize + CFSwapInt32LittleToHost(length);
+        if (next > fileSize) {
+            break;
+        }
+
+        offset = next;
+        count++;
+    }
+
+    if (offset != fileSize) {
+        UA_LDEBUG(@"Discarding %lld bytes of incomplete records in queue log %@", (long long)(fileSize - offset), self.URL.lastPathComponent);
+        ftruncate(self.fd, offset);
+        fsync(self.fd);
+    }
+
+    self.end = offset;
+    self.count = count;
+}
+
+- (BOOL)resetFile {
+    return [self replaceFileWithRecordData:[NSData data] count:0];
+}
+
+/**
+ * Writes the records to a temporary file and atomically moves it into place.
+ *
+ * @param data The encoded records.
+ * @param count The number of records.
+ * @return YES if the file was replaced, otherwise NO.
+ */
+- (BOOL)replaceFileWithRecordData:(NSData *)data count:(NSUInteger)count {
+    NSURL *tempURL = [self.URL URLByAppendingPathExtension:@"tmp"];
+
+    int fd = open(tempURL.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        UA_LERR(@"Unable to create queue log %@: %s", tempURL.lastPathComponent, strerror(errno));
+        return NO;
+    }
+
+    NSMutableData *file = [NSMutableData dataWithCapacity:(NSUInteger)UAPersistentQueueLogHeaderSize + data.length];
+    [file appendData:[UAPersistentQueueLog headerWithHead:UAPersistentQueueLogHeaderSize]];
+    [file appendData:data];
+
+    if (![self writeData:file toFD:fd offset:0] || fsync(fd) != 0 ||
+        rename(tempURL.fileSystemRepresentation, self.URL.fileSystemRepresentation) != 0) {
+        UA_LERR(@"Unable to write queue log %@: %s", self.URL.lastPathComponent, strerror(errno));
+        close(fd);
+        unlink(tempURL.fileSystemRepresentation);
+        return NO;
+    }
+
+    if (self.fd >= 0) {
+        close(self.fd);
+    }
+
+    self.fd = fd;
+    self.head = UAPersistentQueueLogHeaderSize;
+    self.end = (off_t)file.length;
+    self.count = count;
+    return YES;
+}
+
+/**
+ * Rewrites the log without its consumed records once they make up most of the file.
+ */
+- (void)compactIfNeeded {
+    off_t consumed = self.head - UAPersistentQueueLogHeaderSize;
+    if (consumed < UAPersistentQueueLogCompactionThreshold || consumed < self.end - self.head) {
+        return;
+    }
+
+    NSData *data = [self readDataAtOffset:self.head length:(NSUInteger)(self.end - self.head)];
+    if (data) {
+        UA_LTRACE(@"Compacting queue log %@, reclaiming %lld bytes", self.URL.lastPathComponent, (long long)consumed);
+        [self replaceFileWithRecordData:data count:self.count];
+    }
+}
+
+- (BOOL)writeHead:(off_t)head {
+    NSData *header = [UAPersistentQueueLog headerWithHead:head];
+    NSData *headData = [header subdataWithRange:NSMakeRange(UAPersistentQueueLogHeadPosition, sizeof(uint64_t))];
+
+    if (![self writeData:headData toFD:self.fd offset:UAPersistentQueueLogHeadPosition] || fsync(self.fd) != 0) {
+        UA_LERR(@"Unable to update queue log %@: %s", self.URL.lastPathComponent, strerror(errno));
+        return NO;
+    }
+
+    return YES;
+}
+
+- (nullable NSData *)readRecordAtOffset:(off_t)offset {
+    uint32_t length;
+    if (pread(self.fd, &length, sizeof(length), offset) != sizeof(length)) {
+        UA_LERR(@"Unable to read queue log %@: %s", self.URL.lastPathComponent, strerror(errno));
+        return nil;
+    }
+
+    return [self readDataAtOffset:offset + UAPersistentQueueLogLengthSize length:CFSwapInt32LittleToHost(length)];
+}
+
+- (nullable NSData *)readDataAtOffset:(off_t)offset length:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    NSUInteger total = 0;
+
+    while (total < length) {
+        ssize_t result = pread(self.fd, (uint8_t *)data.mutableBytes + total, length - total, offset + (off_t)total);
+        if (result <= 0) {
+            return nil;
+        }
+        total += (NSUInteger)result;
+    }
+
+    return data;
+}
+
+- (BOOL)writeData:(NSData *)data toFD:(int)fd offset:(off_t)offset {
+    NSUInteger total = 0;
+
+    while (total < data.length) {
+        ssize_t result = pwrite(fd, (const uint8_t *)data.bytes + total, data.length - total, offset + (off_t)total);
+        if (result < 0) {
+            return NO;
+        }
+        total += (NSUInteger)result;
+    }
+
+    return YES;
+}
+
+#pragma mark -
+#pragma mark Encoding
+
++ (NSData *)headerWithHead:(off_t)head {
+    NSMutableData *header = [NSMutableData dataWithLength:UAPersistentQueueLogHeaderSize];
+
+    uint32_t magic = CFSwapInt32HostToLittle(UAPersistentQueueLogMagic);
+    uint64_t littleHead = CFSwapInt64HostToLittle((uint64_t)head);
+    [header replaceBytesInRange:NSMakeRange(0, sizeof(magic)) withBytes:&magic];
+    [header replaceBytesInRange:NSMakeRange(UAPersistentQueueLogHeadPosition, sizeof(littleHead)) withBytes:&littleHead];
+
+    return header;
+}
+
++ (void)appendRecord:(NSData *)record toData:(NSMutableData *)data {
+    uint32_t length = CFSwapInt32HostToLittle((uint32_t)record.length);
+    [data appendBytes:&length length:sizeof(length)];
+    [data appendData:record];
+}
+
+@end
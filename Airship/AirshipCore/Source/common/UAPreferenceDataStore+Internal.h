@@ -7,6 +7,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface UAPreferenceDataStore ()
 
+///---------------------------------------------------------------------------------------
+/// @name Preference Data Store Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The prefix applied to all keys.
+ */
+@property (nonatomic, readonly, copy) NSString *keyPrefix;
+
 ///---------------------------------------------------------------------------------------
 /// @name Preference Data Store Internal Methods
 ///---------------------------------------------------------------------------------------
@@ -263,7 +263,7 @@ completionHandler:(void(^)(BOOL success))completionHandler {
     NSArray<UARemoteDataPayload *> *payloads = [UARemoteDataPayload remoteDataPayloadsFromJSON:remoteData metadata:metadata];
 
     UA_WEAKIFY(self);
-    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:payloads completionHandler:^(BOOL success) {
+    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:payloads completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
         UA_STRONGIFY(self);
         if (!success) {
             [self.remoteDataAPIClient clearLastModifiedTime];
@@ -277,7 +277,7 @@ completionHandler:(void(^)(BOOL success))completionHandler {
         self.lastMetadata = metadata;
 
         // notify remote data subscribers
-        [self notifySubscribersWithRemoteData:payloads completionHandler:^{
+        [self notifySubscribersWithRemoteData:payloads changedTypes:changedTypes completionHandler:^{
             if (completionHandler) {
                 completionHandler(YES);
             }
@@ -349,18 +349,28 @@ completionHandler:(void(^)(BOOL success))completionHandler {
 }
 
 /**
- * Notifies all subscriptions of new remote data
+ * Notifies subscriptions of new remote data. Only subscriptions to at least one changed type are notified.
  *
  * @param remoteDataPayloads Remote data from which to notify subscribers. Data must be filtered for each subscriber.
+ * @param changedTypes The payload types that changed.
  * @param completionHandler Optional completion handler.
  */
-- (void)notifySubscribersWithRemoteData:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(void))completionHandler {
-    NSArray *subscriptions = [self.subscriptions copy];
+- (void)notifySubscribersWithRemoteData:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                           changedTypes:(NSSet<NSString *> *)changedTypes
+                      completionHandler:(void (^)(void))completionHandler {
+    NSArray *subscriptions;
+    @synchronized(self.subscriptions) {
+        subscriptions = [self.subscriptions copy];
+    }
 
     dispatch_group_t dispatchGroup = dispatch_group_create();
 
     // notify each subscription
     for (UARemoteDataSubscription *subscription in subscriptions) {
+        if (![changedTypes intersectsSet:[NSSet setWithArray:subscription.payloadTypes]]) {
+            continue;
+        }
+
         dispatch_group_enter(dispatchGroup);
 
         NSPredicate *predicate = [NSPredicate predicateWithFormat:@"(type IN %@)", subscription.payloadTypes];
@@ -40,12 +40,16 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Updates the remote data store with the array of remote data.
  *
+ * Payloads are diffed per type against the stored payloads using their timestamps and
+ * metadata. Only the types that changed are rewritten, and types missing from the
+ * response are removed.
+ *
  * @param remoteDataPayloads An array of remote data as JSON
- * @param completionHandler The completion handler with the sync result.
+ * @param completionHandler The completion handler with the sync result and the changed payload types.
  *
  */
 - (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
-                 completionHandler:(void(^)(BOOL))completionHandler;
+                            completionHandler:(void(^)(BOOL success, NSSet<NSString *> *changedTypes))completionHandler;
 
 /**
  * Fetches remote data with a specified predicate on the background context.
@@ -104,27 +104,124 @@
 }
 
 - (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
-                 completionHandler:(void(^)(BOOL))completionHandler {
+                            completionHandler:(void(^)(BOOL, NSSet<NSString *> *))completionHandler {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
-            completionHandler(NO);
+            completionHandler(NO, [NSSet set]);
             return;
         }
-        
-        // Delete all stored remote data
+
+        NSMutableDictionary<NSString *, NSMutableArray<UARemoteDataPayload *> *> *payloadsByType = [NSMutableDictionary dictionary];
+        for (UARemoteDataPayload *payload in remoteDataPayloads) {
+            if (!payloadsByType[payload.type]) {
+                payloadsByType[payload.type] = [NSMutableArray array];
+            }
+            [payloadsByType[payload.type] addObject:payload];
+        }
+
+        // Only fetch the fields needed to diff, the data can be large
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUARemoteDataDBEntityName];
-        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
+        request.resultType = NSDictionaryResultType;
+        request.propertiesToFetch = @[@"type", @"timestamp", @"metadata"];
+
         NSError *error;
-        [self.managedContext executeRequest:deleteRequest error:&error];
+        NSArray<NSDictionary *> *storedPayloads = [self.managedContext executeFetchRequest:request error:&error];
+        if (error) {
+            UA_LERR(@"Error fetching remote data: %@", error);
+            completionHandler(NO, [NSSet set]);
+            return;
+        }
+
+        NSMutableDictionary<NSString *, NSMutableArray<NSDictionary *> *> *storedPayloadsByType = [NSMutableDictionary dictionary];
+        for (NSDictionary *storedPayload in storedPayloads) {
+            NSString *type = storedPayload[@"type"] ?: @"";
+            if (!storedPayloadsByType[type]) {
+                storedPayloadsByType[type] = [NSMutableArray array];
+            }
+            [storedPayloadsByType[type] addObject:storedPayload];
+        }
+
+        NSMutableSet<NSString *> *changedTypes = [NSMutableSet set];
+        NSMutableSet<NSString *> *allTypes = [NSMutableSet setWithArray:payloadsByType.allKeys];
+        [allTypes addObjectsFromArray:storedPayloadsByType.allKeys];
 
-        for (UARemoteDataPayload *remoteDataPayload in remoteDataPayloads) {
-            [self addRemoteDataStorePayloadFromRemoteData:remoteDataPayload];
+        for (NSString *type in allTypes) {
+            if (![UARemoteDataStore storedPayloads:storedPayloadsByType[type] matchPayloads:payloadsByType[type]]) {
+                [changedTypes addObject:type];
+            }
         }
-        
-        completionHandler([self.managedContext safeSave]);
+
+        if (!changedTypes.count) {
+            UA_LTRACE(@"Remote data unchanged");
+            completionHandler(YES, changedTypes);
+            return;
+        }
+
+        UA_LTRACE(@"Remote data changed for types: %@", changedTypes);
+
+        // Replace the changed types
+        [self deleteRemoteDataStorePayloadsWithTypes:changedTypes];
+        for (NSString *type in changedTypes) {
+            for (UARemoteDataPayload *payload in payloadsByType[type]) {
+                [self addRemoteDataStorePayloadFromRemoteData:payload];
+            }
+        }
+
+        completionHandler([self.managedContext safeSave], changedTypes);
     }];
 }
 
+/**
+ * Checks if the stored payloads of a type match the new payloads of the same type. Payloads
+ * are matched on their timestamps and metadata, since a payload's timestamp changes whenever its
+ * data changes.
+ *
+ * @param storedPayloads The stored payload properties.
+ * @param payloads The new payloads.
+ * @return YES if the payloads match, otherwise NO.
+ */
++ (BOOL)storedPayloads:(nullable NSArray<NSDictionary *> *)storedPayloads matchPayloads:(nullable NSArray<UARemoteDataPayload *> *)payloads {
+    if (storedPayloads.count != payloads.count) {
+        return NO;
+    }
+
+    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"timestamp" ascending:YES];
+    NSArray<NSDictionary *> *sortedStoredPayloads = [storedPayloads sortedArrayUsingDescriptors:@[sortDescriptor]];
+    NSArray<UARemoteDataPayload *> *sortedPayloads = [payloads sortedArrayUsingDescriptors:@[sortDescriptor]];
+
+    for (NSUInteger i = 0; i < sortedPayloads.count; i++) {
+        NSDictionary *storedPayload = sortedStoredPayloads[i];
+        UARemoteDataPayload *payload = sortedPayloads[i];
+
+        if (![storedPayload[@"timestamp"] isEqualToDate:payload.timestamp]) {
+            return NO;
+        }
+
+        id storedMetadata = storedPayload[@"metadata"];
+        if ((storedMetadata || payload.metadata) && ![storedMetadata isEqual:payload.metadata]) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+- (void)deleteRemoteDataStorePayloadsWithTypes:(NSSet<NSString *> *)types {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUARemoteDataDBEntityName];
+    request.predicate = [NSPredicate predicateWithFormat:@"type IN %@", types];
+    request.includesPropertyValues = NO;
+
+    NSError *error;
+    NSArray<UARemoteDataStorePayload *> *result = [self.managedContext executeFetchRequest:request error:&error];
+    if (error) {
+        UA_LERR(@"Error fetching remote data: %@", error);
+        return;
+    }
+
+    for (UARemoteDataStorePayload *payload in result) {
+        [self.managedContext deleteObject:payload];
+    }
+}
 
 - (void)addRemoteDataStorePayloadFromRemoteData:(UARemoteDataPayload *)remoteDataPayload {
     // create the NSManagedObject
@@ -36,11 +36,24 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, copy, nullable) NSData *body;
 
+/**
+ * A stream providing the request body. The stream is read when the request is built,
+ * and compressed chunk by chunk if compressBody is set. Ignored if body is set.
+ */
+@property (nonatomic, strong, nullable) NSInputStream *bodyStream;
+
 /**
  * Flag to compress the request body using GZIP or not.
  */
 @property (nonatomic, assign) BOOL compressBody;
 
+/**
+ * The GZIP compression level, from 0 (no compression) to 9 (best compression). Lower
+ * levels use less CPU at the cost of a larger body. Defaults to zlib's default level.
+ * Invalid levels are logged and replaced with the default level.
+ */
+@property (nonatomic, assign) NSInteger compressionLevel;
+
 /**
  * Sets a http request header.
  * @param value The header value.
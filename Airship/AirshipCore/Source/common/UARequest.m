@@ -1,12 +1,12 @@
 /* Copyright Airship and Contributors */
 
-#import <zlib.h>
-
 #import "UARequest.h"
 #import "UAirship.h"
 #import "UADisposable.h"
 #import "UARuntimeConfig.h"
 #import "UADelayOperation+Internal.h"
+#import "UAGzipCompressor+Internal.h"
+#import "UAGlobal.h"
 
 @interface UARequestBuilder()
 @property (nonatomic, strong) NSMutableDictionary *headers;
@@ -18,11 +18,21 @@
 
     if (self) {
         self.headers = [NSMutableDictionary dictionary];
+        self.compressionLevel = UAGzipCompressionLevelDefault;
     }
 
     return self;
 }
 
+- (void)setCompressionLevel:(NSInteger)compressionLevel {
+    if (compressionLevel != UAGzipCompressionLevelDefault && (compressionLevel < 0 || compressionLevel > 9)) {
+        UA_LERR(@"Invalid compression level %ld, using the default level.", (long)compressionLevel);
+        compressionLevel = UAGzipCompressionLevelDefault;
+    }
+
+    _compressionLevel = compressionLevel;
+}
+
 - (void)setValue:(id)value forHeader:(NSString *)header {
     [self.headers setValue:value forKey:header];
 }
@@ -66,12 +76,24 @@
         }
 
         if (builder.body) {
-            if (builder.compressBody) {
-                self.body = [UARequest gzipCompress:builder.body];
+            NSData *compressed = builder.compressBody ? [UAGzipCompressor compressData:builder.body level:builder.compressionLevel] : nil;
+            if (compressed) {
+                self.body = compressed;
                 headers[@"Content-Encoding"] = @"gzip";
             } else {
+                // Send the body as is if it could not be compressed
                 self.body = builder.body;
             }
+        } else if (builder.bodyStream) {
+            if (builder.compressBody) {
+                // The stream is consumed either way, so a failed compression leaves no body
+                self.body = [UARequest gzipCompressStream:builder.bodyStream level:builder.compressionLevel];
+                if (self.body) {
+                    headers[@"Content-Encoding"] = @"gzip";
+                }
+            } else {
+                self.body = [UARequest dataWithStream:builder.bodyStream];
+            }
         }
 
 
@@ -96,53 +118,28 @@
     return [[UARequest alloc] initWithBuilder:builder];
 }
 
-+ (NSData *)gzipCompress:(NSData *)uncompressedData {
++ (nullable NSData *)gzipCompressStream:(NSInputStream *)stream level:(NSInteger)level {
+    // Stream compressors are not shared since reading the stream can block
+    UAGzipCompressor *compressor = [UAGzipCompressor compressorWithLevel:level];
+    NSData *compressed = [compressor appendStream:stream] ? [compressor finish] : nil;
+    [stream close];
+    return compressed;
+}
 
-    if ([uncompressedData length] == 0) {
-        return nil;
++ (nullable NSData *)dataWithStream:(NSInputStream *)stream {
+    if (stream.streamStatus == NSStreamStatusNotOpen) {
+        [stream open];
     }
 
-    z_stream strm;
-
-    NSUInteger chunkSize = 32768;// 32K chunks
-
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
-    strm.total_out = 0;
-    strm.next_in=(Bytef *)[uncompressedData bytes];
-    strm.avail_in = (uInt)[uncompressedData length];
-
-    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
-        return nil;
+    NSMutableData *data = [NSMutableData data];
+    uint8_t buffer[16384];
+    NSInteger bytesRead;
+    while ((bytesRead = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        [data appendBytes:buffer length:(NSUInteger)bytesRead];
     }
 
-    int status;
-    NSMutableData *compressed = [NSMutableData dataWithLength:chunkSize];
-    do {
-
-        if (strm.total_out >= [compressed length]) {
-            [compressed increaseLengthBy:chunkSize];
-        }
-
-        strm.next_out = [compressed mutableBytes] + strm.total_out;
-        strm.avail_out = (uInt)([compressed length] - strm.total_out);
-
-        status = deflate(&strm, Z_FINISH);
-
-        if (status == Z_STREAM_ERROR) {
-            //error - bail completely
-            deflateEnd(&strm);
-            return nil;
-        }
-
-    } while (strm.avail_out == 0);
-
-    deflateEnd(&strm);
-
-    [compressed setLength: strm.total_out];
-    
-    return compressed;
+    [stream close];
+    return bytesRead < 0 ? nil : data;
 }
 
 @end
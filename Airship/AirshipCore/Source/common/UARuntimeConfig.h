@@ -121,6 +121,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (readonly) BOOL requestAuthorizationToUseNotifications;
 
+/**
+ * The delay in seconds after takeOff before modules that were not used during launch
+ * open their stores and load their data.
+ *
+ * Defaults to `10`.
+ */
+@property (readonly) NSTimeInterval moduleActivationDelay;
+
 ///---------------------------------------------------------------------------------------
 /// @name Resolved Options
 ///---------------------------------------------------------------------------------------
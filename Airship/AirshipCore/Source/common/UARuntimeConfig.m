@@ -21,6 +21,7 @@
 @property (nonatomic, assign, getter=isChannelCreationDelayEnabled) BOOL channelCreationDelayEnabled;
 @property (nonatomic, copy) NSDictionary *customConfig;
 @property (nonatomic, assign) BOOL requestAuthorizationToUseNotifications;
+@property (nonatomic, assign) NSTimeInterval moduleActivationDelay;
 
 @property (nonatomic, copy) NSString *deviceAPIURL;
 @property (nonatomic, copy) NSString *analyticsURL;
@@ -76,6 +77,7 @@ NSString *const UARuntimeConfigEURemoteDataAPIURL = @"https://remote-data.asnapi
         self.channelCreationDelayEnabled = config.channelCreationDelayEnabled;
         self.messageCenterStyleConfig = config.messageCenterStyleConfig;
         self.itunesID = config.itunesID;
+        self.moduleActivationDelay = config.moduleActivationDelay;
     }
 
     return self;
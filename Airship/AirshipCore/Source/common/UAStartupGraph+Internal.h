@@ -0,0 +1,84 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A dependency graph of startup tasks.
+ *
+ * Tasks start as soon as all of their dependencies have finished. Background tasks run
+ * concurrently at user initiated QoS, since launch waits on them, and main thread tasks run
+ * on the thread that runs the graph. Each task is timed, and traced as a signpost interval in the
+ * `com.urbanairship` subsystem's `Startup` category so launch time can be profiled.
+ *
+ * Background tasks must not block on the main thread, since the main thread is waiting for them.
+ */
+@interface UAStartupGraph : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Startup Graph Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The time each task took to run, in seconds, keyed by task name. Populated by `run`.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSNumber *> *taskDurations;
+
+///---------------------------------------------------------------------------------------
+/// @name Startup Graph Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @return A startup graph.
+ */
++ (instancetype)startupGraph;
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param backgroundQueue The queue for background tasks.
+ * @return A startup graph.
+ */
++ (instancetype)startupGraphWithBackgroundQueue:(dispatch_queue_t)backgroundQueue;
+
+///---------------------------------------------------------------------------------------
+/// @name Startup Graph Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Emits a signpost event in the startup log, for marking milestones such as Airship ready.
+ *
+ * @param name The event name.
+ */
++ (void)traceEvent:(NSString *)name;
+
+/**
+ * Adds a task that may run on a background thread.
+ *
+ * @param name The task name. Must be unique.
+ * @param dependencies The names of the tasks that must finish first.
+ * @param block The task block.
+ */
+- (void)addTask:(NSString *)name dependencies:(NSArray<NSString *> *)dependencies block:(void (^)(void))block;
+
+/**
+ * Adds a task that runs on the thread that runs the graph.
+ *
+ * @param name The task name. Must be unique.
+ * @param dependencies The names of the tasks that must finish first.
+ * @param block The task block.
+ */
+- (void)addMainThreadTask:(NSString *)name dependencies:(NSArray<NSString *> *)dependencies block:(void (^)(void))block;
+
+/**
+ * Runs all tasks and returns once they have finished. If tasks depend on unknown or
+ * cyclic dependencies, the remaining tasks are run in the order they were added.
+ */
+- (void)run;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,159 @@
+/* Copyright Airship and Contributors */
+
+#import <os/signpost.h>
+
+#import "UAStartupGraph+Internal.h"
+#import "UAGlobal.h"
+
+@interface UAStartupTask : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSArray<NSString *> *dependencies;
+@property (nonatomic, copy) void (^block)(void);
+@property (nonatomic, assign) BOOL mainThread;
+@end
+
+@implementation UAStartupTask
+@end
+
+@interface UAStartupGraph()
+@property (nonatomic, strong) dispatch_queue_t backgroundQueue;
+@property (nonatomic, strong) NSMutableArray<UAStartupTask *> *tasks;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *durations;
+@end
+
+@implementation UAStartupGraph
+
++ (instancetype)startupGraph {
+    return [self startupGraphWithBackgroundQueue:dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0)];
+}
+
++ (instancetype)startupGraphWithBackgroundQueue:(dispatch_queue_t)backgroundQueue {
+    return [[self alloc] initWithBackgroundQueue:backgroundQueue];
+}
+
+- (instancetype)initWithBackgroundQueue:(dispatch_queue_t)backgroundQueue {
+    self = [super init];
+    if (self) {
+        self.backgroundQueue = backgroundQueue;
+        self.tasks = [NSMutableArray array];
+        self.durations = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)taskDurations {
+    @synchronized (self.durations) {
+        return [self.durations copy];
+    }
+}
+
+- (void)addTask:(NSString *)name dependencies:(NSArray<NSString *> *)dependencies block:(void (^)(void))block {
+    [self addTask:name dependencies:dependencies mainThread:NO block:block];
+}
+
+- (void)addMainThreadTask:(NSString *)name dependencies:(NSArray<NSString *> *)dependencies block:(void (^)(void))block {
+    [self addTask:name dependencies:dependencies mainThread:YES block:block];
+}
+
+- (void)addTask:(NSString *)name dependencies:(NSArray<NSString *> *)dependencies mainThread:(BOOL)mainThread block:(void (^)(void))block {
+    UAStartupTask *task = [[UAStartupTask alloc] init];
+    task.name = name;
+    task.dependencies = dependencies;
+    task.mainThread = mainThread;
+    task.block = block;
+    [self.tasks addObject:task];
+}
+
+- (void)run {
+    NSMutableArray<UAStartupTask *> *pending = [self.tasks mutableCopy];
+    NSMutableSet<NSString *> *finished = [NSMutableSet set];
+    NSMutableArray<NSString *> *finishedInBackground = [NSMutableArray array];
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    NSUInteger running = 0;
+
+    while (pending.count || running) {
+        @synchronized (finishedInBackground) {
+            [finished addObjectsFromArray:finishedInBackground];
+            running -= finishedInBackground.count;
+            [finishedInBackground removeAllObjects];
+        }
+
+        // Start every ready background task, and run at most one ready main thread task before
+        // checking again so background tasks it unblocks start right away
+        UAStartupTask *mainThreadTask;
+        for (UAStartupTask *task in [pending copy]) {
+            if (![finished isSupersetOfSet:[NSSet setWithArray:task.dependencies]]) {
+                continue;
+            }
+
+            if (task.mainThread) {
+                if (!mainThreadTask) {
+                    mainThreadTask = task;
+                    [pending removeObject:task];
+                }
+                continue;
+            }
+
+            [pending removeObject:task];
+            running++;
+            dispatch_async(self.backgroundQueue, ^{
+                [self performTask:task];
+                @synchronized (finishedInBackground) {
+                    [finishedInBackground addObject:task.name];
+                }
+                dispatch_semaphore_signal(semaphore);
+            });
+        }
+
+        if (mainThreadTask) {
+            [self performTask:mainThreadTask];
+            [finished addObject:mainThreadTask.name];
+        } else if (running) {
+            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        } else if (pending.count) {
+            UA_LERR(@"Startup tasks have missing or cyclic dependencies: %@", [pending valueForKey:@"name"]);
+            for (UAStartupTask *task in pending) {
+                [self performTask:task];
+            }
+            [pending removeAllObjects];
+        }
+    }
+}
+
+- (void)performTask:(UAStartupTask *)task {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_log_t log = [UAStartupGraph startupLog];
+        os_signpost_id_t signpostID = os_signpost_id_generate(log);
+        os_signpost_interval_begin(log, signpostID, "Startup Task", "%{public}s", task.name.UTF8String);
+        task.block();
+        os_signpost_interval_end(log, signpostID, "Startup Task", "%{public}s", task.name.UTF8String);
+    } else {
+        task.block();
+    }
+
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - start;
+    @synchronized (self.durations) {
+        self.durations[task.name] = @(duration);
+    }
+
+    UA_LTRACE(@"Startup task %@ took %.2f ms on %@", task.name, duration * 1000, [NSThread isMainThread] ? @"main" : @"background");
+}
+
++ (void)traceEvent:(NSString *)name {
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_event_emit([UAStartupGraph startupLog], OS_SIGNPOST_ID_EXCLUSIVE, "Startup Event", "%{public}s", name.UTF8String);
+    }
+}
+
++ (os_log_t)startupLog {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("com.urbanairship", "Startup");
+    });
+    return log;
+}
+
+@end
@@ -59,6 +59,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (NSArray<UATagGroupsMutation *> *)collapseMutations:(NSArray<UATagGroupsMutation *> *)mutations;
 
+/**
+ * Collapses a mutation into already collapsed mutations in place, following the same
+ * rules as `collapseMutations:`. Only the tag groups changed by the mutation are visited.
+ *
+ * The collapsed mutations are modified, so they must not be shared. Use mutations returned
+ * by `collapseMutations:` or previously built by this method.
+ *
+ * @param mutation The mutation to collapse.
+ * @param collapsedMutations The collapsed mutations.
+ */
++ (void)collapseMutation:(UATagGroupsMutation *)mutation
+           intoMutations:(NSMutableArray<UATagGroupsMutation *> *)collapsedMutations;
+
 
 /**
  * The mutation payload for `UATagGroupsAPIClient`.
@@ -136,93 +136,115 @@
         return mutations;
     }
 
-    NSMutableDictionary *addTagGroups = [NSMutableDictionary dictionary];
-    NSMutableDictionary *removeTagGroups = [NSMutableDictionary dictionary];
-    NSMutableDictionary *setTagGroups = [NSMutableDictionary dictionary];
-
+    NSMutableArray *collapsedMutations = [NSMutableArray array];
     for (UATagGroupsMutation *mutation in mutations) {
+        [self collapseMutation:mutation intoMutations:collapsedMutations];
+    }
 
-        // Add tags
-        for (NSString *group in mutation.addTagGroups) {
+    return [collapsedMutations copy];
+}
 
-            NSMutableSet *tags = [mutation.addTagGroups[group] mutableCopy];
++ (void)collapseMutation:(UATagGroupsMutation *)mutation
+           intoMutations:(NSMutableArray<UATagGroupsMutation *> *)collapsedMutations {
 
-            // Add to the set tag groups if we can
-            if (setTagGroups[group]) {
-                [setTagGroups[group] unionSet:tags];
-                continue;
-            }
+    UATagGroupsMutation *setMutation;
+    UATagGroupsMutation *addRemoveMutation;
+    for (UATagGroupsMutation *collapsedMutation in collapsedMutations) {
+        if (collapsedMutation.setTagGroups.count) {
+            setMutation = collapsedMutation;
+        } else {
+            addRemoveMutation = collapsedMutation;
+        }
+    }
 
-            // Remove from remove tag groups
-            [removeTagGroups[group] minusSet:tags];
-            if (![removeTagGroups[group] count]) {
-                [removeTagGroups removeObjectForKey:group];
-            }
+    if (!setMutation) {
+        setMutation = [[UATagGroupsMutation alloc] init];
+        setMutation.setTagGroups = [NSMutableDictionary dictionary];
+    }
 
-            // Add to the add tag groups
-            if (!addTagGroups[group]) {
-                addTagGroups[group] = tags;
-            } else {
-                [addTagGroups[group] unionSet:tags];
-            }
-        }
+    if (!addRemoveMutation) {
+        addRemoveMutation = [[UATagGroupsMutation alloc] init];
+        addRemoveMutation.addTagGroups = [NSMutableDictionary dictionary];
+        addRemoveMutation.removeTagGroups = [NSMutableDictionary dictionary];
+    }
 
-        // Remove tags
-        for (NSString *group in mutation.removeTagGroups) {
-            NSMutableSet *tags = [mutation.removeTagGroups[group] mutableCopy];
+    NSMutableDictionary *addTagGroups = (NSMutableDictionary *)addRemoveMutation.addTagGroups;
+    NSMutableDictionary *removeTagGroups = (NSMutableDictionary *)addRemoveMutation.removeTagGroups;
+    NSMutableDictionary *setTagGroups = (NSMutableDictionary *)setMutation.setTagGroups;
 
-            // Remove to the set tag groups if we can
-            if (setTagGroups[group]) {
-                [setTagGroups[group] minusSet:tags];
-                break;
-            }
+    // Add tags
+    for (NSString *group in mutation.addTagGroups) {
 
-            // Remove from add tag groups
-            [addTagGroups[group] minusSet:tags];
-            if (![addTagGroups[group] count]) {
-                [addTagGroups removeObjectForKey:group];
-            }
+        NSMutableSet *tags = [mutation.addTagGroups[group] mutableCopy];
 
-            // Add to the remove tag groups
-            if (!removeTagGroups[group]) {
-                removeTagGroups[group] = tags;
-            } else {
-                [removeTagGroups[group] unionSet:tags];
-            }
+        // Add to the set tag groups if we can
+        if (setTagGroups[group]) {
+            [setTagGroups[group] unionSet:tags];
+            continue;
+        }
+
+        // Remove from remove tag groups
+        [removeTagGroups[group] minusSet:tags];
+        if (![removeTagGroups[group] count]) {
+            [removeTagGroups removeObjectForKey:group];
         }
 
-        // Set tags
-        for (NSString *group in mutation.setTagGroups) {
+        // Add to the add tag groups
+        if (!addTagGroups[group]) {
+            addTagGroups[group] = tags;
+        } else {
+            [addTagGroups[group] unionSet:tags];
+        }
+    }
 
-            NSMutableSet *tags = [mutation.setTagGroups[group] mutableCopy];
+    // Remove tags
+    for (NSString *group in mutation.removeTagGroups) {
+        NSMutableSet *tags = [mutation.removeTagGroups[group] mutableCopy];
 
-            // Add to the set tags group
-            setTagGroups[group] = tags;
+        // Remove to the set tag groups if we can
+        if (setTagGroups[group]) {
+            [setTagGroups[group] minusSet:tags];
+            break;
+        }
 
-            // Remove from the other groups
-            [removeTagGroups removeObjectForKey:group];
+        // Remove from add tag groups
+        [addTagGroups[group] minusSet:tags];
+        if (![addTagGroups[group] count]) {
             [addTagGroups removeObjectForKey:group];
         }
+
+        // Add to the remove tag groups
+        if (!removeTagGroups[group]) {
+            removeTagGroups[group] = tags;
+        } else {
+            [removeTagGroups[group] unionSet:tags];
+        }
     }
 
-    NSMutableArray *collapsedMutations = [NSMutableArray array];
+    // Set tags
+    for (NSString *group in mutation.setTagGroups) {
+
+        NSMutableSet *tags = [mutation.setTagGroups[group] mutableCopy];
+
+        // Add to the set tags group
+        setTagGroups[group] = tags;
+
+        // Remove from the other groups
+        [removeTagGroups removeObjectForKey:group];
+        [addTagGroups removeObjectForKey:group];
+    }
+
+    [collapsedMutations removeAllObjects];
 
     // Set must be a separate mutation
     if (setTagGroups.count) {
-        UATagGroupsMutation *mutation = [[UATagGroupsMutation alloc] init];
-        mutation.setTagGroups = setTagGroups;
-        [collapsedMutations addObject:mutation];
+        [collapsedMutations addObject:setMutation];
     }
 
     // Add and remove can be collapsed into one mutation
     if (addTagGroups.count || removeTagGroups.count) {
-        UATagGroupsMutation *mutation = [[UATagGroupsMutation alloc] init];
-        mutation.removeTagGroups = removeTagGroups;
-        mutation.addTagGroups = addTagGroups;
-        [collapsedMutations addObject:mutation];
+        [collapsedMutations addObject:addRemoveMutation];
     }
-
-    return [collapsedMutations copy];
 }
 
 /**
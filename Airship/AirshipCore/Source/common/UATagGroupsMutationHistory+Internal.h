@@ -12,6 +12,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Represents the local history of tag group mutations.
+ *
+ * Pending mutations are collapsed as they are added, so the collapsed mutations are always
+ * available in memory. Added mutations are appended to the pending queues as is, and the queues
+ * are only rewritten with the collapsed mutations when they are compacted before a pop.
  */
 @interface UATagGroupsMutationHistory : NSObject<UATagGroupsHistory>
 
@@ -55,7 +59,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)addSentMutation:(UATagGroupsMutation *)mutation date:(NSDate *)date;
 
 /**
- * Peeks the top-most pending mutation from the queue corresponding to
+ * Peeks the top-most collapsed pending mutation corresponding to
  * the tag group type under consideration.
  *
  * @param type The tag groups type.
@@ -71,7 +75,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (UATagGroupsMutation *)popPendingMutation:(UATagGroupsType)type;
 
 /**
- * Collapses pending mutations for the provided tag groups type.
+ * Compacts the pending queue for the provided tag groups type to the collapsed pending mutations.
+ * Pending mutations are collapsed as they are added, so this only rewrites the queue if mutations
+ * were added since it was last compacted.
  */
 - (void)collapsePendingMutations:(UATagGroupsType)type;
 
@@ -24,6 +24,16 @@
 @property (nonatomic, strong) UAPersistentQueue *pendingChannelTagGroupsMutations;
 @property (nonatomic, strong) UAPersistentQueue *pendingNamedUserTagGroupsMutations;
 @property (nonatomic, strong) UAPersistentQueue *tagGroupsTransactionRecords;
+
+/**
+ * The collapsed pending mutations for each tag groups type, loaded from the pending queues on first use.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableArray<UATagGroupsMutation *> *> *collapsedPendingMutations;
+
+/**
+ * The tag groups types whose pending queues hold mutations that have not been compacted to the collapsed mutations.
+ */
+@property (nonatomic, strong) NSMutableSet<NSNumber *> *uncompactedPendingMutationTypes;
 @end
 
 @implementation UATagGroupsMutationHistory
@@ -33,6 +43,8 @@
 
     if (self) {
         self.dataStore = dataStore;
+        self.collapsedPendingMutations = [NSMutableDictionary dictionary];
+        self.uncompactedPendingMutationTypes = [NSMutableSet set];
 
         self.pendingChannelTagGroupsMutations = [UAPersistentQueue persistentQueueWithDataStore:dataStore
                                                                                             key:kUAPendingChannelTagGroupsMutationsKey];
@@ -98,8 +110,9 @@
         }
 
         if (mutations.count) {
-            UAPersistentQueue *queue = [self pendingMutationsQueue:type];
-            [queue addObjects:mutations];
+            for (UATagGroupsMutation *mutation in mutations) {
+                [self addPendingMutation:mutation type:type];
+            }
             [self.dataStore removeObjectForKey:mutationsKey];
         }
     }
@@ -122,11 +135,37 @@
     }
 }
 
+/**
+ * Returns the collapsed pending mutations for the provided tag groups type, collapsing the
+ * pending queue the first time. Must be called while synchronized on self.
+ *
+ * @param type The tag groups type.
+ * @return The collapsed pending mutations.
+ */
+- (NSMutableArray<UATagGroupsMutation *> *)collapsedPendingMutations:(UATagGroupsType)type {
+    NSMutableArray<UATagGroupsMutation *> *mutations = self.collapsedPendingMutations[@(type)];
+
+    if (!mutations) {
+        NSArray<UATagGroupsMutation *> *queuedMutations = (NSArray<UATagGroupsMutation *> *)[[self pendingMutationsQueue:type] objects];
+        mutations = [[UATagGroupsMutation collapseMutations:queuedMutations] mutableCopy];
+        self.collapsedPendingMutations[@(type)] = mutations;
+
+        if (queuedMutations.count) {
+            [self.uncompactedPendingMutationTypes addObject:@(type)];
+        }
+    }
+
+    return mutations;
+}
+
 - (NSArray<UATagGroupsMutation *> *)pendingMutations {
-    NSArray<UATagGroupsMutation *> *pendingChannelTagGroupMutations = (NSArray<UATagGroupsMutation *>*) [self.pendingChannelTagGroupsMutations objects];
-    NSArray<UATagGroupsMutation *> *pendingNamedUserTagGroupMutations = (NSArray<UATagGroupsMutation *>*) [self.pendingNamedUserTagGroupsMutations objects];
+    @synchronized (self) {
+        // Collapsing again copies the mutations, so they are not changed by later additions
+        NSArray<UATagGroupsMutation *> *pendingChannelTagGroupMutations = [UATagGroupsMutation collapseMutations:[self collapsedPendingMutations:UATagGroupsTypeChannel]];
+        NSArray<UATagGroupsMutation *> *pendingNamedUserTagGroupMutations = [UATagGroupsMutation collapseMutations:[self collapsedPendingMutations:UATagGroupsTypeNamedUser]];
 
-    return [pendingNamedUserTagGroupMutations arrayByAddingObjectsFromArray:pendingChannelTagGroupMutations];
+        return [pendingNamedUserTagGroupMutations arrayByAddingObjectsFromArray:pendingChannelTagGroupMutations];
+    }
 }
 
 - (NSArray<UATagGroupsTransactionRecord *> *)transactionRecordsWithMaxAge:(NSTimeInterval)maxAge {
@@ -153,7 +192,13 @@
 }
 
 - (void)addPendingMutation:(UATagGroupsMutation *)mutation type:(UATagGroupsType)type {
-    [[self pendingMutationsQueue:type] addObject:mutation];
+    @synchronized (self) {
+        [UATagGroupsMutation collapseMutation:mutation intoMutations:[self collapsedPendingMutations:type]];
+
+        // Only the new mutation is appended, the queue is compacted before the next upload
+        [[self pendingMutationsQueue:type] addObject:mutation];
+        [self.uncompactedPendingMutationTypes addObject:@(type)];
+    }
 }
 
 - (void)cleanTransactionRecords {
@@ -170,24 +215,52 @@
 }
 
 - (UATagGroupsMutation *)peekPendingMutation:(UATagGroupsType)type {
-    return (UATagGroupsMutation *)[[self pendingMutationsQueue:type] peekObject];
+    @synchronized (self) {
+        UATagGroupsMutation *mutation = [self collapsedPendingMutations:type].firstObject;
+        if (!mutation) {
+            return nil;
+        }
+
+        // Collapsing again copies the mutation, so it is not changed by later additions
+        return [UATagGroupsMutation collapseMutations:@[mutation]].firstObject;
+    }
 }
 
 - (UATagGroupsMutation *)popPendingMutation:(UATagGroupsType)type {
-    return (UATagGroupsMutation *)[[self pendingMutationsQueue:type] popObject];
+    @synchronized (self) {
+        NSMutableArray<UATagGroupsMutation *> *mutations = [self collapsedPendingMutations:type];
+        UATagGroupsMutation *mutation = mutations.firstObject;
+        if (!mutation) {
+            return nil;
+        }
+
+        // The queue has to match the collapsed mutations before the top one can be popped
+        [self collapsePendingMutations:type];
+
+        [mutations removeObjectAtIndex:0];
+        [[self pendingMutationsQueue:type] popObject];
+        return mutation;
+    }
 }
 
 - (void)collapsePendingMutations:(UATagGroupsType)type {
-    UAPersistentQueue *queue = [self pendingMutationsQueue:type];
-
-    NSArray<UATagGroupsMutation *> *mutations = [[queue objects] mutableCopy];
-    mutations = [UATagGroupsMutation collapseMutations:mutations];
+    @synchronized (self) {
+        NSMutableArray<UATagGroupsMutation *> *mutations = [self collapsedPendingMutations:type];
+        if (![self.uncompactedPendingMutationTypes containsObject:@(type)]) {
+            return;
+        }
 
-    [queue setObjects:mutations];
+        [[self pendingMutationsQueue:type] setObjects:[UATagGroupsMutation collapseMutations:mutations]];
+        [self.uncompactedPendingMutationTypes removeObject:@(type)];
+    }
 }
 
 - (void)clearPendingMutations:(UATagGroupsType)type {
-    [[self pendingMutationsQueue:type] clear];
+    @synchronized (self) {
+        [[self pendingMutationsQueue:type] clear];
+        self.collapsedPendingMutations[@(type)] = [NSMutableArray array];
+        [self.uncompactedPendingMutationTypes removeObject:@(type)];
+    }
 }
 
 - (void)clearSentMutations {
@@ -138,10 +138,7 @@ typedef void (^UATagGroupsMutator)(NSArray *, NSString *);
             return;
         }
 
-        // collapse mutations
-        [self.mutationHistory collapsePendingMutations:type];
-        
-        // peek at top mutation
+        // peek at top mutation, pending mutations are collapsed as they are added
         UATagGroupsMutation *mutation = [self.mutationHistory peekPendingMutation:type];
         
         if (!mutation) {
@@ -26,6 +26,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)getDeviceID:(void (^)(NSString *))completionHandler dispatcher:(nullable UADispatcher *)dispatcher;
 
+///---------------------------------------------------------------------------------------
+/// @name Date Formatting
+///---------------------------------------------------------------------------------------
+
+/**
+ * Parses ISO 8601 date strings by trying each supported format with a date formatter.
+ * `parseISO8601DateFromString:` falls back to this for timestamps it can't parse directly.
+ *
+ * @param timestamp The ISO 8601 timestamp.
+ * @return A parsed NSDate object, or nil if the timestamp is not a valid format.
+ */
++ (nullable NSDate *)parseISO8601DateWithFormattersFromString:(NSString *)timestamp;
+
 @end
 
 NS_ASSUME_NONNULL_END
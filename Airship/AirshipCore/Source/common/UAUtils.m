@@ -28,6 +28,118 @@
 #import <CoreTelephony/CTCarrier.h>
 #endif
 
+// Longest timestamp handled by the fast path, yyyy-MM-dd'T'HH:mm:ss.SSS
+#define kUAISO8601MaxLength 23
+
+/**
+ * Reads a fixed width run of ASCII digits.
+ *
+ * @return The value, or -1 if any of the characters is not a digit.
+ */
+static NSInteger UAParseISO8601Digits(const unichar *chars, NSUInteger length) {
+    NSInteger value = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        if (chars[i] < '0' || chars[i] > '9') {
+            return -1;
+        }
+        value = value * 10 + (chars[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * Days from 1970-01-01 to the given Gregorian date.
+ */
+static int64_t UAParseISO8601DaysFromEpoch(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = year / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Parses the fixed width timestamp formats accepted by `parseISO8601DateFromString:` in a single pass
+ * without creating any objects.
+ *
+ * Only well formed timestamps with in range fields are handled. Years before 1583 are rejected since the
+ * formatter switches to the Julian calendar for those dates.
+ *
+ * @param timestamp The timestamp.
+ * @param interval The parsed time interval since the reference date.
+ * @return YES if the timestamp was parsed, otherwise NO.
+ */
+static BOOL UAParseISO8601Timestamp(NSString *timestamp, NSTimeInterval *interval) {
+    NSUInteger length = timestamp.length;
+    if (length != 4 && length != 7 && length != 10 && length != 13 && length != 16 && length != 19 && length != kUAISO8601MaxLength) {
+        return NO;
+    }
+
+    unichar chars[kUAISO8601MaxLength];
+    [timestamp getCharacters:chars range:NSMakeRange(0, length)];
+
+    NSInteger year = UAParseISO8601Digits(chars, 4);
+    NSInteger month = 1;
+    NSInteger day = 1;
+    NSInteger hour = 0;
+    NSInteger minute = 0;
+    NSInteger second = 0;
+    NSInteger millis = 0;
+
+    if (year < 1583) {
+        return NO;
+    }
+
+    if (length >= 7) {
+        if (chars[4] != '-' || (month = UAParseISO8601Digits(chars + 5, 2)) < 1 || month > 12) {
+            return NO;
+        }
+    }
+
+    if (length >= 10) {
+        static const NSInteger daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        BOOL leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        NSInteger maxDay = daysInMonth[month - 1] + (month == 2 && leapYear ? 1 : 0);
+
+        if (chars[7] != '-' || (day = UAParseISO8601Digits(chars + 8, 2)) < 1 || day > maxDay) {
+            return NO;
+        }
+    }
+
+    if (length >= 13) {
+        // The millisecond format only exists with the `T` delimiter
+        BOOL validDelimiter = chars[10] == 'T' || (chars[10] == ' ' && length < kUAISO8601MaxLength);
+        if (!validDelimiter || (hour = UAParseISO8601Digits(chars + 11, 2)) < 0 || hour > 23) {
+            return NO;
+        }
+    }
+
+    if (length >= 16) {
+        if (chars[13] != ':' || (minute = UAParseISO8601Digits(chars + 14, 2)) < 0 || minute > 59) {
+            return NO;
+        }
+    }
+
+    if (length >= 19) {
+        if (chars[16] != ':' || (second = UAParseISO8601Digits(chars + 17, 2)) < 0 || second > 59) {
+            return NO;
+        }
+    }
+
+    if (length == kUAISO8601MaxLength) {
+        if (chars[19] != '.' || (millis = UAParseISO8601Digits(chars + 20, 3)) < 0) {
+            return NO;
+        }
+    }
+
+    int64_t seconds = UAParseISO8601DaysFromEpoch(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+
+    // Same conversion as the formatter, which works in milliseconds since 1970
+    *interval = (double)(seconds * 1000 + millis) / 1000.0 - NSTimeIntervalSince1970;
+    return YES;
+}
+
 @implementation UAUtils
 
 + (NSString *)connectionType {
@@ -199,6 +311,20 @@
 }
 
 + (NSDate *)parseISO8601DateFromString:(NSString *)timestamp {
+    if (!timestamp) {
+        return nil;
+    }
+
+    NSTimeInterval interval;
+    if (UAParseISO8601Timestamp(timestamp, &interval)) {
+        return [NSDate dateWithTimeIntervalSinceReferenceDate:interval];
+    }
+
+    // Anything the fast path does not handle is left to the formatter so the results stay the same
+    return [self parseISO8601DateWithFormattersFromString:timestamp];
+}
+
++ (NSDate *)parseISO8601DateWithFormattersFromString:(NSString *)timestamp {
     NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
     dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
     dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
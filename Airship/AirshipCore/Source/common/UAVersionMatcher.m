@@ -3,7 +3,6 @@
 
 #import "UAVersionMatcher.h"
 #import "UAGlobal.h"
-#import "UAUtils+Internal.h"
 
 typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     UAVersionMatcherConstraintTypeUnknown,
@@ -12,12 +11,138 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     UAVersionMatcherConstraintTypeVersionRange
 };
 
+typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
+    UAVersionMatcherRangeBoundaryInclusive,
+    UAVersionMatcherRangeBoundaryExclusive,
+    UAVersionMatcherRangeBoundaryInfinite
+};
+
+/**
+ * A whitespace stripped version string and its integer components.
+ *
+ * Components are parsed the same way as `UAUtils compareVersion:toVersion:`: split on `.`
+ * with each component's leading integer value, or 0 if it has none.
+ */
+@interface UAParsedVersion : NSObject {
+@public
+    NSInteger *_components;
+    NSUInteger _count;
+}
+
+@property(nonatomic, readonly) NSString *string;
+
++ (instancetype)versionWithString:(NSString *)string;
+
+@end
+
+/**
+ * Reads a component's leading integer, matching `NSString integerValue`.
+ */
+static NSInteger UAParsedVersionComponent(const unichar *characters, NSUInteger length, NSUInteger *position) {
+    NSUInteger i = *position;
+    BOOL negative = NO;
+
+    if (i < length && (characters[i] == '-' || characters[i] == '+')) {
+        negative = characters[i] == '-';
+        i++;
+    }
+
+    NSInteger value = 0;
+    while (i < length && characters[i] >= '0' && characters[i] <= '9') {
+        NSInteger digit = characters[i] - '0';
+        if (value > (NSIntegerMax - digit) / 10) {
+            value = NSIntegerMax;
+        } else {
+            value = value * 10 + digit;
+        }
+        i++;
+    }
+
+    *position = i;
+    return negative ? -value : value;
+}
+
+/**
+ * Compares two versions, treating missing components as 0.
+ */
+static NSComparisonResult UAParsedVersionCompare(UAParsedVersion *version1, UAParsedVersion *version2) {
+    NSUInteger count = MAX(version1->_count, version2->_count);
+    for (NSUInteger i = 0; i < count; i++) {
+        NSInteger component1 = i < version1->_count ? version1->_components[i] : 0;
+        NSInteger component2 = i < version2->_count ? version2->_components[i] : 0;
+        if (component1 < component2) {
+            return NSOrderedAscending;
+        } else if (component1 > component2) {
+            return NSOrderedDescending;
+        }
+    }
+
+    return NSOrderedSame;
+}
+
+@implementation UAParsedVersion
+
+- (instancetype)initWithString:(NSString *)string {
+    self = [super init];
+
+    if (self) {
+        _string = [string copy];
+
+        NSUInteger length = string.length;
+        unichar *characters = malloc(sizeof(unichar) * MAX(length, 1));
+        [string getCharacters:characters range:NSMakeRange(0, length)];
+
+        _count = 1;
+        for (NSUInteger i = 0; i < length; i++) {
+            if (characters[i] == '.') {
+                _count++;
+            }
+        }
+
+        _components = calloc(_count, sizeof(NSInteger));
+
+        NSUInteger index = 0;
+        NSUInteger position = 0;
+        while (index < _count) {
+            _components[index++] = UAParsedVersionComponent(characters, length, &position);
+
+            // skip to the next component
+            while (position < length && characters[position] != '.') {
+                position++;
+            }
+            position++;
+        }
+
+        free(characters);
+    }
+
+    return self;
+}
+
++ (instancetype)versionWithString:(NSString *)string {
+    return [[self alloc] initWithString:string];
+}
+
+- (void)dealloc {
+    free(_components);
+}
+
+@end
+
 @interface UAVersionMatcher ()
 
 @property(nonatomic, strong) NSString *versionConstraint;
 @property(nonatomic, assign) UAVersionMatcherConstraintType constraintType;
 @property(nonatomic, strong) NSDictionary *parsedConstraint;
 
+// Compiled constraint
+@property(nonatomic, copy, nullable) NSString *exactVersion;
+@property(nonatomic, copy, nullable) NSString *subVersion;
+@property(nonatomic, assign) UAVersionMatcherRangeBoundary startBoundary;
+@property(nonatomic, assign) UAVersionMatcherRangeBoundary endBoundary;
+@property(nonatomic, strong, nullable) UAParsedVersion *startOfRange;
+@property(nonatomic, strong, nullable) UAParsedVersion *endOfRange;
+
 @end
 
 
@@ -43,6 +168,7 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeExactVersion;
         matcher.parsedConstraint = parsedConstraint;
+        matcher.exactVersion = parsedConstraint[@"exactVersion"];
         return matcher;
     }
     
@@ -50,6 +176,7 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeSubVersion;
         matcher.parsedConstraint = parsedConstraint;
+        matcher.subVersion = parsedConstraint[@"subVersion"];
         return matcher;
     }
     
@@ -57,6 +184,14 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeVersionRange;
         matcher.parsedConstraint = parsedConstraint;
+        matcher.startBoundary = [parsedConstraint[@"startBoundary"] integerValue];
+        matcher.endBoundary = [parsedConstraint[@"endBoundary"] integerValue];
+        if (matcher.startBoundary != UAVersionMatcherRangeBoundaryInfinite) {
+            matcher.startOfRange = [UAParsedVersion versionWithString:parsedConstraint[@"startOfRange"]];
+        }
+        if (matcher.endBoundary != UAVersionMatcherRangeBoundaryInfinite) {
+            matcher.endOfRange = [UAParsedVersion versionWithString:parsedConstraint[@"endOfRange"]];
+        }
         return matcher;
     }
     
@@ -67,7 +202,11 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 #pragma mark Evaluate version against constraint
 
 - (BOOL)evaluateObject:(id)value {
-    NSString *checkVersion = [[self class] removeWhitespace:value];
+    if (![value isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+
+    UAParsedVersion *checkVersion = [[self class] parsedVersionWithString:value];
 
     switch (self.constraintType) {
         case UAVersionMatcherConstraintTypeExactVersion:
@@ -103,12 +242,12 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
              };
 }
 
-- (BOOL)versionMatchesExactVersion:(NSString *)checkVersion {
+- (BOOL)versionMatchesExactVersion:(UAParsedVersion *)checkVersion {
     if (self.constraintType != UAVersionMatcherConstraintTypeExactVersion) {
         return NO;
     }
     
-    return ([checkVersion isEqualToString:self.parsedConstraint[@"exactVersion"]]);
+    return ([checkVersion.string isEqualToString:self.exactVersion]);
 }
 
 #pragma mark -
@@ -147,19 +286,13 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     return nil;
 }
 
-- (BOOL)versionMatchesSubVersion:(NSString *)checkVersion {
+- (BOOL)versionMatchesSubVersion:(UAParsedVersion *)checkVersion {
     if (self.constraintType != UAVersionMatcherConstraintTypeSubVersion) {
         return NO;
     }
     
-    NSString *subVersion = self.parsedConstraint[@"subVersion"];
-    
     // if the version being matched is longer than the constraint, only compare its prefix
-    if ([checkVersion length] > [subVersion length]) {
-        return ([subVersion isEqualToString:[checkVersion substringToIndex:[subVersion length]]]);
-    } else {
-        return ([subVersion isEqualToString:checkVersion]);
-    }
+    return (!self.subVersion.length || [checkVersion.string hasPrefix:self.subVersion]);
 }
 
 #pragma mark -
@@ -182,12 +315,6 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 #define VERSION_PATTERN     @"([^" START_END_TOKENS RANGE_SEPARATOR @"]*)"
 #define VERSION_RANGE_PATTERN START_PATTERN VERSION_PATTERN SEPARATOR_PATTERN VERSION_PATTERN END_PATTERN
 
-typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
-    UAVersionMatcherRangeBoundaryInclusive,
-    UAVersionMatcherRangeBoundaryExclusive,
-    UAVersionMatcherRangeBoundaryInfinite
-};
-
 + (BOOL)isVersionRange:(NSString *)versionConstraint {
     return ([self parseVersionRangeConstraint:versionConstraint] != nil);
 }
@@ -291,18 +418,16 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
     return parsedConstraint;
 }
 
-- (BOOL)versionMatchesRange:(NSString *)checkVersion {
+- (BOOL)versionMatchesRange:(UAParsedVersion *)checkVersion {
     if (self.constraintType != UAVersionMatcherConstraintTypeVersionRange) {
         return NO;
     }
     
-    UAVersionMatcherRangeBoundary startBoundary = [self.parsedConstraint[@"startBoundary"] integerValue];
-    NSString *startOfRange = self.parsedConstraint[@"startOfRange"];
-    if (startBoundary != UAVersionMatcherRangeBoundaryInfinite) {
-        NSComparisonResult result = [UAUtils compareVersion:startOfRange toVersion:checkVersion];
-        switch (startBoundary) {
+    if (self.startBoundary != UAVersionMatcherRangeBoundaryInfinite) {
+        NSComparisonResult result = UAParsedVersionCompare(self.startOfRange, checkVersion);
+        switch (self.startBoundary) {
             case UAVersionMatcherRangeBoundaryInclusive:
-                if (result != NSOrderedAscending && result != NSOrderedSame) {
+                if (result == NSOrderedDescending) {
                     return NO;
                 }
                 break;
@@ -316,13 +441,11 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
         }
     }
     
-    UAVersionMatcherRangeBoundary endBoundary = [self.parsedConstraint[@"endBoundary"] integerValue];
-    NSString *endOfRange = self.parsedConstraint[@"endOfRange"];
-    if (endBoundary != UAVersionMatcherRangeBoundaryInfinite) {
-        NSComparisonResult result = [UAUtils compareVersion:checkVersion toVersion:endOfRange];
-        switch (endBoundary) {
+    if (self.endBoundary != UAVersionMatcherRangeBoundaryInfinite) {
+        NSComparisonResult result = UAParsedVersionCompare(checkVersion, self.endOfRange);
+        switch (self.endBoundary) {
             case UAVersionMatcherRangeBoundaryInclusive:
-                if (result != NSOrderedAscending && result != NSOrderedSame) {
+                if (result == NSOrderedDescending) {
                     return NO;
                 }
                 break;
@@ -343,14 +466,28 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
 #pragma mark Utility methods
 
 + (NSArray<NSTextCheckingResult *> *)getMatchesForPattern:(NSString *)pattern onString:(NSString *)string {
-    NSError *error = NULL;
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern
-                                                                           options:NSRegularExpressionCaseInsensitive
-                                                                             error:NULL];
-    
-    if (error) {
-        UA_LERR(@"Error creating regular expression - %@",error);
-        return nil;
+    static NSMutableDictionary<NSString *, NSRegularExpression *> *expressions;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        expressions = [NSMutableDictionary dictionary];
+    });
+
+    NSRegularExpression *regex;
+    @synchronized (expressions) {
+        regex = expressions[pattern];
+        if (!regex) {
+            NSError *error = nil;
+            regex = [NSRegularExpression regularExpressionWithPattern:pattern
+                                                              options:NSRegularExpressionCaseInsensitive
+                                                                error:&error];
+
+            if (!regex) {
+                UA_LERR(@"Error creating regular expression - %@",error);
+                return nil;
+            }
+
+            expressions[pattern] = regex;
+        }
     }
     
     NSArray<NSTextCheckingResult *> *matches = [regex matchesInString:string options:0 range:NSMakeRange(0, [string length])];
@@ -365,6 +502,27 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
     return destString;
 }
 
+/**
+ * Parses a version being evaluated. Candidates are almost always the app or SDK version,
+ * so parsed versions are cached for the life of the process.
+ */
++ (UAParsedVersion *)parsedVersionWithString:(NSString *)string {
+    static NSCache<NSString *, UAParsedVersion *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 64;
+    });
+
+    UAParsedVersion *version = [cache objectForKey:string];
+    if (!version) {
+        version = [UAParsedVersion versionWithString:[self removeWhitespace:string]];
+        [cache setObject:version forKey:[string copy]];
+    }
+
+    return version;
+}
+
 - (BOOL)isEqual:(id)other {
     if (other == self) {
         return YES;
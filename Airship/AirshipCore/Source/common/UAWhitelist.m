@@ -37,12 +37,59 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
 
 @end
 
+/**
+ * Node in the reversed host label trie. Entries are stored on the node for
+ * the last label of their host, e.g. `*.urbanairship.com` is stored on com -> urbanairship.
+ */
+@interface UAWhitelistHostNode : NSObject
+
+@property(nonatomic, strong) NSMutableDictionary<NSString *, UAWhitelistHostNode *> *children;
+
+/**
+ * Entries that only match the exact host.
+ */
+@property(nonatomic, strong) NSMutableArray<UAWhitelistEntry *> *hostEntries;
+
+/**
+ * Entries that match the host and any of its subdomains.
+ */
+@property(nonatomic, strong) NSMutableArray<UAWhitelistEntry *> *subdomainEntries;
+
+@end
+
+@implementation UAWhitelistHostNode
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.children = [NSMutableDictionary dictionary];
+        self.hostEntries = [NSMutableArray array];
+        self.subdomainEntries = [NSMutableArray array];
+    }
+
+    return self;
+}
+
+@end
+
 @interface UAWhitelist ()
 
 /**
  * Set of UAWhitelistEntry objects.
  */
 @property(nonatomic, strong) NSMutableSet *entries;
+
+/**
+ * Entries that match any host.
+ */
+@property(nonatomic, strong) NSMutableArray<UAWhitelistEntry *> *anyHostEntries;
+
+/**
+ * Root of the trie of entries with a host pattern, used to skip entries that cannot match a URL's host.
+ */
+@property(nonatomic, strong) UAWhitelistHostNode *hostTrie;
+
 /**
  * Regex that matches valid whitelist pattern entries
  */
@@ -56,6 +103,8 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
     self = [super init];
     if (self) {
         self.entries = [NSMutableSet set];
+        self.anyHostEntries = [NSMutableArray array];
+        self.hostTrie = [[UAWhitelistHostNode alloc] init];
         self.openURLWhitelistingEnabled = YES;
     }
     return self;
@@ -125,15 +174,29 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
         regexString = [regexString stringByAppendingString:@"$"];
     }
 
+    // Matches everything, no need to look at the component
+    if ([regexString isEqualToString:@"^.*$"]) {
+        return [self wildcardMatcher];
+    }
+
+    // Compile once when the entry is added instead of on every check
+    NSError *error;
+    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:regexString
+                                                                           options:0
+                                                                             error:&error];
+    if (!regex) {
+        UA_LERR(@"Unable to compile whitelist regex %@: %@", regexString, error);
+        return nil;
+    }
+
+    BOOL isPath = [componentKey isEqualToString:@"path"];
+
     return ^BOOL(NSURL *url){
-        NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:regexString
-                                                                               options:0
-                                                                                 error:nil];
         // NSRegularExpression chokes on nil input strings, so in that case convert it into an empty string
         NSString *component;
 
         // The NSURL path property silently strips trailing slashes
-        if ([componentKey isEqualToString:@"path"]) {
+        if (isPath) {
             component = [self cfPathForURL:url];
         } else {
             component = [url valueForKey:componentKey];
@@ -223,7 +286,62 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
     };
 }
 
-- (NSRegularExpression *)patternValidator:(NSString *)pattern {
+/**
+ * Indexes an entry by the host in its pattern.
+ */
+- (void)indexEntry:(UAWhitelistEntry *)entry forPattern:(NSString *)pattern {
+    NSString *host = [NSURL URLWithString:pattern].host;
+
+    if (!host || [host isEqualToString:@"*"]) {
+        [self.anyHostEntries addObject:entry];
+        return;
+    }
+
+    BOOL subdomains = [host hasPrefix:@"*."];
+    if (subdomains) {
+        host = [host substringFromIndex:2];
+    }
+
+    UAWhitelistHostNode *node = self.hostTrie;
+    for (NSString *label in [[host componentsSeparatedByString:@"."] reverseObjectEnumerator]) {
+        UAWhitelistHostNode *child = node.children[label];
+        if (!child) {
+            child = [[UAWhitelistHostNode alloc] init];
+            node.children[label] = child;
+        }
+        node = child;
+    }
+
+    if (subdomains) {
+        [node.subdomainEntries addObject:entry];
+    } else {
+        [node.hostEntries addObject:entry];
+    }
+}
+
+/**
+ * Returns the entries that could match the URL based on its host.
+ */
+- (NSArray<UAWhitelistEntry *> *)candidateEntriesForURL:(NSURL *)url {
+    NSMutableArray<UAWhitelistEntry *> *candidates = [NSMutableArray arrayWithArray:self.anyHostEntries];
+
+    NSArray<NSString *> *labels = [(url.host ?: @"") componentsSeparatedByString:@"."];
+    UAWhitelistHostNode *node = self.hostTrie;
+
+    for (NSString *label in [labels reverseObjectEnumerator]) {
+        node = node.children[label];
+        if (!node) {
+            return candidates;
+        }
+
+        [candidates addObjectsFromArray:node.subdomainEntries];
+    }
+
+    [candidates addObjectsFromArray:node.hostEntries];
+    return candidates;
+}
+
+- (NSRegularExpression *)patternValidator:(nullable NSString *)pattern {
     /**
      * Regular expression to match the scheme.
      * <scheme> := '*' | <valid scheme characters, `*` will match 0 or more characters>
@@ -261,8 +379,16 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
     return validPatternExpression;
 }
 
+- (NSRegularExpression *)validPatternExpression {
+    if (!_validPatternExpression) {
+        _validPatternExpression = [self patternValidator:nil];
+    }
+
+    return _validPatternExpression;
+}
+
 - (BOOL)validatePattern:(NSString *)pattern {
-    NSRegularExpression *validator = [self patternValidator:pattern];
+    NSRegularExpression *validator = self.validPatternExpression;
 
     NSUInteger matches = [validator numberOfMatchesInString:pattern
                                                     options:0
@@ -296,7 +422,9 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
 
     // If we have just a wildcard, match anything
     if ([patternString isEqualToString:@"*"]) {
-        [self.entries addObject:[UAWhitelistEntry entryWithMatcher:[self wildcardMatcher] scope:scope]];
+        UAWhitelistEntry *entry = [UAWhitelistEntry entryWithMatcher:[self wildcardMatcher] scope:scope];
+        [self.entries addObject:entry];
+        [self.anyHostEntries addObject:entry];
         return YES;
     }
 
@@ -314,13 +442,12 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
     // The matcher that is stored in the whitelist encompasses matching each component.
     // A URL matches if an only if all components match.
     UAWhitelistMatcher patternMatcher = ^BOOL(NSURL *url) {
-        BOOL matchedScheme = schemeMatcher(url);
-        BOOL matchedHost = hostMatcher(url);
-        BOOL matchedPath = pathMatcher(url);
-        return matchedScheme && matchedHost && matchedPath;
+        return schemeMatcher(url) && hostMatcher(url) && pathMatcher(url);
     };
 
-    [self.entries addObject:[UAWhitelistEntry entryWithMatcher:[patternMatcher copy] scope:scope]];
+    UAWhitelistEntry *entry = [UAWhitelistEntry entryWithMatcher:[patternMatcher copy] scope:scope];
+    [self.entries addObject:entry];
+    [self indexEntry:entry forPattern:patternString];
 
     return YES;
 }
@@ -337,10 +464,19 @@ typedef BOOL (^UAWhitelistMatcher)(NSURL *);
     } else {
         NSUInteger matchedScope = 0;
         
-        for (UAWhitelistEntry *entry in self.entries) {
+        for (UAWhitelistEntry *entry in [self candidateEntriesForURL:url]) {
+            // Skip entries that would not add any of the remaining scopes
+            if (!(entry.scope & scope & ~matchedScope)) {
+                continue;
+            }
+
             if (entry.matcher(url)) {
                 matchedScope |= entry.scope;
             }
+
+            if ((matchedScope & scope) == scope) {
+                break;
+            }
         }
         
         match = (((UAWhitelistScope)matchedScope & scope) == scope);
@@ -8,7 +8,7 @@
 #import "UAConfig.h"
 #import "UARuntimeConfig+Internal.h"
 #import "UAApplicationMetrics+Internal.h"
-#import "UAActionRegistry.h"
+#import "UAActionRegistry+Internal.h"
 #import "UAAutoIntegration+Internal.h"
 #import "NSJSONSerialization+UAAdditions.h"
 #import "UAAppInitEvent+Internal.h"
@@ -22,6 +22,7 @@
 #import "UATagGroupsMutationHistory+Internal.h"
 #import "UAChannel+Internal.h"
 #import "UAAppStateTracker.h"
+#import "UAStartupGraph+Internal.h"
 
 #import "UALocationModuleLoaderFactory.h"
 #import "UAAutomationModuleLoaderFactory.h"
@@ -95,88 +96,136 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 - (instancetype)initWithRuntimeConfig:(UARuntimeConfig *)config dataStore:(UAPreferenceDataStore *)dataStore {
     self = [super init];
     if (self) {
-
-        NSMutableArray *components = [NSMutableArray array];
-
         self.remoteNotificationBackgroundModeEnabled = [[[NSBundle mainBundle] objectForInfoDictionaryKey:@"UIBackgroundModes"] containsObject:@"remote-notification"];
         self.dataStore = dataStore;
         self.config = config;
 
-        self.actionRegistry = [UAActionRegistry defaultRegistry];
-        self.whitelist = [UAWhitelist whitelistWithConfig:config];
-        self.applicationMetrics = [UAApplicationMetrics applicationMetricsWithDataStore:dataStore];
+        // Components are created as a dependency graph. Work that only touches the data store, keychain,
+        // Core Data or bundle resources runs concurrently in the background, while anything that touches
+        // UIKit or registers with the application stays on the main thread.
+        UAStartupGraph *graph = [UAStartupGraph startupGraph];
 
-        UATagGroupsMutationHistory<UATagGroupsHistory> *tagGroupsMutationHistory = [UATagGroupsMutationHistory historyWithDataStore:self.dataStore];
-        UATagGroupsRegistrar *tagGroupsRegistrar = [UATagGroupsRegistrar tagGroupsRegistrarWithConfig:self.config
-                                                                                            dataStore:self.dataStore
-                                                                                      mutationHistory:tagGroupsMutationHistory];
+        __block UATagGroupsMutationHistory<UATagGroupsHistory> *tagGroupsMutationHistory;
+        __block UATagGroupsRegistrar *tagGroupsRegistrar;
+        __block id<UAModuleLoader, UALocationProviderLoader> locationLoader;
+        __block id<UAModuleLoader> automationLoader;
+        __block id<UAModuleLoader> messageCenterLoader;
+        __block id<UAModuleLoader> extendedActionsLoader;
 
-        self.sharedChannel = [UAChannel channelWithDataStore:self.dataStore
-                                                      config:self.config
-                                          tagGroupsRegistrar:tagGroupsRegistrar];
-        [components addObject:self.sharedChannel];
+        [graph addTask:@"ActionRegistry" dependencies:@[] block:^{
+            self.actionRegistry = [UAActionRegistry defaultRegistry];
+        }];
 
-        self.sharedAnalytics = [UAAnalytics analyticsWithConfig:self.config
-                                                      dataStore:self.dataStore
-                                                        channel:self.sharedChannel];
-        [components addObject:self.sharedAnalytics];
+        [graph addTask:@"Whitelist" dependencies:@[] block:^{
+            self.whitelist = [UAWhitelist whitelistWithConfig:config];
+        }];
 
+        [graph addTask:@"ApplicationMetrics" dependencies:@[] block:^{
+            self.applicationMetrics = [UAApplicationMetrics applicationMetricsWithDataStore:dataStore];
+        }];
 
-        self.sharedPush = [UAPush pushWithConfig:self.config
-                                       dataStore:self.dataStore
-                                         channel:self.sharedChannel
-                                       analytics:self.sharedAnalytics];
-        [components addObject:self.sharedPush];
+        [graph addTask:@"TagGroups" dependencies:@[] block:^{
+            tagGroupsMutationHistory = [UATagGroupsMutationHistory historyWithDataStore:self.dataStore];
+            tagGroupsRegistrar = [UATagGroupsRegistrar tagGroupsRegistrarWithConfig:self.config
+                                                                          dataStore:self.dataStore
+                                                                    mutationHistory:tagGroupsMutationHistory];
+        }];
+
+        [graph addTask:@"RemoteData" dependencies:@[] block:^{
+            self.sharedRemoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:self.config
+                                                                                  dataStore:self.dataStore];
+        }];
 
-        self.sharedNamedUser = [UANamedUser namedUserWithChannel:self.sharedChannel
+        [graph addMainThreadTask:@"Channel" dependencies:@[@"TagGroups"] block:^{
+            self.sharedChannel = [UAChannel channelWithDataStore:self.dataStore
                                                           config:self.config
-                                                       dataStore:self.dataStore
                                               tagGroupsRegistrar:tagGroupsRegistrar];
-        [components addObject:self.sharedNamedUser];
+        }];
 
-        self.sharedRemoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:self.config
-                                                                              dataStore:self.dataStore];
-        [components addObject:self.sharedRemoteDataManager];
+        [graph addMainThreadTask:@"Analytics" dependencies:@[@"Channel"] block:^{
+            self.sharedAnalytics = [UAAnalytics analyticsWithConfig:self.config
+                                                          dataStore:self.dataStore
+                                                            channel:self.sharedChannel];
+        }];
 
-        self.sharedRemoteConfigManager = [UARemoteConfigManager remoteConfigManagerWithRemoteDataManager:self.sharedRemoteDataManager
-                                                                                      applicationMetrics:self.applicationMetrics];
+        [graph addMainThreadTask:@"Push" dependencies:@[@"Channel", @"Analytics"] block:^{
+            self.sharedPush = [UAPush pushWithConfig:self.config
+                                           dataStore:self.dataStore
+                                             channel:self.sharedChannel
+                                           analytics:self.sharedAnalytics];
+        }];
+
+        [graph addTask:@"NamedUser" dependencies:@[@"Channel", @"TagGroups"] block:^{
+            self.sharedNamedUser = [UANamedUser namedUserWithChannel:self.sharedChannel
+                                                              config:self.config
+                                                           dataStore:self.dataStore
+                                                  tagGroupsRegistrar:tagGroupsRegistrar];
+        }];
+
+        [graph addMainThreadTask:@"RemoteConfig" dependencies:@[@"RemoteData", @"ApplicationMetrics"] block:^{
+            self.sharedRemoteConfigManager = [UARemoteConfigManager remoteConfigManagerWithRemoteDataManager:self.sharedRemoteDataManager
+                                                                                          applicationMetrics:self.applicationMetrics];
+        }];
 
 #if !TARGET_OS_TV
         // UIPasteboard is not available in tvOS
-        self.channelCapture = [UAChannelCapture channelCaptureWithConfig:self.config
-                                                                 channel:self.sharedChannel
-                                                    pushProviderDelegate:self.sharedPush
-                                                               dataStore:self.dataStore];
+        [graph addMainThreadTask:@"ChannelCapture" dependencies:@[@"Channel", @"Push"] block:^{
+            self.channelCapture = [UAChannelCapture channelCaptureWithConfig:self.config
+                                                                     channel:self.sharedChannel
+                                                        pushProviderDelegate:self.sharedPush
+                                                                   dataStore:self.dataStore];
+        }];
 #endif
 
-        NSMutableArray<id<UAModuleLoader>> *loaders = [NSMutableArray array];
+        [graph addMainThreadTask:@"LocationModule" dependencies:@[@"Channel", @"Analytics"] block:^{
+            locationLoader = [UAirship locationLoaderWithDataStore:self.dataStore
+                                                           channel:self.sharedChannel
+                                                         analytics:self.sharedAnalytics];
+            self.locationProvider = locationLoader.locationProvider;
+        }];
 
-        id<UAModuleLoader, UALocationProviderLoader> locationLoader = [UAirship locationLoaderWithDataStore:self.dataStore
-                                                                                                    channel:self.sharedChannel
-                                                                                                  analytics:self.sharedAnalytics];
+        [graph addMainThreadTask:@"AutomationModule" dependencies:@[@"Channel", @"Analytics", @"RemoteData", @"TagGroups"] block:^{
+            automationLoader = [UAirship automationModuleLoaderWithDataStore:self.dataStore
+                                                                      config:self.config
+                                                                     channel:self.sharedChannel
+                                                                   analytics:self.sharedAnalytics
+                                                           remoteDataManager:self.sharedRemoteDataManager
+                                                            tagGroupsHistory:tagGroupsMutationHistory];
+        }];
+
+        [graph addMainThreadTask:@"MessageCenterModule" dependencies:@[@"Channel"] block:^{
+            messageCenterLoader = [UAirship messageCenterLoaderWithDataStore:self.dataStore
+                                                                      config:self.config
+                                                                     channel:self.sharedChannel];
+        }];
+
+        [graph addTask:@"ExtendedActionsModule" dependencies:@[] block:^{
+            extendedActionsLoader = [UAirship extendedActionsModuleLoader];
+        }];
+
+        [graph run];
+
+        // Components are kept in a fixed order regardless of when they were created
+        NSMutableArray *components = [NSMutableArray array];
+        [components addObject:self.sharedChannel];
+        [components addObject:self.sharedAnalytics];
+        [components addObject:self.sharedPush];
+        [components addObject:self.sharedNamedUser];
+        [components addObject:self.sharedRemoteDataManager];
+
+        NSMutableArray<id<UAModuleLoader>> *loaders = [NSMutableArray array];
         if (locationLoader) {
             [loaders addObject:locationLoader];
-            self.locationProvider = locationLoader.locationProvider;
         }
 
-        id<UAModuleLoader> automationLoader = [UAirship automationModuleLoaderWithDataStore:self.dataStore
-                                                                                     config:self.config
-                                                                                    channel:self.sharedChannel
-                                                                                  analytics:self.sharedAnalytics
-                                                                          remoteDataManager:self.sharedRemoteDataManager
-                                                                           tagGroupsHistory:tagGroupsMutationHistory];
         if (automationLoader) {
             [loaders addObject:automationLoader];
         }
 
-        id<UAModuleLoader> messageCenterLoader = [UAirship messageCenterLoaderWithDataStore:self.dataStore
-                                                                                     config:self.config
-                                                                                    channel:self.sharedChannel];
         if (messageCenterLoader) {
             [loaders addObject:messageCenterLoader];
         }
 
-        id<UAModuleLoader> extendedActionsLoader = [UAirship extendedActionsModuleLoader];
         if (extendedActionsLoader) {
             [loaders addObject:extendedActionsLoader];
         }
@@ -187,7 +236,10 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
             }
 
             if ([loader respondsToSelector:@selector(registerActions:)]) {
-                [loader registerActions:self.actionRegistry];
+                // Module actions are registered the first time the registry is used
+                [self.actionRegistry addPendingRegistration:^(UAActionRegistry *registry) {
+                    [loader registerActions:registry];
+                }];
             }
         }
 
@@ -242,6 +294,9 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         return;
     }
 
+    CFAbsoluteTime takeOffStart = CFAbsoluteTimeGetCurrent();
+    [UAStartupGraph traceEvent:@"TakeOff"];
+
     UARuntimeConfig *runtimeConfig = [UARuntimeConfig runtimeConfigWithConfig:config];
 
     // Ensure that app credentials are valid
@@ -331,6 +386,9 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
     for (UAComponent *component in sharedAirship_.components) {
         [component airshipReady:sharedAirship_];
     }
+
+    [UAStartupGraph traceEvent:@"AirshipReady"];
+    UA_LDEBUG(@"Airship ready in %.2f ms", (CFAbsoluteTimeGetCurrent() - takeOffStart) * 1000);
 }
 
 + (void)applicationDidFinishLaunching:(NSNotification *)notification {
@@ -34,6 +34,7 @@
 #import "UAChannelRegistrationPayload.h"
 #import "UACircularRegion.h"
 #import "UAColorUtils.h"
+#import "UACompiledJSONPredicate.h"
 #import "UAComponent.h"
 #import "UAConfig.h"
 #import "UACustomEvent.h"
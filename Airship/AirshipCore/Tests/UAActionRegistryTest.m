@@ -472,6 +472,30 @@
     XCTAssertTrue([entry.names isEqualToArray:names], @"Registered entry's names are incorrect");
 }
 
+/**
+ * Test pending registrations run on first use and before later registrations.
+ */
+- (void)testPendingRegistration {
+    UAAction *pendingAction = [[UAAction alloc] init];
+    UAAction *action = [[UAAction alloc] init];
+
+    __block NSUInteger registrationCount = 0;
+    [self.registry addPendingRegistration:^(UAActionRegistry *registry) {
+        registrationCount++;
+        [registry registerAction:pendingAction names:@[@"pending", @"overridden"]];
+    }];
+
+    XCTAssertEqual(0, registrationCount);
+
+    // Registering runs the pending registration first so the new action wins
+    [self.registry registerAction:action name:@"overridden"];
+    XCTAssertEqual(1, registrationCount);
+
+    XCTAssertEqual(pendingAction, [self.registry registryEntryWithName:@"pending"].action);
+    XCTAssertEqual(action, [self.registry registryEntryWithName:@"overridden"].action);
+    XCTAssertEqual(1, registrationCount);
+}
+
 - (void)testRegisterInvalidActionClass {
     XCTAssertFalse([self.registry registerActionClass:[NSObject class] name:@"myInvalidActionClass"]);
 }
@@ -480,6 +480,54 @@
     XCTAssertEqualObjects(@"story", headers[@"cool"]);
 }
 
+- (void)testStaticAnalyticsHeadersBlock {
+    __block NSUInteger callCount = 0;
+    [self.analytics addStaticAnalyticsHeadersBlock:^NSDictionary<NSString *,NSString *> * _Nullable{
+        callCount++;
+        return @{@"static" : @"header"};
+    }];
+
+    id headers = [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertEqualObjects(@"header", headers[@"static"]);
+    XCTAssertEqual(1, callCount);
+
+    // Cached
+    XCTAssertEqualObjects(headers, [self.eventManagerDelegate analyticsHeaders]);
+    XCTAssertEqual(1, callCount);
+
+    // Locale change
+    [self.notificationCenter postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+    [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertEqual(2, callCount);
+
+    // Time zone change
+    [self.notificationCenter postNotificationName:NSSystemTimeZoneDidChangeNotification object:nil];
+    [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertEqual(3, callCount);
+
+    // SDK extension
+    [self.analytics registerSDKExtension:UASDKExtensionFlutter version:@"1.0.0"];
+    headers = [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertEqualObjects(@"flutter:1.0.0", headers[@"X-UA-Frameworks"]);
+    XCTAssertEqual(4, callCount);
+
+    // Explicit invalidation
+    [self.analytics invalidateAnalyticsHeaders];
+    [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertEqual(5, callCount);
+}
+
+- (void)testAnalyticsHeadersBlockCalledForEachUpload {
+    __block NSUInteger callCount = 0;
+    [self.analytics addAnalyticsHeadersBlock:^NSDictionary<NSString *,NSString *> * _Nullable{
+        callCount++;
+        return @{@"count" : [NSString stringWithFormat:@"%lu", (unsigned long)callCount]};
+    }];
+
+    XCTAssertEqualObjects(@"1", [self.eventManagerDelegate analyticsHeaders][@"count"]);
+    XCTAssertEqualObjects(@"2", [self.eventManagerDelegate analyticsHeaders][@"count"]);
+}
+
 - (UAAnalytics *)createAnalytics {
     return [UAAnalytics analyticsWithConfig:self.config
                                   dataStore:self.dataStore
@@ -170,4 +170,95 @@
     [self.mockApiClient verify];
 }
 
+/**
+ Test mutations saved while an upload is in progress are uploaded next instead of being merged into the in-flight payload.
+*/
+- (void)testMutationsSavedDuringUpload {
+    [[[self.mockApplication stub] andReturnValue:OCMOCK_VALUE((NSUInteger)30)] beginBackgroundTaskWithExpirationHandler:OCMOCK_ANY];
+    [[[self.mockApplication stub] ignoringNonObjectArgs] endBackgroundTask:0];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+
+    UAAttributeMutations *coffeeMutations = [UAAttributeMutations mutations];
+    [coffeeMutations setString:@"coffee" forAttribute:@"cup"];
+
+    UAAttributeMutations *teaMutations = [UAAttributeMutations mutations];
+    [teaMutations setString:@"tea" forAttribute:@"cup"];
+
+    NSMutableArray *uploadedValues = [NSMutableArray array];
+    XCTestExpectation *uploaded = [self expectationWithDescription:@"Uploaded both mutations"];
+    uploaded.expectedFulfillmentCount = 2;
+
+    [[[self.mockApiClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        NSDictionary *payload = (__bridge NSDictionary *)arg;
+        [uploadedValues addObject:payload[@"attributes"][0][@"value"]];
+
+        // Save a change to the same attribute before the first upload finishes
+        if (uploadedValues.count == 1) {
+            [self.registrar savePendingMutations:[UAAttributePendingMutations pendingMutationsWithMutations:teaMutations date:self.testDate]];
+        }
+
+        [invocation getArgument:&arg atIndex:4];
+        UAAttributeAPIClientSuccessBlock onSuccess = (__bridge UAAttributeAPIClientSuccessBlock)arg;
+        onSuccess();
+        [uploaded fulfill];
+    }] updateChannel:self.channelID withAttributePayload:OCMOCK_ANY onSuccess:OCMOCK_ANY onFailure:OCMOCK_ANY];
+
+    [self.registrar savePendingMutations:[UAAttributePendingMutations pendingMutationsWithMutations:coffeeMutations date:self.testDate]];
+    [self.registrar updateAttributesForChannel:self.channelID];
+
+    [self waitForTestExpectations];
+    [self.operationQueue waitUntilAllOperationsAreFinished];
+
+    XCTAssertEqualObjects((@[@"coffee", @"tea"]), uploadedValues);
+}
+
+/**
+ Test saved mutations are collapsed by a new registrar.
+*/
+- (void)testSavedMutationsPersist {
+    [[[self.mockApplication stub] andReturnValue:OCMOCK_VALUE((NSUInteger)30)] beginBackgroundTaskWithExpirationHandler:OCMOCK_ANY];
+    [[[self.mockApplication stub] ignoringNonObjectArgs] endBackgroundTask:0];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+
+    UAAttributeMutations *firstMutations = [UAAttributeMutations mutations];
+    [firstMutations setString:@"coffee" forAttribute:@"cup"];
+    [firstMutations setString:@"water" forAttribute:@"glass"];
+
+    UAAttributeMutations *secondMutations = [UAAttributeMutations mutations];
+    [secondMutations setString:@"tea" forAttribute:@"cup"];
+
+    [self.registrar savePendingMutations:[UAAttributePendingMutations pendingMutationsWithMutations:firstMutations date:self.testDate]];
+    [self.registrar savePendingMutations:[UAAttributePendingMutations pendingMutationsWithMutations:secondMutations date:self.testDate]];
+
+    self.registrar = [UAAttributeRegistrar registrarWithDataStore:self.dataStore
+                                                        apiClient:self.mockApiClient
+                                                   operationQueue:self.operationQueue
+                                                      application:self.mockApplication
+                                                             date:self.testDate];
+
+    XCTestExpectation *uploaded = [self expectationWithDescription:@"Uploaded mutations"];
+    [[[self.mockApiClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        UAAttributeAPIClientSuccessBlock onSuccess = (__bridge UAAttributeAPIClientSuccessBlock)arg;
+        onSuccess();
+        [uploaded fulfill];
+    }] updateChannel:self.channelID withAttributePayload:[OCMArg checkWithBlock:^BOOL(id obj) {
+        NSArray *mutations = obj[@"attributes"];
+        return mutations.count == 2 &&
+            [mutations[0][@"key"] isEqualToString:@"glass"] &&
+            [mutations[1][@"key"] isEqualToString:@"cup"] &&
+            [mutations[1][@"value"] isEqualToString:@"tea"];
+    }] onSuccess:OCMOCK_ANY onFailure:OCMOCK_ANY];
+
+    [self.registrar updateAttributesForChannel:self.channelID];
+
+    [self waitForTestExpectations];
+    [self.mockApiClient verify];
+}
+
 @end
@@ -11,12 +11,14 @@
 #import "UAScheduleDelay.h"
 #import "UAScheduleData+Internal.h"
 #import "UAScheduleInfo+Internal.h"
+#import "UASchedule+Internal.h"
 #import "UAActionScheduleInfo.h"
 #import "UAActionAutomation+Internal.h"
 #import "UAApplicationMetrics+Internal.h"
 #import "UATestDispatcher.h"
 #import "UATestDate.h"
 #import "UAAppStateTracker.h"
+#import "NSJSONSerialization+UAAdditions.h"
 
 @interface UAAutomationEngineIntegrationTest : UABaseTest
 @property (nonatomic, strong) UAAutomationEngine *automationEngine;
@@ -1165,6 +1167,322 @@
     [self waitForTestExpectations];
 }
 
+- (void)testBulkEdits {
+    UAActionScheduleInfo *(^scheduleInfo)(void) = ^{
+        return [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+            builder.actions = @{@"test action": @"test value"};
+            builder.editGracePeriod = 1000;
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+        }];
+    };
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    __block NSArray<UASchedule *> *existing;
+    [self.automationEngine scheduleMultiple:@[scheduleInfo(), scheduleInfo()] metadata:@{} completionHandler:^(NSArray<UASchedule *> *schedules) {
+        existing = schedules;
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    NSString *editedID = existing[0].identifier;
+    NSString *endedID = existing[1].identifier;
+
+    NSDate *endDate = [NSDate dateWithTimeIntervalSince1970:0];
+    NSDictionary *edits = @{
+        editedID: [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+            builder.priority = @(5);
+        }],
+        endedID: [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+            builder.start = endDate;
+            builder.end = endDate;
+        }],
+        @"missing": [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+            builder.priority = @(1);
+        }]
+    };
+
+    [[self.mockDelegate expect] onScheduleExpired:[OCMArg checkWithBlock:^BOOL(id obj) {
+        return [((UASchedule *)obj).identifier isEqualToString:endedID];
+    }]];
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    __block NSString *newID;
+    [self.automationEngine editSchedules:edits newSchedules:@[scheduleInfo()] metadata:@{} completionHandler:^(NSArray<UASchedule *> *schedules) {
+        XCTAssertEqual(1, schedules.count);
+        newID = schedules.firstObject.identifier;
+
+        // Delegate callbacks are delivered before the completion handler
+        [self.mockDelegate verify];
+        [edited fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.automationEngine.automationStore getAllSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
+        XCTAssertEqual(3, schedulesData.count);
+        for (UAScheduleData *scheduleData in schedulesData) {
+            if ([scheduleData.identifier isEqualToString:editedID]) {
+                XCTAssertEqualObjects(@(5), scheduleData.priority);
+            } else if ([scheduleData.identifier isEqualToString:endedID]) {
+                XCTAssertEqual(UAScheduleStateFinished, [scheduleData.executionState intValue]);
+            } else {
+                XCTAssertEqualObjects(newID, scheduleData.identifier);
+            }
+        }
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)testTriggerPredicateCache {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"test action": @"test value"};
+
+        UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:@"purchase"];
+        UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+        UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+        // A high goal keeps the schedule from executing while events are emitted
+        builder.triggers = @[[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:10]];
+    }];
+
+    XCTestExpectation *actionsScheduled = [self expectationWithDescription:@"actions scheduled"];
+    __block NSString *identifier;
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        identifier = schedule.identifier;
+        [actionsScheduled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    UAScheduleTriggerPredicateCache *cache = self.automationEngine.triggerPredicateCache;
+    NSUInteger hits = cache.hitCount;
+    NSUInteger misses = cache.missCount;
+
+    // First event compiles the predicate, the second one reuses it
+    UACustomEvent *purchase = [UACustomEvent eventWithName:@"purchase"];
+    [self emitEvent:purchase];
+    [self emitEvent:purchase];
+    [self.testStore waitForIdle];
+
+    XCTAssertEqual(misses + 1, cache.missCount);
+    XCTAssertEqual(hits + 1, cache.hitCount);
+
+    // Editing the schedule invalidates its cached predicates
+    UAActionScheduleEdits *edits = [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+        builder.priority = @(2);
+    }];
+
+    XCTestExpectation *updated = [self expectationWithDescription:@"schedule updated"];
+    [self.automationEngine editScheduleWithID:identifier edits:edits completionHandler:^(UASchedule *schedule) {
+        [updated fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    [self emitEvent:purchase];
+    [self.testStore waitForIdle];
+
+    XCTAssertEqual(misses + 2, cache.missCount);
+    XCTAssertEqual(hits + 1, cache.hitCount);
+}
+
+/**
+ * Test events that no stored trigger can match are dropped before the store is queried.
+ */
+- (void)testUnmatchedEventsSkipTriggers {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"test action": @"test value"};
+
+        UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:@"purchase"];
+        UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+        UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+        builder.triggers = @[[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:10]];
+    }];
+
+    XCTestExpectation *actionsScheduled = [self expectationWithDescription:@"actions scheduled"];
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        [actionsScheduled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    UAScheduleTriggerPredicateCache *cache = self.automationEngine.triggerPredicateCache;
+    NSUInteger hits = cache.hitCount;
+    NSUInteger misses = cache.missCount;
+
+    // The trigger is never loaded, so its predicate is never evaluated
+    UACustomEvent *view = [UACustomEvent eventWithName:@"view"];
+    [self emitEvent:view];
+    [self emitEvent:view];
+    [self.testStore waitForIdle];
+
+    XCTAssertEqual(misses, cache.missCount);
+    XCTAssertEqual(hits, cache.hitCount);
+
+    // A matching event still reaches the trigger
+    [self emitEvent:[UACustomEvent eventWithName:@"purchase"]];
+    [self.testStore waitForIdle];
+
+    XCTAssertEqual(misses + 1, cache.missCount);
+}
+
+- (void)testTriggerIndex {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"test action": @"test value"};
+
+        UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:@"purchase"];
+        UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+        UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+        builder.triggers = @[[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:1]];
+    }];
+
+    UACustomEvent *purchase = [UACustomEvent eventWithName:@"purchase"];
+    UACustomEvent *view = [UACustomEvent eventWithName:@"view"];
+
+    XCTAssertFalse([self.testStore containsTriggersWithType:UAScheduleTriggerCustomEventCount argument:purchase.payload]);
+
+    XCTestExpectation *actionsScheduled = [self expectationWithDescription:@"actions scheduled"];
+    __block NSString *identifier;
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        identifier = schedule.identifier;
+        [actionsScheduled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    XCTAssertTrue([self.testStore containsTriggersWithType:UAScheduleTriggerCustomEventCount argument:purchase.payload]);
+    XCTAssertFalse([self.testStore containsTriggersWithType:UAScheduleTriggerCustomEventCount argument:view.payload]);
+    XCTAssertFalse([self.testStore containsTriggersWithType:UAScheduleTriggerCustomEventValue argument:purchase.payload]);
+    XCTAssertFalse([self.testStore containsTriggersWithType:UAScheduleTriggerScreen argument:@"screen"]);
+
+    [self.automationEngine cancelScheduleWithID:identifier];
+    [self.testStore waitForIdle];
+
+    XCTAssertFalse([self.testStore containsTriggersWithType:UAScheduleTriggerCustomEventCount argument:purchase.payload]);
+}
+
+- (void)testMessageScheduleIndex {
+    UAScheduleInfoBuilder *messageBuilder = [[UAScheduleInfoBuilder alloc] init];
+    messageBuilder.data = [NSJSONSerialization stringWithObject:@{@"message_id": @"message-id", @"source": @"remote-data"}];
+    messageBuilder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+    UASchedule *messageSchedule = [UASchedule scheduleWithIdentifier:@"message-schedule"
+                                                                info:[[UAScheduleInfo alloc] initWithBuilder:messageBuilder]
+                                                            metadata:@{}];
+
+    UAActionScheduleInfo *actionInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+    }];
+    UASchedule *actionSchedule = [UASchedule scheduleWithIdentifier:@"action-schedule" info:actionInfo metadata:@{}];
+
+    XCTestExpectation *saved = [self expectationWithDescription:@"schedules saved"];
+    [self.testStore saveSchedules:@[messageSchedule, actionSchedule] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [saved fulfill];
+    }];
+
+    // Only the message schedule is indexed
+    XCTestExpectation *fetched = [self expectationWithDescription:@"index fetched"];
+    [self.testStore getMessageScheduleIndex:^(NSArray<UAScheduleIndexEntry *> *entries) {
+        XCTAssertEqual(1, entries.count);
+        XCTAssertEqualObjects(@"message-schedule", entries.firstObject.scheduleID);
+        XCTAssertEqualObjects(@"message-id", entries.firstObject.messageID);
+        XCTAssertEqualObjects(@"remote-data", entries.firstObject.messageSource);
+        XCTAssertNotNil(entries.firstObject.lastUpdated);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test start does not query the store, and events received before activation are applied once activated.
+ */
+- (void)testStartDefersStoreAccess {
+    id mockStore = [self mockForClass:[UAAutomationStore class]];
+
+    __block NSUInteger storeQueries = 0;
+    [[[mockStore stub] andDo:^(NSInvocation *invocation) {
+        storeQueries++;
+    }] getActiveExpiredSchedules:OCMOCK_ANY];
+
+    [[[mockStore stub] andDo:^(NSInvocation *invocation) {
+        storeQueries++;
+    }] getSchedulesWithStates:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    NSMutableArray *triggerTypes = [NSMutableArray array];
+    [[[[mockStore stub] andDo:^(NSInvocation *invocation) {
+        UAScheduleTriggerType type;
+        [invocation getArgument:&type atIndex:2];
+        [triggerTypes addObject:@(type)];
+    }] ignoringNonObjectArgs] containsTriggersWithType:0 argument:OCMOCK_ANY];
+
+    NSNotificationCenter *notificationCenter = [[NSNotificationCenter alloc] init];
+    UAAutomationEngine *engine = [UAAutomationEngine automationEngineWithAutomationStore:mockStore
+                                                                         appStateTracker:self.mockAppStateTracker
+                                                                          timerScheduler:self.timerScheduler
+                                                                      notificationCenter:notificationCenter
+                                                                              dispatcher:self.dispatcher
+                                                                             application:self.mockedApplication
+                                                                                    date:self.testDate];
+
+    [engine start];
+    [notificationCenter postNotificationName:UAApplicationDidTransitionToForeground object:nil];
+
+    XCTAssertEqual(0, storeQueries);
+    XCTAssertEqual(0, triggerTypes.count);
+
+    [engine activateIfNeeded];
+
+    XCTAssertTrue(storeQueries > 0);
+    NSArray *expected = @[@(UAScheduleTriggerAppInit), @(UAScheduleTriggerAppForeground), @(UAScheduleTriggerActiveSession)];
+    XCTAssertEqualObjects(expected, triggerTypes);
+
+    [engine stop];
+}
+
+- (void)testPendingTriggerUpdatesCoalescedAndCapped {
+    id mockStore = [self mockForClass:[UAAutomationStore class]];
+
+    NSMutableArray *triggerTypes = [NSMutableArray array];
+    [[[[mockStore stub] andDo:^(NSInvocation *invocation) {
+        UAScheduleTriggerType type;
+        [invocation getArgument:&type atIndex:2];
+        [triggerTypes addObject:@(type)];
+    }] ignoringNonObjectArgs] containsTriggersWithType:0 argument:OCMOCK_ANY];
+
+    NSNotificationCenter *notificationCenter = [[NSNotificationCenter alloc] init];
+    UAAutomationEngine *engine = [UAAutomationEngine automationEngineWithAutomationStore:mockStore
+                                                                         appStateTracker:self.mockAppStateTracker
+                                                                          timerScheduler:self.timerScheduler
+                                                                      notificationCenter:notificationCenter
+                                                                              dispatcher:self.dispatcher
+                                                                             application:self.mockedApplication
+                                                                                    date:self.testDate];
+
+    [engine start];
+
+    // Repeated foregrounds coalesce into a single update per trigger type
+    for (int i = 0; i < 3; i++) {
+        [notificationCenter postNotificationName:UAApplicationDidTransitionToForeground object:nil];
+    }
+
+    // Distinct screens are capped
+    for (int i = 0; i < 200; i++) {
+        [notificationCenter postNotificationName:UAScreenTracked
+                                          object:nil
+                                        userInfo:@{UAScreenKey: [NSString stringWithFormat:@"screen %d", i]}];
+    }
+
+    [engine activateIfNeeded];
+
+    XCTAssertEqual(100, triggerTypes.count);
+    NSArray *expected = @[@(UAScheduleTriggerAppInit), @(UAScheduleTriggerAppForeground), @(UAScheduleTriggerActiveSession)];
+    XCTAssertEqualObjects(expected, [triggerTypes subarrayWithRange:NSMakeRange(0, 3)]);
+
+    [engine stop];
+}
+
 - (void)testPrepareResultCancel {
     [self verifyPrepareResult:UAAutomationSchedulePrepareResultCancel verifyWithCompletionHandler:^(UAScheduleData *data) {
         XCTAssertNil(data);
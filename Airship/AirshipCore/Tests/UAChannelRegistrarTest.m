@@ -277,6 +277,56 @@ NSString * const ChannelCreateSuccessChannelID = @"newChannelID";
 }
 
 
+/**
+ * Test the last successful payload is restored by a new registrar.
+ */
+- (void)testRegisterWithRestoredLastPayload {
+    // Setup by registering
+    [self registerWithExisting:NO];
+    [self verifyChannelClientCreateChannelWithPayload];
+
+    // A new registrar loads the last payload from the data store
+    self.registrar = [self createRegistrarWithChannelID:ChannelCreateSuccessChannelID];
+    XCTAssertEqualObjects(self.payload, self.registrar.lastSuccessfulPayload);
+
+    // Reject a update call on a non-forceful update with the same payload
+    [self rejectChannelClientUpdateChannel];
+    [self.registrar registerForcefully:NO];
+    [self verifyRejectChannelClientUpdateChannel];
+}
+
+/**
+ * Test updates only include the optional fields that changed.
+ */
+- (void)testUpdateWithChangedPayload {
+    self.payload.country = @"country";
+    self.payload.language = @"language";
+
+    // Setup by registering
+    [self registerWithExisting:NO];
+    [self verifyChannelClientCreateChannelWithPayload];
+
+    self.payload.country = @"country CHANGED";
+
+    XCTestExpectation *updated = [self expectationWithDescription:@"Channel updated"];
+    [[[self.mockedChannelClient expect] andDo:^(NSInvocation *invocation) {
+        channelUpdateSuccessDoBlock(invocation);
+        [updated fulfill];
+    }] updateChannelWithID:ChannelCreateSuccessChannelID withPayload:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UAChannelRegistrationPayload *payload = obj;
+        return [payload.country isEqualToString:@"country CHANGED"] && !payload.language;
+    }] onSuccess:OCMOCK_ANY onFailure:OCMOCK_ANY];
+
+    [self expectRegistrationSucceededDelegateCallback];
+    [self expectBackgroundTaskToBeStartedAndStopped];
+
+    [self.registrar registerForcefully:NO];
+
+    [self waitForTestExpectations];
+    [self.mockedChannelClient verify];
+    XCTAssertEqualObjects(self.payload, self.registrar.lastSuccessfulPayload);
+}
+
 /**
  * Test that registering when a request is in progress
  * does not attempt to register again
@@ -322,6 +322,62 @@
     XCTAssertNil([dict valueForKey:UAChannelIdentityHintsKey], @"identity hints section should not be included in the payload");
 }
 
+- (void)testContentDigest {
+    UAChannelRegistrationPayload *copy = [self.payload copy];
+    XCTAssertEqualObjects([self.payload contentDigest], [copy contentDigest]);
+
+    // Stable across serialization
+    UAChannelRegistrationPayload *fromData = [UAChannelRegistrationPayload channelRegistrationPayloadWithData:[self.payload asJSONData]];
+    XCTAssertEqualObjects([self.payload contentDigest], [fromData contentDigest]);
+
+    copy.carrier = @"carrier CHANGED";
+    XCTAssertNotEqualObjects([self.payload contentDigest], [copy contentDigest]);
+
+    copy.carrier = self.payload.carrier;
+    copy.tags = @[@"tagTwo", @"tagOne"];
+    XCTAssertNotEqualObjects([self.payload contentDigest], [copy contentDigest]);
+}
+
+- (void)testChangedFieldsFromPayload {
+    UAChannelRegistrationPayload *copy = [self.payload copy];
+    XCTAssertEqualObjects([NSSet set], [self.payload changedFieldsFromPayload:copy]);
+
+    copy.country = @"country CHANGED";
+    copy.deviceOS = nil;
+    copy.tags = @[@"tags CHANGED"];
+
+    NSSet *expected = [NSSet setWithArray:@[UAChannelTopLevelCountryJSONKey, UAChannelTopLevelDeviceOSJSONKey, UAChannelTagsJSONKey]];
+    XCTAssertEqualObjects(expected, [self.payload changedFieldsFromPayload:copy]);
+
+    // Tags are always sent if the last payload did not set them
+    copy = [self.payload copy];
+    copy.setTags = NO;
+    XCTAssertEqualObjects([NSSet setWithObject:UAChannelTagsJSONKey], [self.payload changedFieldsFromPayload:copy]);
+}
+
+- (void)testMinimalUpdatePayloadWithChangedFields {
+    NSSet *changedFields = [NSSet setWithArray:@[UAChannelTopLevelCountryJSONKey, UAChannelTagsJSONKey]];
+    UAChannelRegistrationPayload *minPayload = [self.payload minimalUpdatePayloadWithChangedFields:changedFields];
+
+    XCTAssertEqualObjects(self.payload.country, minPayload.country);
+    XCTAssertEqualObjects(self.payload.tags, minPayload.tags);
+    XCTAssertTrue(minPayload.setTags);
+
+    XCTAssertNil(minPayload.language);
+    XCTAssertNil(minPayload.timeZone);
+    XCTAssertNil(minPayload.locationSettings);
+    XCTAssertNil(minPayload.SDKVersion);
+    XCTAssertNil(minPayload.appVersion);
+    XCTAssertNil(minPayload.deviceModel);
+    XCTAssertNil(minPayload.deviceOS);
+    XCTAssertNil(minPayload.carrier);
+    XCTAssertNil(minPayload.userID);
+    XCTAssertNil(minPayload.deviceID);
+
+    XCTAssertEqualObjects(self.payload.pushAddress, minPayload.pushAddress);
+    XCTAssertEqualObjects(self.payload.badge, minPayload.badge);
+}
+
 - (void)testMinimalUpdatePayloadSameValues {
     UAChannelRegistrationPayload *minPayload = [self.payload minimalUpdatePayloadWithLastPayload:self.payload];
     XCTAssertNil(minPayload.country);
@@ -0,0 +1,112 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAJSONPredicate.h"
+#import "UACompiledJSONPredicate.h"
+
+@interface UACompiledJSONPredicateTests : UABaseTest
+@property (nonatomic, copy) NSArray *objects;
+@end
+
+@implementation UACompiledJSONPredicateTests
+
+- (void)setUp {
+    [super setUp];
+
+    self.objects = @[@{@"foo": @"bar", @"cool": @"story", @"count": @(5)},
+                     @{@"foo": @"BAR", @"cool": @"not story"},
+                     @{@"foo": @{@"nested": @"value"}, @"count": @(100)},
+                     @{@"version": @"1.2.3", @"list": @[@"a", @"b", @{@"c": @"d"}]},
+                     @{@"version": @(1), @"list": @"a"},
+                     @{},
+                     @"bar",
+                     @(5),
+                     @[@"bar"],
+                     [NSNull null]];
+}
+
+- (void)testMatchesTreeEvaluation {
+    NSArray *predicates = @[
+        @{@"value": @{@"equals": @"bar"}},
+        @{@"value": @{@"equals": @"bar"}, @"key": @"foo"},
+        @{@"value": @{@"equals": @"bar"}, @"scope": @[@"foo"], @"ignore_case": @YES},
+        @{@"value": @{@"equals": @"value"}, @"scope": @[@"foo"], @"key": @"nested"},
+        @{@"value": @{@"is_present": @YES}, @"key": @"cool"},
+        @{@"value": @{@"is_present": @NO}, @"key": @"cool"},
+        @{@"value": @{@"at_least": @(5)}, @"key": @"count"},
+        @{@"value": @{@"at_least": @(1), @"at_most": @(10)}, @"key": @"count"},
+        @{@"value": @{@"at_most": @(5)}},
+        @{@"value": @{@"version_matches": @"[1.0,2.0["}, @"key": @"version"},
+        @{@"value": @{@"version": @"1.2.+"}, @"key": @"version"},
+        @{@"value": @{@"array_contains": @{@"value": @{@"equals": @"b"}}}, @"key": @"list"},
+        @{@"value": @{@"array_contains": @{@"value": @{@"equals": @"d"}, @"key": @"c"}, @"index": @(2)}, @"key": @"list"},
+        @{@"value": @{@"array_contains": @{@"value": @{@"equals": @"b"}}, @"index": @(0)}, @"key": @"list"},
+        @{@"value": @{@"array_contains": @{@"value": @{@"equals": @"bar"}}}},
+        @{@"and": @[@{@"value": @{@"equals": @"bar"}, @"key": @"foo"},
+                    @{@"value": @{@"equals": @"story"}, @"key": @"cool"}]},
+        @{@"or": @[@{@"value": @{@"equals": @"bar"}, @"key": @"foo"},
+                   @{@"value": @{@"at_least": @(50)}, @"key": @"count"},
+                   @{@"value": @{@"is_present": @YES}, @"key": @"version"}]},
+        @{@"not": @[@{@"value": @{@"equals": @"bar"}, @"key": @"foo"}]},
+        @{@"and": @[@{@"or": @[@{@"value": @{@"equals": @"bar"}, @"key": @"foo", @"ignore_case": @YES},
+                               @{@"value": @{@"is_present": @YES}, @"key": @"list"}]},
+                    @{@"not": @[@{@"and": @[@{@"value": @{@"equals": @"story"}, @"key": @"cool"},
+                                            @{@"value": @{@"at_most": @(1)}, @"key": @"count"}]}]}]},
+        @{@"or": @[@{@"not": @[@{@"value": @{@"is_present": @YES}, @"key": @"foo"}]},
+                   @{@"and": @[@{@"value": @{@"at_least": @(10)}, @"key": @"count"},
+                               @{@"value": @{@"equals": @"value"}, @"scope": @[@"foo", @"nested"]}]}]}
+    ];
+
+    for (NSDictionary *json in predicates) {
+        NSError *error;
+        UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:json error:&error];
+        XCTAssertNotNil(predicate, @"%@", error);
+
+        UACompiledJSONPredicate *compiled = [UACompiledJSONPredicate compiledPredicateWithPredicate:predicate];
+        XCTAssertEqual(predicate, compiled.predicate);
+
+        for (id object in self.objects) {
+            XCTAssertEqual([predicate evaluateObject:object], [compiled evaluateObject:object], @"%@ %@", json, object);
+        }
+
+        XCTAssertEqual([predicate evaluateObject:nil], [compiled evaluateObject:nil], @"%@", json);
+    }
+}
+
+- (void)testEmptySubpredicates {
+    UACompiledJSONPredicate *andPredicate = [UACompiledJSONPredicate compiledPredicateWithPredicate:[UAJSONPredicate andPredicateWithSubpredicates:@[]]];
+    XCTAssertTrue([andPredicate evaluateObject:@"anything"]);
+
+    UACompiledJSONPredicate *orPredicate = [UACompiledJSONPredicate compiledPredicateWithPredicate:[UAJSONPredicate orPredicateWithSubpredicates:@[]]];
+    XCTAssertFalse([orPredicate evaluateObject:@"anything"]);
+}
+
+- (void)testInvalidJSON {
+    NSError *error;
+    XCTAssertNil([UACompiledJSONPredicate compiledPredicateWithJSON:@{@"not": @[]} error:&error]);
+    XCTAssertEqualObjects(UAJSONPredicateErrorDomain, error.domain);
+
+    XCTAssertNil([UACompiledJSONPredicate compiledPredicateWithJSON:@"invalid" error:nil]);
+}
+
+- (void)testEvaluatePerformance {
+    NSMutableArray *compiled = [NSMutableArray array];
+    for (int i = 0; i < 500; i++) {
+        NSDictionary *json = @{@"and": @[@{@"value": @{@"equals": [NSString stringWithFormat:@"event-%d", i % 10]}, @"key": @"event_name"},
+                                         @{@"or": @[@{@"value": @{@"at_least": @(i)}, @"scope": @[@"properties"], @"key": @"price"},
+                                                    @{@"value": @{@"is_present": @YES}, @"scope": @[@"properties"], @"key": @"coupon"}]}]};
+        [compiled addObject:[UACompiledJSONPredicate compiledPredicateWithJSON:json error:nil]];
+    }
+
+    NSDictionary *event = @{@"event_name": @"event-3", @"properties": @{@"price": @(250)}};
+
+    [self measureBlock:^{
+        for (int i = 0; i < 100; i++) {
+            for (UACompiledJSONPredicate *predicate in compiled) {
+                [predicate evaluateObject:event];
+            }
+        }
+    }];
+}
+
+@end
@@ -319,6 +319,7 @@
     XCTAssertTrue(copy.messageCenterStyleConfig == config.messageCenterStyleConfig);
     XCTAssertTrue(copy.itunesID == config.itunesID);
     XCTAssertTrue(copy.requestAuthorizationToUseNotifications == config.requestAuthorizationToUseNotifications);
+    XCTAssertTrue(copy.moduleActivationDelay == config.moduleActivationDelay);
 }
 
 - (void) testInitialConfig {
@@ -342,6 +343,7 @@
     XCTAssertFalse(config.channelCreationDelayEnabled);
     XCTAssertTrue(config.defaultDetectProvisioningMode);
     XCTAssertTrue(config.requestAuthorizationToUseNotifications);
+    XCTAssertEqual(config.moduleActivationDelay, 10);
 }
 
 @end
@@ -413,6 +413,56 @@
     XCTAssertTrue(event.isValid);
 }
 
+/**
+ * Test the payload contains the same data as the event's data dictionary.
+ */
+- (void)testPayload {
+    [[[self.analytics stub] andReturn:@"send ID"] conversionSendID];
+
+    UACustomEvent *event = [UACustomEvent eventWithName:@"event \"name\"" value:@(123.123456789)];
+    event.transactionID = @"transaction ID";
+    event.interactionID = @"interaction ID";
+    event.interactionType = @"interaction type";
+    [event setStringProperty:@"some \"quoted\" value" forKey:@"string"];
+    [event setNumberProperty:@(123.456789) forKey:@"double"];
+    [event setNumberProperty:@(0.1 + 0.2) forKey:@"sum"];
+    [event setNumberProperty:@(NAN) forKey:@"nan"];
+    [event setBoolProperty:YES forKey:@"bool"];
+    [event setStringArrayProperty:@[@"one", @"two"] forKey:@"array"];
+
+    NSData *payload = [event payloadWithSessionID:@"session"];
+    NSDictionary *decoded = [NSJSONSerialization JSONObjectWithData:payload options:0 error:nil];
+
+    NSMutableDictionary *expectedData = [event.data mutableCopy];
+    expectedData[@"session_id"] = @"session";
+
+    XCTAssertEqualObjects(event.eventID, decoded[@"event_id"]);
+    XCTAssertEqualObjects(event.time, decoded[@"time"]);
+    XCTAssertEqualObjects(@"custom_event", decoded[@"type"]);
+    XCTAssertEqualObjects(expectedData, decoded[@"data"]);
+    XCTAssertEqual(payload.length - [@",\"session_id\":\"session\"" lengthOfBytesUsingEncoding:NSUTF8StringEncoding], event.jsonEventSize);
+
+    // The non-finite property is left out instead of dropping the event
+    XCTAssertNil(decoded[@"data"][@"properties"][@"nan"]);
+    XCTAssertEqualObjects(@"0.30000000000000004", decoded[@"data"][@"properties"][@"sum"]);
+}
+
+/**
+ * Test the properties object is left out of the payload when none of the properties can be encoded.
+ */
+- (void)testPayloadInvalidProperties {
+    UACustomEvent *event = [UACustomEvent eventWithName:@"event name"];
+    [event setNumberProperty:@(NAN) forKey:@"nan"];
+    [event setNumberProperty:@(INFINITY) forKey:@"infinity"];
+
+    NSData *payload = [event payloadWithSessionID:nil];
+    XCTAssertNotNil(payload);
+
+    NSDictionary *decoded = [NSJSONSerialization JSONObjectWithData:payload options:0 error:nil];
+    XCTAssertEqualObjects(event.data, decoded[@"data"]);
+    XCTAssertNil(decoded[@"data"][@"properties"]);
+}
+
 /**
  * Test max number of properties is 100.
  */
@@ -64,7 +64,7 @@
     [(UARequestSession *)[self.mockSession expect] dataTaskWithRequest:[OCMArg checkWithBlock:checkRequestBlock]
                                                      completionHandler:OCMOCK_ANY];
 
-    [self.client uploadEvents:@[@{@"some": @"event"}] headers:headers
+    [self.client uploadEventPayloads:@[[@"{\"some\":\"event\"}" dataUsingEncoding:NSUTF8StringEncoding]] headers:headers
             completionHandler:^(NSHTTPURLResponse *response) {}];
 
     [self.mockSession verify];
@@ -86,7 +86,7 @@
     }] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called"];
-    [self.client uploadEvents:@[@{@"some": @"event"}] headers:@{} completionHandler:^(NSHTTPURLResponse *response) {
+    [self.client uploadEventPayloads:@[[@"{\"some\":\"event\"}" dataUsingEncoding:NSUTF8StringEncoding]] headers:@{} completionHandler:^(NSHTTPURLResponse *response) {
         XCTAssertEqualObjects(response, expectedResponse);
         [expectation fulfill];
     }];
@@ -94,8 +94,19 @@
     [self waitForTestExpectations];
 }
 
+/**
+ * Test the event payloads are spliced into a JSON array.
+ */
+- (void)testEventRequestBody {
+    NSArray *payloads = @[[@"{\"event_id\":\"one\"}" dataUsingEncoding:NSUTF8StringEncoding],
+                          [@"{\"event_id\":\"two\"}" dataUsingEncoding:NSUTF8StringEncoding]];
 
+    NSData *body = [UAEventAPIClient bodyWithEventPayloads:payloads];
+    NSString *bodyString = [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(@"[{\"event_id\":\"one\"},{\"event_id\":\"two\"}]", bodyString);
 
-
+    NSArray *events = [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+    XCTAssertEqualObjects((@[@{@"event_id": @"one"}, @{@"event_id": @"two"}]), events);
+}
 
 @end
@@ -21,6 +21,7 @@
 @interface UAEventTestData : NSObject
 @property (nullable, nonatomic, strong) NSString *sessionID;
 @property (nullable, nonatomic, strong) NSData *data;
+@property (nullable, nonatomic, strong) NSData *payload;
 @property (nullable, nonatomic, strong) NSString *time;
 @property (nullable, nonatomic, strong) NSString *type;
 @property (nullable, nonatomic, strong) NSString *identifier;
@@ -325,6 +326,27 @@
     [self.mockQueue verify];
 }
 
+/**
+ * Test scheduling uploads for a later time coalesces into the pending upload.
+ */
+- (void)testCoalesceLaterUploads {
+    // Add a high priority event (delay 1ish seconds)
+    [self testAddHighPriorityEvent];
+
+    // Later requests must not cancel or enqueue another upload
+    [[self.mockQueue reject] cancelAllOperations];
+    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+
+    for (int i = 0; i < 100; i++) {
+        UACustomEvent *event = [UACustomEvent eventWithName:@"cool"];
+        [self.eventManager addEvent:event sessionID:@"story"];
+    }
+
+    [self.mockQueue verify];
+    XCTAssertEqual(101, self.eventManager.uploadScheduleRequestCount);
+    XCTAssertEqual(100, self.eventManager.coalescedUploadScheduleRequestCount);
+}
+
 /**
  * Test uploading events.
  */
@@ -378,12 +400,14 @@
         NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
         returnBlock(response);
         [clientCalled fulfill];
-    }] uploadEvents:[OCMArg checkWithBlock:^BOOL(id obj) {
-        NSArray *events = (NSArray *)obj;
-        if (events.count != 1) {
+    }] uploadEventPayloads:[OCMArg checkWithBlock:^BOOL(id obj) {
+        NSArray *payloads = (NSArray *)obj;
+        if (payloads.count != 1) {
             return NO;
         }
 
+        NSArray *events = @[[NSJSONSerialization JSONObjectWithData:payloads[0] options:0 error:nil]];
+
         if (![events[0][@"event_id"] isEqualToString:@"mock_event_id"]) {
             return NO;
         }
@@ -417,6 +441,134 @@
     [self.mockStore verify];
 }
 
+/**
+ * Test stored event payloads are uploaded as is.
+ */
+- (void)testScheduleUploadStoredPayload {
+    // Set a channel ID
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+
+    // Run the operation as when added
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        __weak NSOperation *operation = nil;
+        [invocation getArgument:&operation atIndex:2];
+        [operation start];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+
+    // Set up a mock event data with a stored payload
+    UAEventTestData *eventData = [[UAEventTestData alloc] init];
+    eventData.type = @"mock_event";
+    eventData.time = @"100";
+    eventData.identifier = @"mock_event_id";
+    eventData.sessionID = @"mock_event_session";
+    eventData.payload = [@"{\"event_id\":\"mock_event_id\"}" dataUsingEncoding:NSUTF8StringEncoding];
+
+    // Stub the event store to return the data
+    [[[[self.mockStore expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^returnBlock)(NSArray *result)= (__bridge void (^)(NSArray *))arg;
+        returnBlock(@[eventData]);
+    }] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *clientCalled = [self expectationWithDescription:@"client upload callled."];
+    [[[self.mockClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^returnBlock)(NSHTTPURLResponse *response)= (__bridge void (^)(NSHTTPURLResponse *))arg;
+
+        NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
+        returnBlock(response);
+        [clientCalled fulfill];
+    }] uploadEventPayloads:@[eventData.payload] headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // Expect the store to delete the event
+    [[self.mockStore expect] deleteEventsWithIDs:@[@"mock_event_id"]];
+
+    // Start the upload
+    [self.eventManager scheduleUpload];
+
+    [self waitForTestExpectations];
+
+    [self.mockQueue verify];
+    [self.mockClient verify];
+    [self.mockStore verify];
+}
+
+/**
+ * Test uploads send batches back to back until the store is drained.
+ */
+- (void)testScheduleUploadDrainsStore {
+    // Set a channel ID
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+
+    // Run the operation as when added
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        __weak NSOperation *operation = nil;
+        [invocation getArgument:&operation atIndex:2];
+        [operation start];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+
+    NSMutableArray *batches = [NSMutableArray array];
+    for (NSString *identifier in @[@"first_event_id", @"second_event_id"]) {
+        UAEventTestData *eventData = [[UAEventTestData alloc] init];
+        eventData.type = @"mock_event";
+        eventData.time = @"100";
+        eventData.identifier = identifier;
+        eventData.sessionID = @"mock_event_session";
+        eventData.data = [NSJSONSerialization dataWithJSONObject:@{@"cool": @"story"} options:0 error:nil];
+        [batches addObject:@[eventData]];
+    }
+    [batches addObject:@[]];
+
+    // Stub the event store to return one batch per fetch
+    XCTestExpectation *drained = [self expectationWithDescription:@"store drained"];
+    [[[[self.mockStore stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^returnBlock)(NSArray *result)= (__bridge void (^)(NSArray *))arg;
+
+        NSArray *batch = batches.firstObject;
+        [batches removeObjectAtIndex:0];
+        returnBlock(batch);
+
+        if (!batches.count) {
+            [drained fulfill];
+        }
+    }] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    // Return a 200 for every upload
+    __block NSUInteger uploadCount = 0;
+    [[[self.mockClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^returnBlock)(NSHTTPURLResponse *response)= (__bridge void (^)(NSHTTPURLResponse *))arg;
+
+        uploadCount++;
+        NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
+        returnBlock(response);
+    }] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // Expect each batch to be deleted
+    [[self.mockStore expect] deleteEventsWithIDs:@[@"first_event_id"]];
+    [[self.mockStore expect] deleteEventsWithIDs:@[@"second_event_id"]];
+
+    // Start the upload
+    [self.eventManager scheduleUpload];
+
+    [self waitForTestExpectations];
+
+    XCTAssertEqual(2, uploadCount);
+    [self.mockQueue verify];
+    [self.mockStore verify];
+}
+
 /**
  * Test uploading events when uploads are disabled.
  */
@@ -435,7 +587,7 @@
     [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
 
     // Reject any calls to the client
-    [[self.mockClient reject] uploadEvents:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[self.mockClient reject] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     [self.eventManager scheduleUpload];
@@ -505,7 +657,7 @@
         // Return a 400 response
         NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:400 HTTPVersion:nil headerFields:nil];
         returnBlock(response);
-    }] uploadEvents:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    }] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // Expect the store to delete the event
     [[self.mockStore reject] deleteEventsWithIDs:OCMOCK_ANY];
@@ -549,7 +701,7 @@
 
     // Reject store and client calls
     [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
-    [[self.mockClient reject] uploadEvents:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[self.mockClient reject] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // Start the upload
     [self.eventManager scheduleUpload];
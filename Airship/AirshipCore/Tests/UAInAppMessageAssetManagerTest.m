@@ -157,6 +157,100 @@
     [self.mockAssets verify];
 }
 
+/**
+ * Test that onScheduleFinished: waits for the schedule's pending prepare,
+ * so the wipe of the assets can not race the download.
+ */
+- (void)testOnScheduleFinishedWaitsForPrepare {
+    // SETUP
+    UASchedule *schedule = self.scheduleWithMedia;
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    self.assetManager = [UAInAppMessageAssetManager assetManagerWithAssetCache:self.mockAssetCache operationQueue:queue];
+    self.assetManager.prepareAssetsDelegate = self.mockPrepareAssetDelegate;
+    self.assetManager.cachePolicyDelegate = self.mockCachePolicyDelegate;
+
+    // EXPECTATIONS
+    [[[self.mockCachePolicyDelegate stub] andReturnValue:OCMOCK_VALUE(YES)] shouldCacheOnSchedule:OCMOCK_ANY];
+    [[[self.mockAssetCache stub] andReturn:self.mockAssets] assetsForScheduleId:schedule.identifier];
+
+    // assets are released after the prepare finishes, then wiped
+    [self.mockAssetCache setExpectationOrderMatters:YES];
+    [[self.mockAssetCache expect] releaseAssets:schedule.identifier wipeFromDisk:NO];
+    [[self.mockAssetCache expect] releaseAssets:schedule.identifier wipeFromDisk:YES];
+
+    // delegate onSchedule:assets: holds on to the completion handler
+    XCTestExpectation *prepareCalled = [self expectationWithDescription:@"prepare called"];
+    __block void (^prepareBlock)(UAInAppMessagePrepareResult);
+    [[[self.mockPrepareAssetDelegate expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        prepareBlock = [(__bridge void (^)(UAInAppMessagePrepareResult))arg copy];
+        [prepareCalled fulfill];
+    }] onSchedule:OCMOCK_ANY assets:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // TEST
+    [self.assetManager onSchedule:schedule];
+    [self waitForTestExpectations];
+
+    [self.assetManager onScheduleFinished:schedule];
+
+    // VERIFY
+    // the wipe waits behind the pending prepare
+    XCTAssertEqual(2, queue.operationCount);
+
+    prepareBlock(UAInAppMessagePrepareResultSuccess);
+    [queue waitUntilAllOperationsAreFinished];
+
+    [self.mockPrepareAssetDelegate verify];
+    [self.mockAssetCache verify];
+}
+
+/**
+ * Test that different schedules prepare their assets concurrently.
+ */
+- (void)testOnScheduleConcurrentSchedules {
+    // SETUP
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    self.assetManager = [UAInAppMessageAssetManager assetManagerWithAssetCache:self.mockAssetCache operationQueue:queue];
+    self.assetManager.prepareAssetsDelegate = self.mockPrepareAssetDelegate;
+    self.assetManager.cachePolicyDelegate = self.mockCachePolicyDelegate;
+
+    // EXPECTATIONS
+    [[[self.mockCachePolicyDelegate stub] andReturnValue:OCMOCK_VALUE(YES)] shouldCacheOnSchedule:OCMOCK_ANY];
+    [[[self.mockAssetCache stub] andReturn:self.mockAssets] assetsForScheduleId:OCMOCK_ANY];
+    [[self.mockAssetCache expect] releaseAssets:self.scheduleWithMedia.identifier wipeFromDisk:NO];
+    [[self.mockAssetCache expect] releaseAssets:self.scheduleWithoutMedia.identifier wipeFromDisk:NO];
+
+    // delegate onSchedule:assets: holds on to the completion handlers
+    XCTestExpectation *prepareCalled = [self expectationWithDescription:@"prepare called"];
+    prepareCalled.expectedFulfillmentCount = 2;
+    NSMutableArray *prepareBlocks = [NSMutableArray array];
+    [[[self.mockPrepareAssetDelegate stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        @synchronized (prepareBlocks) {
+            [prepareBlocks addObject:[(__bridge void (^)(UAInAppMessagePrepareResult))arg copy]];
+        }
+        [prepareCalled fulfill];
+    }] onSchedule:OCMOCK_ANY assets:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // TEST
+    [self.assetManager onSchedule:self.scheduleWithMedia];
+    [self.assetManager onSchedule:self.scheduleWithoutMedia];
+
+    // VERIFY
+    // both prepares start before either finishes
+    [self waitForTestExpectations];
+    XCTAssertEqual(2, prepareBlocks.count);
+
+    for (void (^prepareBlock)(UAInAppMessagePrepareResult) in prepareBlocks) {
+        prepareBlock(UAInAppMessagePrepareResultSuccess);
+    }
+    [queue waitUntilAllOperationsAreFinished];
+
+    [self.mockAssetCache verify];
+}
+
 /**
  * Test that the onSchedule: method doesn't initialize an Assets instance
  * and doesn't calls the prepare delegate's onSchedule:assets: when the app
@@ -0,0 +1,244 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInAppMessageAssetPrefetcher+Internal.h"
+
+@interface UAInAppMessageAssetPrefetcherTest : UABaseTest
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) id mockSession;
+@property (nonatomic, strong) NSMutableArray *downloadTasks;
+@property (nonatomic, strong) NSMutableArray<NSURLRequest *> *requests;
+@property (nonatomic, strong) NSMutableDictionary<NSURL *, NSData *> *responseBodies;
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, copy) NSDictionary *responseHeaders;
+@property (nonatomic, strong) UAInAppMessageAssetPrefetcher *prefetcher;
+@end
+
+@implementation UAInAppMessageAssetPrefetcherTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+    self.downloadTasks = [NSMutableArray array];
+    self.requests = [NSMutableArray array];
+    self.responseBodies = [NSMutableDictionary dictionary];
+    self.statusCode = 200;
+
+    // Serve downloads from responseBodies asynchronously
+    self.mockSession = [self mockForClass:[NSURLSession class]];
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        NSURLRequest *request = (__bridge NSURLRequest *)arg;
+
+        [invocation getArgument:&arg atIndex:3];
+        void (^completionHandler)(NSURL *, NSURLResponse *, NSError *) = (__bridge void (^)(NSURL *, NSURLResponse *, NSError *))arg;
+
+        id mockTask = [self mockForClass:[NSURLSessionDownloadTask class]];
+        [[[mockTask stub] andDo:^(NSInvocation *invocation) {
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                [self respondToRequest:request completionHandler:completionHandler];
+            });
+        }] resume];
+
+        @synchronized (self) {
+            [self.requests addObject:request];
+            [self.downloadTasks addObject:mockTask];
+        }
+
+        [invocation setReturnValue:&mockTask];
+    }] downloadTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.prefetcher = [self prefetcherWithByteBudget:1024 * 1024];
+}
+
+- (void)tearDown {
+    [self.prefetcher waitForIdle];
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+- (void)testSharedDownload {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/image.png"];
+    NSData *body = [self bodyWithLength:1000 seed:1];
+    self.responseBodies[assetURL] = body;
+
+    NSURL *firstCacheURL = [self cacheURL];
+    NSURL *secondCacheURL = [self cacheURL];
+
+    XCTestExpectation *firstPrefetched = [self expectationWithDescription:@"first prefetched"];
+    [self.prefetcher prefetchAssetURL:assetURL cacheURL:firstCacheURL completionHandler:^(UAInAppMessagePrepareResult result) {
+        XCTAssertEqual(UAInAppMessagePrepareResultSuccess, result);
+        [firstPrefetched fulfill];
+    }];
+
+    XCTestExpectation *secondPrefetched = [self expectationWithDescription:@"second prefetched"];
+    [self.prefetcher prefetchAssetURL:assetURL cacheURL:secondCacheURL completionHandler:^(UAInAppMessagePrepareResult result) {
+        XCTAssertEqual(UAInAppMessagePrepareResultSuccess, result);
+        [secondPrefetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    XCTAssertEqual(1, self.requests.count);
+    XCTAssertEqualObjects(body, [NSData dataWithContentsOfURL:firstCacheURL]);
+    XCTAssertEqualObjects(body, [NSData dataWithContentsOfURL:secondCacheURL]);
+
+    // Both schedules share one file on disk
+    NSFileManager *fm = [NSFileManager defaultManager];
+    XCTAssertEqualObjects([fm attributesOfItemAtPath:firstCacheURL.path error:nil][NSFileSystemFileNumber],
+                          [fm attributesOfItemAtPath:secondCacheURL.path error:nil][NSFileSystemFileNumber]);
+
+    XCTAssertEqual(2, self.prefetcher.requestCount);
+    XCTAssertEqual(1, self.prefetcher.hitCount);
+    XCTAssertEqual(0.5, self.prefetcher.hitRate);
+    XCTAssertEqual(1000, self.prefetcher.bytesSaved);
+    XCTAssertEqual(1000, self.prefetcher.bytesDownloaded);
+}
+
+- (void)testStoreHit {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/image.png"];
+    self.responseBodies[assetURL] = [self bodyWithLength:1000 seed:1];
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURL cacheURL:[self cacheURL]]);
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURL cacheURL:[self cacheURL]]);
+    XCTAssertEqual(1, self.requests.count);
+    XCTAssertEqual(1, self.prefetcher.hitCount);
+
+    // The store index persists across instances
+    [self.prefetcher waitForIdle];
+    self.prefetcher = [self prefetcherWithByteBudget:1024 * 1024];
+    XCTAssertEqual(1000, self.prefetcher.storeSize);
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURL cacheURL:[self cacheURL]]);
+    XCTAssertEqual(1, self.requests.count);
+}
+
+- (void)testContentAddressedStorage {
+    NSData *body = [self bodyWithLength:1000 seed:1];
+    NSURL *firstAssetURL = [NSURL URLWithString:@"https://example.com/image.png"];
+    NSURL *secondAssetURL = [NSURL URLWithString:@"https://cdn.example.com/image.png"];
+    self.responseBodies[firstAssetURL] = body;
+    self.responseBodies[secondAssetURL] = body;
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:firstAssetURL cacheURL:[self cacheURL]]);
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:secondAssetURL cacheURL:[self cacheURL]]);
+
+    // Identical content is stored once
+    XCTAssertEqual(2, self.requests.count);
+    XCTAssertEqual(1000, self.prefetcher.storeSize);
+}
+
+- (void)testConditionalRevalidation {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/image.png"];
+    NSData *body = [self bodyWithLength:1000 seed:1];
+    self.responseBodies[assetURL] = body;
+    self.responseHeaders = @{@"ETag": @"\"v1\"", @"Last-Modified": @"Wed, 21 Oct 2015 07:28:00 GMT"};
+    self.prefetcher.revalidationInterval = 0;
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURL cacheURL:[self cacheURL]]);
+    XCTAssertNil([self.requests[0] valueForHTTPHeaderField:@"If-None-Match"]);
+
+    self.statusCode = 304;
+    self.responseHeaders = @{};
+    NSURL *cacheURL = [self cacheURL];
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURL cacheURL:cacheURL]);
+
+    XCTAssertEqual(2, self.requests.count);
+    XCTAssertEqualObjects(@"\"v1\"", [self.requests[1] valueForHTTPHeaderField:@"If-None-Match"]);
+    XCTAssertEqualObjects(@"Wed, 21 Oct 2015 07:28:00 GMT", [self.requests[1] valueForHTTPHeaderField:@"If-Modified-Since"]);
+    XCTAssertEqualObjects(body, [NSData dataWithContentsOfURL:cacheURL]);
+
+    XCTAssertEqual(1, self.prefetcher.hitCount);
+    XCTAssertEqual(1000, self.prefetcher.bytesSaved);
+    XCTAssertEqual(1000, self.prefetcher.bytesDownloaded);
+}
+
+- (void)testEviction {
+    self.prefetcher = [self prefetcherWithByteBudget:2000];
+
+    NSMutableArray<NSURL *> *assetURLs = [NSMutableArray array];
+    for (int i = 0; i < 3; i++) {
+        NSURL *assetURL = [NSURL URLWithString:[NSString stringWithFormat:@"https://example.com/image-%d.png", i]];
+        self.responseBodies[assetURL] = [self bodyWithLength:1000 seed:i];
+        [assetURLs addObject:assetURL];
+    }
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURLs[0] cacheURL:[self cacheURL]]);
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURLs[1] cacheURL:[self cacheURL]]);
+
+    // Touch the first asset so the second is least recently used
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURLs[0] cacheURL:[self cacheURL]]);
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURLs[2] cacheURL:[self cacheURL]]);
+    XCTAssertEqual(2000, self.prefetcher.storeSize);
+    XCTAssertEqual(3, self.requests.count);
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURLs[0] cacheURL:[self cacheURL]]);
+    XCTAssertEqual(3, self.requests.count);
+
+    XCTAssertEqual(UAInAppMessagePrepareResultSuccess, [self prefetchAssetURL:assetURLs[1] cacheURL:[self cacheURL]]);
+    XCTAssertEqual(4, self.requests.count);
+}
+
+- (void)testServerError {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/image.png"];
+    self.responseBodies[assetURL] = [self bodyWithLength:10 seed:1];
+    self.statusCode = 503;
+
+    XCTAssertEqual(UAInAppMessagePrepareResultRetry, [self prefetchAssetURL:assetURL cacheURL:[self cacheURL]]);
+    XCTAssertEqual(0, self.prefetcher.storeSize);
+    XCTAssertEqual(0, self.prefetcher.hitCount);
+}
+
+#pragma mark -
+#pragma mark Utilities
+
+- (UAInAppMessageAssetPrefetcher *)prefetcherWithByteBudget:(unsigned long long)byteBudget {
+    return [UAInAppMessageAssetPrefetcher prefetcherWithStoreURL:[self.directoryURL URLByAppendingPathComponent:@"store"]
+                                                         session:self.mockSession
+                                                      byteBudget:byteBudget
+                                          maxConcurrentDownloads:2];
+}
+
+- (UAInAppMessagePrepareResult)prefetchAssetURL:(NSURL *)assetURL cacheURL:(NSURL *)cacheURL {
+    __block UAInAppMessagePrepareResult prefetchResult;
+    XCTestExpectation *prefetched = [self expectationWithDescription:@"prefetched"];
+    [self.prefetcher prefetchAssetURL:assetURL cacheURL:cacheURL completionHandler:^(UAInAppMessagePrepareResult result) {
+        prefetchResult = result;
+        [prefetched fulfill];
+    }];
+    [self waitForTestExpectations];
+    return prefetchResult;
+}
+
+- (NSURL *)cacheURL {
+    return [self.directoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (NSData *)bodyWithLength:(NSUInteger)length seed:(uint8_t)seed {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    memset(data.mutableBytes, seed, length);
+    return data;
+}
+
+- (void)respondToRequest:(NSURLRequest *)request completionHandler:(void (^)(NSURL *, NSURLResponse *, NSError *))completionHandler {
+    NSData *body;
+    NSInteger statusCode;
+    NSDictionary *headers;
+    @synchronized (self) {
+        body = self.responseBodies[request.URL];
+        statusCode = self.statusCode;
+        headers = self.responseHeaders;
+    }
+
+    NSURL *location = [self.directoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [body writeToURL:location atomically:YES];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    completionHandler(location, response, nil);
+}
+
+@end
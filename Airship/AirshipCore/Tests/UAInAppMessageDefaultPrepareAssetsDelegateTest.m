@@ -1,7 +1,7 @@
 //* Copyright Airship and Contributors */
 
 #import "UABaseTest.h"
-#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageDefaultPrepareAssetsDelegate+Internal.h"
 #import "UAInAppMessage+Internal.h"
 #import "UAInAppMessageAudience+Internal.h"
 #import "UAInAppMessageBannerDisplayContent.h"
@@ -15,6 +15,7 @@
 @property (nonatomic, strong) UAInAppMessage *messageWithBogusMediaURL;
 @property (nonatomic, strong) NSString *assetCachePath;
 @property (nonatomic, strong) NSURL *cachedAssetURL;
+@property (nonatomic, strong) NSURL *assetStoreURL;
 
 @property (nonatomic, strong) UAInAppMessageDefaultPrepareAssetsDelegate *delegate;
 
@@ -47,8 +48,14 @@
     self.messageWithBogusMediaURL = [self sampleMessageWithMediaURL:self.bogusMediaURL];
 
     self.mockAssets = [self mockForClass:[UAInAppMessageAssets class]];
-    
-    self.delegate = [[UAInAppMessageDefaultPrepareAssetsDelegate alloc] init];
+
+    self.assetStoreURL = [[NSURL fileURLWithPath:tempDirectory] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.delegate = [self delegateWithSession:[NSURLSession sharedSession]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.assetStoreURL error:nil];
+    [super tearDown];
 }
 
 #pragma mark -
@@ -200,10 +207,10 @@
  */
 - (void)testOnPrepare5XXHTTPResponse {
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [self delegateWithSession:mockURLSession];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
@@ -245,10 +252,10 @@
  */
 - (void)testOnPrepareNon200HTTPResponse {
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [self delegateWithSession:mockURLSession];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
@@ -291,17 +298,18 @@
 - (void)testOnPrepareErrorRemovingPreviouslyCachedFile {
     // SETUP
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [self delegateWithSession:mockURLSession];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
     id mockURLResponse = [self mockForClass:[NSHTTPURLResponse class]];
     [[[mockURLResponse stub] andReturnValue:OCMOCK_VALUE(200)] statusCode];
+    NSURL *downloadURL = [self temporaryDownloadURL];
     [[[mockDownloadTask stub] andDo:^(NSInvocation *invocation) {
-        completionHandler([NSURL URLWithString:@"does-not-matter"], mockURLResponse, nil);
+        completionHandler(downloadURL, mockURLResponse, nil);
     }] resume];
 
     id mockFileManager = [self mockForClass:[NSFileManager class]];
@@ -344,17 +352,18 @@
 - (void)testOnPrepareErrorMovingFileToCache {
     // SETUP
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [self delegateWithSession:mockURLSession];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
     id mockURLResponse = [self mockForClass:[NSHTTPURLResponse class]];
     [[[mockURLResponse stub] andReturnValue:OCMOCK_VALUE(200)] statusCode];
+    NSURL *downloadURL = [self temporaryDownloadURL];
     [[[mockDownloadTask stub] andDo:^(NSInvocation *invocation) {
-        completionHandler([NSURL URLWithString:@"does-not-matter"], mockURLResponse, nil);
+        completionHandler(downloadURL, mockURLResponse, nil);
     }] resume];
     
     id mockFileManager = [self mockForClass:[NSFileManager class]];
@@ -397,8 +406,8 @@
 - (void)testOnPrepareAssetsCannotGenerateCacheURL {
     // SETUP
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[mockURLSession reject] sharedSession];
-    [[mockURLSession reject] downloadTaskWithURL:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    self.delegate = [self delegateWithSession:mockURLSession];
+    [[mockURLSession reject] downloadTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
     
     // EXPECTATIONS
     [[[self.mockAssets expect] andReturn:nil] getCacheURL:[OCMArg checkWithBlock:^BOOL(id obj) {
@@ -431,6 +440,22 @@
 #pragma mark -
 #pragma mark Utilities
 
+- (UAInAppMessageDefaultPrepareAssetsDelegate *)delegateWithSession:(NSURLSession *)session {
+    UAInAppMessageAssetPrefetcher *prefetcher = [UAInAppMessageAssetPrefetcher prefetcherWithStoreURL:self.assetStoreURL
+                                                                                              session:session
+                                                                                           byteBudget:1024 * 1024
+                                                                               maxConcurrentDownloads:1];
+    return [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithPrefetcher:prefetcher];
+}
+
+- (NSURL *)temporaryDownloadURL {
+    NSURL *downloadURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    NSError *error;
+    [[NSFileManager defaultManager] copyItemAtURL:self.mediaURL toURL:downloadURL error:&error];
+    XCTAssertNil(error);
+    return downloadURL;
+}
+
 - (UAInAppMessage *)sampleMessageWithMediaURL:(NSURL *)mediaURL {
     UAInAppMessage *message = [UAInAppMessage messageWithBuilderBlock:^(UAInAppMessageBuilder * _Nonnull builder) {
         builder.identifier = @"test identifier";
@@ -7,7 +7,7 @@
 #import "UARemoteDataPayload+Internal.h"
 #import "UAUtils+Internal.h"
 #import "UAPreferenceDataStore+Internal.h"
-#import "UAInAppMessageManager.h"
+#import "UAInAppMessageManager+Internal.h"
 #import "UAPush+Internal.h"
 #import "UASchedule+Internal.h"
 #import "UAScheduleEdits+Internal.h"
@@ -60,7 +60,23 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
         void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
         completionHandler(self.allSchedules);
     }] getAllSchedules:OCMOCK_ANY];
-    
+
+    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        void (^completionHandler)(NSArray<UAScheduleIndexEntry *> *) = (__bridge void (^)(NSArray<UAScheduleIndexEntry *> *))arg;
+
+        NSMutableArray *entries = [NSMutableArray array];
+        for (UASchedule *schedule in self.allSchedules) {
+            NSDictionary *json = [NSJSONSerialization objectWithString:schedule.info.data];
+            [entries addObject:[UAScheduleIndexEntry entryWithScheduleID:schedule.identifier
+                                                               messageID:json[@"message_id"]
+                                                           messageSource:json[@"source"]
+                                                             lastUpdated:nil]];
+        }
+        completionHandler(entries);
+    }] getMessageScheduleIndex:OCMOCK_ANY];
+
     self.remoteDataClient = [UAInAppRemoteDataClient clientWithScheduler:self.mockScheduler
                                                       remoteDataProvider:self.mockRemoteDataProvider
                                                                dataStore:self.dataStore
@@ -101,32 +117,22 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                             ]
                                     };
     NSArray *inAppMessages = @[simpleMessage];
-    NSUInteger expectedNumberOfScheduleInfos = inAppMessages.count;
     UARemoteDataPayload *inAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
                                                                                   timestamp:[NSDate date]
                                                                                        data:@{@"in_app_messages":inAppMessages}
                                                                                    metadata:metadataA];
 
     // expectations
-    __block NSUInteger callsToScheduleMessages = 0;
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        callsToScheduleMessages++;
-
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-
-        XCTAssertEqual(scheduleInfos.count, expectedNumberOfScheduleInfos);
-
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:metadataA]];
-        }
-
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:metadataA completionHandler:OCMOCK_ANY];
+    __block NSUInteger callsToEditSchedules = 0;
+    __block NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *lastEdits;
+    __block NSArray<UAInAppMessageScheduleInfo *> *lastScheduleInfos;
+    __block NSDictionary *lastMetadata;
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        lastEdits = edits;
+        lastScheduleInfos = scheduleInfos;
+        lastMetadata = metadata;
+    }];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -134,26 +140,10 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages, 1);
-
-    XCTestExpectation *editCalled = [self expectationWithDescription:@"Edit call should be made for metadata change"];
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        void *arg;
-
-        [invocation getArgument:&arg atIndex:3];
-        UAInAppMessageScheduleEdits *edits = (__bridge UAInAppMessageScheduleEdits *)arg;
-
-        XCTAssertEqualObjects(edits.metadata, [NSJSONSerialization stringWithObject:metadataB]);
-
-        [editCalled fulfill];
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler(self.allSchedules[0]);
-    }] editScheduleWithID:[OCMArg checkWithBlock:^BOOL(id obj) {
-        NSString *scheduleID = obj;
-        return [scheduleID isEqualToString:self.allSchedules[0].identifier];
-    }] edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    XCTAssertEqual(callsToEditSchedules, 1);
+    XCTAssertEqual(lastEdits.count, 0);
+    XCTAssertEqual(lastScheduleInfos.count, inAppMessages.count);
+    XCTAssertEqualObjects(lastMetadata, metadataA);
 
     // setup to same message with metadata B
     inAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
@@ -162,21 +152,25 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                               metadata:metadataB];
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
+    [self.remoteDataClient.operationQueue waitUntilAllOperationsAreFinished];
 
-    [self waitForTestExpectations];
-
-    // verify
+    // verify the metadata change is a single edit of the existing schedule
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,1);
+    XCTAssertEqual(callsToEditSchedules, 2);
+    XCTAssertEqual(lastScheduleInfos.count, 0);
+    XCTAssertEqualObjects(lastMetadata, metadataB);
+    XCTAssertEqualObjects(@[self.allSchedules[0].identifier], lastEdits.allKeys);
+    XCTAssertEqualObjects(lastEdits[self.allSchedules[0].identifier].metadata, [NSJSONSerialization stringWithObject:metadataB]);
 }
 
 
 - (void)testMissingInAppMessageRemoteData {
     // expectations
-    __block NSUInteger callsToScheduleMessages = 0;
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        XCTFail(@"No messages should be scheduled");
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    __block NSUInteger callsToEditSchedules = 0;
+    [self stubEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        XCTFail(@"No messages should be scheduled or edited");
+    }];
     [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
         XCTFail(@"No messages should be cancelled");
     }] cancelMessagesWithID:OCMOCK_ANY];
@@ -186,7 +180,7 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,0);
+    XCTAssertEqual(callsToEditSchedules, 0);
 }
 
 - (void)testEmptyInAppMessageList {
@@ -198,10 +192,11 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                        metadata:@{@"cool" : @"story"}];
     
     // expectations
-    __block NSUInteger callsToScheduleMessages = 0;
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        XCTFail(@"No messages should be scheduled");
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    __block NSUInteger callsToEditSchedules = 0;
+    [self stubEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        XCTFail(@"No messages should be scheduled or edited");
+    }];
     [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
         XCTFail(@"No messages should be cancelled");
     }] cancelMessagesWithID:OCMOCK_ANY];
@@ -211,7 +206,7 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,0);
+    XCTAssertEqual(callsToEditSchedules, 0);
 }
 
 - (void)testNonEmptyInAppMessageList {
@@ -245,24 +240,13 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                    metadata:@{@"cool" : @"story"}];
     
     // expectations
-    __block NSUInteger callsToScheduleMessages = 0;
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        callsToScheduleMessages++;
-        
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-        
+    __block NSUInteger callsToEditSchedules = 0;
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        XCTAssertEqual(edits.count, 0);
         XCTAssertEqual(scheduleInfos.count, expectedNumberOfScheduleInfos);
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:@{}]];
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        XCTAssertEqualObjects(metadata, @{@"cool" : @"story"});
+    }];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -270,7 +254,7 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,1);
+    XCTAssertEqual(callsToEditSchedules, 1);
 }
 
 - (void)testSamePayloadSentTwice {
@@ -304,24 +288,13 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                    metadata:@{@"cool" : @"story"}];
     
     // expectations
-    __block NSUInteger callsToScheduleMessages = 0;
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        callsToScheduleMessages++;
-        
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-        
+    __block NSUInteger callsToEditSchedules = 0;
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        XCTAssertEqual(edits.count, 0);
         XCTAssertEqual(scheduleInfos.count, expectedNumberOfScheduleInfos);
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-        
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:@{}]];
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        XCTAssertEqualObjects(metadata, @{@"cool" : @"story"});
+    }];
     
     [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
         XCTFail(@"No messages should be cancelled");
@@ -333,14 +306,14 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,1);
+    XCTAssertEqual(callsToEditSchedules, 1);
         
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,1);
+    XCTAssertEqual(callsToEditSchedules, 1);
 }
 
 - (void)testSameMessageSentTwice {
@@ -374,24 +347,13 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                    metadata:@{@"cool" : @"story"}];
     
     // expectations
-    __block NSUInteger callsToScheduleMessages = 0;
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        callsToScheduleMessages++;
-        
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-        
+    __block NSUInteger callsToEditSchedules = 0;
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        XCTAssertEqual(edits.count, 0);
         XCTAssertEqual(scheduleInfos.count, expectedNumberOfScheduleInfos);
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-        
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:@{}]];
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        XCTAssertEqualObjects(metadata, @{@"cool" : @"story"});
+    }];
 
     
     // test
@@ -400,7 +362,7 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,1);
+    XCTAssertEqual(callsToEditSchedules, 1);
     
     // setup to send same message again
     inAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
@@ -414,7 +376,7 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 
    // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(callsToScheduleMessages,1);
+    XCTAssertEqual(callsToEditSchedules, 1);
 }
 
 - (void)testOneDeletedInAppMessage {
@@ -467,45 +429,14 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                           timestamp:[NSDate date]
                                                                                                data:@{@"in_app_messages":inAppMessages}
                                                                                            metadata:@{@"cool" : @"story"}];
-    __block NSUInteger scheduledMessages = 0;
-    __block NSUInteger cancelledMessages = 0;
-    __block NSUInteger editedMessages = 0;
-
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-
-        scheduledMessages += scheduleInfos.count;
-
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-        
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            UASchedule *schedule = [UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:@{}];
-            [self.allSchedules addObject:schedule];
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        
-        [invocation getArgument:&arg atIndex:2];
-        NSString *scheduleID = (__bridge NSString *)arg;
-        
-        [invocation getArgument:&arg atIndex:3];
-        UAInAppMessageScheduleEdits *edits = (__bridge UAInAppMessageScheduleEdits *)arg;
-        if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
-            cancelledMessages += 1;
-        } else {
-            editedMessages += 1;
-        }
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler([self getScheduleForScheduleId:scheduleID]);
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    __block NSUInteger callsToEditSchedules = 0;
+    __block NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *lastEdits;
+    __block NSArray<UAInAppMessageScheduleInfo *> *lastScheduleInfos;
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        lastEdits = edits;
+        lastScheduleInfos = scheduleInfos;
+    }];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -513,15 +444,11 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 2);
-    XCTAssertEqual(cancelledMessages, 0);
-    XCTAssertEqual(editedMessages, 0);
+    XCTAssertEqual(callsToEditSchedules, 1);
+    XCTAssertEqual(lastScheduleInfos.count, 2);
+    XCTAssertEqual(lastEdits.count, 0);
 
     // setup to delete one message
-    scheduledMessages = 0;
-    cancelledMessages = 0;
-    editedMessages = 0;
-
     inAppMessages = @[message2];
 
     inAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
@@ -533,11 +460,14 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self.remoteDataClient.operationQueue waitUntilAllOperationsAreFinished];
 
-    // verify
+    // verify message 1 is ended in a single bulk edit
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 0);
-    XCTAssertEqual(cancelledMessages, 1);
-    XCTAssertEqual(editedMessages, 0);
+    XCTAssertEqual(callsToEditSchedules, 2);
+    XCTAssertEqual(lastScheduleInfos.count, 0);
+
+    NSString *scheduleID = [self getScheduleForMessageId:message1ID].identifier;
+    XCTAssertEqualObjects(@[scheduleID], lastEdits.allKeys);
+    XCTAssertEqualObjects(lastEdits[scheduleID].end, inAppRemoteDataPayload.timestamp);
 }
 
 - (void)testOneChangedInAppMessage {
@@ -590,51 +520,14 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                        data:@{@"in_app_messages":inAppMessages}
                                                                                    metadata:@{@"cool" : @"story"}];
 
-    __block NSUInteger scheduledMessages = 0;
-    __block NSUInteger cancelledMessages = 0;
-    __block NSUInteger editedMessages = 0;
-    __block UASchedule *schedule1;
-    __block UASchedule *schedule2;
-
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-        
-        scheduledMessages += scheduleInfos.count;
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-        
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            UASchedule *schedule = [UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:@{}];
-            [self.allSchedules addObject:schedule];
-            if ([info.message.identifier isEqualToString:message1ID]) {
-                if ([info.message.identifier isEqualToString:message1ID]) {
-                    schedule1 = schedule;
-                } else if ([info.message.identifier isEqualToString:message2ID]) {
-                    schedule2 = schedule;
-                }
-            }
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        
-        [invocation getArgument:&arg atIndex:3];
-        UAInAppMessageScheduleEdits *edits = (__bridge UAInAppMessageScheduleEdits *)arg;
-        if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
-            cancelledMessages += 1;
-        } else if (edits.priority) {
-            editedMessages += 1;
-        }
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler(nil); // REVISIT - return schedule
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    __block NSUInteger callsToEditSchedules = 0;
+    __block NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *lastEdits;
+    __block NSArray<UAInAppMessageScheduleInfo *> *lastScheduleInfos;
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        lastEdits = edits;
+        lastScheduleInfos = scheduleInfos;
+    }];
     
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -642,15 +535,11 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 2);
-    XCTAssertEqual(cancelledMessages, 0);
-    XCTAssertEqual(editedMessages, 0);
+    XCTAssertEqual(callsToEditSchedules, 1);
+    XCTAssertEqual(lastScheduleInfos.count, 2);
+    XCTAssertEqual(lastEdits.count, 0);
     
     // setup to change one message
-    scheduledMessages = 0;
-    cancelledMessages = 0;
-    editedMessages = 0;
-    
     NSMutableDictionary *changedMessage2 = [NSMutableDictionary dictionaryWithDictionary:message2];
     changedMessage2[@"priority"] = @1;
     NSDateFormatter *formatter = [UAUtils ISODateFormatterUTCWithDelimiter];
@@ -667,11 +556,15 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self.remoteDataClient.operationQueue waitUntilAllOperationsAreFinished];
     
-    // verify
+    // verify only message 2 is edited
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 0);
-    XCTAssertEqual(cancelledMessages, 0);
-    XCTAssertEqual(editedMessages, 1);
+    XCTAssertEqual(callsToEditSchedules, 2);
+    XCTAssertEqual(lastScheduleInfos.count, 0);
+
+    NSString *scheduleID = [self getScheduleForMessageId:message2ID].identifier;
+    XCTAssertEqualObjects(@[scheduleID], lastEdits.allKeys);
+    XCTAssertEqualObjects(lastEdits[scheduleID].priority, @1);
+    XCTAssertEqualObjects(lastEdits[scheduleID].end, [NSDate distantFuture]);
 }
 
 - (void)testEmptyInAppMessageListAfterNonEmptyList {
@@ -724,33 +617,16 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                        data:@{@"in_app_messages":inAppMessages}
                                                                                    metadata:@{@"cool" : @"story"}];
     
-    __block NSUInteger scheduledMessages = 0;
-    __block NSUInteger cancelledMessages = 0;
+    __block NSUInteger callsToEditSchedules = 0;
+    __block NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *lastEdits;
+    __block NSArray<UAInAppMessageScheduleInfo *> *lastScheduleInfos;
 
     // expectations
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-
-        scheduledMessages += scheduleInfos.count;
-
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:info.message.identifier info:info metadata:@{}]];
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        cancelledMessages += 1;
-        void *arg;
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler(nil);
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        lastEdits = edits;
+        lastScheduleInfos = scheduleInfos;
+    }];
     
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -758,8 +634,9 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 2);
-    XCTAssertEqual(cancelledMessages, 0);
+    XCTAssertEqual(callsToEditSchedules, 1);
+    XCTAssertEqual(lastScheduleInfos.count, 2);
+    XCTAssertEqual(lastEdits.count, 0);
     
     // setup empty payload
     UARemoteDataPayload *emptyInAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
@@ -771,9 +648,16 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     self.publishBlock(@[emptyInAppRemoteDataPayload]);
     [self.remoteDataClient.operationQueue waitUntilAllOperationsAreFinished];
 
-    // verify
+    // verify both messages are ended in a single bulk edit
     [self.mockScheduler verify];
-    XCTAssertEqual(cancelledMessages, 2);
+    XCTAssertEqual(callsToEditSchedules, 2);
+    XCTAssertEqual(lastScheduleInfos.count, 0);
+
+    NSSet *scheduleIDs = [NSSet setWithObjects:[self getScheduleForMessageId:message1ID].identifier, [self getScheduleForMessageId:message2ID].identifier, nil];
+    XCTAssertEqualObjects(scheduleIDs, [NSSet setWithArray:lastEdits.allKeys]);
+    for (NSString *scheduleID in lastEdits) {
+        XCTAssertEqualObjects(lastEdits[scheduleID].end, emptyInAppRemoteDataPayload.timestamp);
+    }
 }
 
 - (void)testNewUserCutoffTime {
@@ -869,53 +753,16 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                                        data:@{@"in_app_messages":inAppMessages}
                                                                                    metadata:@{@"cool" : @"story"}];
     
-    __block NSUInteger scheduledMessages = 0;
-    __block NSUInteger cancelledMessages = 0;
-    __block NSUInteger editedMessages = 0;
+    __block NSUInteger callsToEditSchedules = 0;
+    __block NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *lastEdits;
+    __block NSArray<UAInAppMessageScheduleInfo *> *lastScheduleInfos;
     
     // expectations
-    [[[self.mockScheduler expect] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        [invocation getArgument:&arg atIndex:2];
-        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray<UAInAppMessageScheduleInfo *> *)arg;
-        
-        scheduledMessages += scheduleInfos.count;
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
-        
-        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
-            UASchedule *schedule = [UASchedule scheduleWithIdentifier:[NSUUID UUID].UUIDString info:info metadata:@{}];
-            [self.allSchedules addObject:schedule];
-        }
-        completionHandler(self.allSchedules);
-    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-    
-    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-        
-        [invocation getArgument:&arg atIndex:2];
-        NSString *scheduleID = (__bridge NSString *)arg;
-        
-        [invocation getArgument:&arg atIndex:3];
-        UAInAppMessageScheduleEdits *edits = (__bridge UAInAppMessageScheduleEdits *)arg;
-        if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
-            cancelledMessages += 1;
-        } else {
-            editedMessages += 1;
-        }
-        
-        [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        for (UASchedule *schedule in self.allSchedules) {
-            if ([scheduleID isEqualToString:schedule.identifier]) {
-                completionHandler(schedule);
-                return;
-            }
-        }
-        XCTFail(@"Unknown scheduleID");
-        completionHandler(nil);
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [self expectEditSchedules:^(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata) {
+        callsToEditSchedules++;
+        lastEdits = edits;
+        lastScheduleInfos = scheduleInfos;
+    }];
 
     // test - receive in-app messages
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -923,9 +770,9 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 2);
-    XCTAssertEqual(cancelledMessages, 0);
-    XCTAssertEqual(editedMessages, 0);
+    XCTAssertEqual(callsToEditSchedules, 1);
+    XCTAssertEqual(lastScheduleInfos.count, 2);
+    XCTAssertEqual(lastEdits.count, 0);
 
     // Make cache and schedule automation store out of sync by setting up a cache with only one of the IAM
     XCTAssertNil([self.dataStore dictionaryForKey:UAInAppMessagesScheduledMessagesKey]);
@@ -942,31 +789,61 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
                                                                   data:@{@"in_app_messages":inAppMessages}
                                                               metadata:@{@"cool" : @"story"}];
     
-    scheduledMessages = 0;
-    cancelledMessages = 0;
-    editedMessages = 0;
-    
     // test - customer cancels message 1
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self.remoteDataClient.operationQueue waitUntilAllOperationsAreFinished];
     
     // verify
     [self.mockScheduler verify];
-    XCTAssertEqual(scheduledMessages, 0);
-    XCTAssertEqual(cancelledMessages, 1);
-    XCTAssertEqual(editedMessages, 0);
+    XCTAssertEqual(callsToEditSchedules, 2);
+    XCTAssertEqual(lastScheduleInfos.count, 0);
+
+    NSString *scheduleID = [self getScheduleForMessageId:message1ID].identifier;
+    XCTAssertEqualObjects(@[scheduleID], lastEdits.allKeys);
+    XCTAssertEqualObjects(lastEdits[scheduleID].end, inAppRemoteDataPayload.timestamp);
     
     // cache should have been removed, as it is no longer used
     XCTAssertNil([self.dataStore dictionaryForKey:UAInAppMessagesScheduledMessagesKey]);
 }
 
-- (UASchedule *)getScheduleForScheduleId:(NSString *)scheduleId {
-    for (UASchedule *schedule in self.allSchedules) {
-        if ([scheduleId isEqualToString:schedule.identifier]) {
-            return schedule;
+/**
+ * Expects bulk edit calls. Each call is passed to the block, new schedules are added to allSchedules
+ * and the completion handler is called.
+ */
+- (void)expectEditSchedules:(void (^)(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata))block {
+    [[[self.mockScheduler expect] andDo:[self editSchedulesInvocationBlock:block]] editSchedules:OCMOCK_ANY newSchedules:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+}
+
+/**
+ * Stubs bulk edit calls without requiring one.
+ */
+- (void)stubEditSchedules:(void (^)(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata))block {
+    [[[self.mockScheduler stub] andDo:[self editSchedulesInvocationBlock:block]] editSchedules:OCMOCK_ANY newSchedules:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+}
+
+- (void (^)(NSInvocation *))editSchedulesInvocationBlock:(void (^)(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits, NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos, NSDictionary *metadata))block {
+    return ^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits = (__bridge NSDictionary *)arg;
+
+        [invocation getArgument:&arg atIndex:3];
+        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray *)arg;
+
+        [invocation getArgument:&arg atIndex:4];
+        NSDictionary *metadata = (__bridge NSDictionary *)arg;
+
+        [invocation getArgument:&arg atIndex:5];
+        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+
+        block(edits, scheduleInfos, metadata);
+
+        for (UAInAppMessageScheduleInfo *info in scheduleInfos) {
+            [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:[NSUUID UUID].UUIDString info:info metadata:metadata]];
         }
-    }
-    return nil;
+
+        completionHandler(self.allSchedules);
+    };
 }
 
 - (UASchedule *)getScheduleForMessageId:(NSString *)messageId {
@@ -220,6 +220,121 @@
     XCTAssertEqual(0, self.messageList.messages.count);
 }
 
+/**
+ * Test a successful retrieve only applies the messages the sync changed, and posts the change set.
+ */
+- (void)testRetrieveAppliesChanges {
+    [self syncStoreWithMessages:@[[self createMessageDictionaryWithMessageID:@"first"],
+                                  [self createMessageDictionaryWithMessageID:@"second"]]];
+    [self loadSavedMessages];
+    XCTAssertEqual(2, self.messageList.messages.count);
+
+    NSMutableDictionary *updated = [[self createMessageDictionaryWithMessageID:@"first"] mutableCopy];
+    updated[@"title"] = @"updated title";
+    NSArray *response = @[updated, [self createMessageDictionaryWithMessageID:@"third"]];
+
+    [[[self.mockInboxAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        UAInboxClientMessageRetrievalSuccessBlock successBlock = (__bridge UAInboxClientMessageRetrievalSuccessBlock) arg;
+        successBlock(200, response);
+    }] retrieveMessageListOnSuccess:[OCMArg any] onFailure:[OCMArg any]];
+
+    __block NSDictionary *changes;
+    [self expectationForNotification:UAInboxMessageListUpdatedNotification object:nil notificationCenter:self.notificationCenter handler:^BOOL(NSNotification *notification) {
+        changes = notification.userInfo;
+        return YES;
+    }];
+
+    [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:nil];
+    [self waitForTestExpectations];
+
+    XCTAssertEqualObjects([NSSet setWithObject:@"third"], changes[UAInboxMessageListInsertedMessageIDsKey]);
+    XCTAssertEqualObjects([NSSet setWithObject:@"first"], changes[UAInboxMessageListUpdatedMessageIDsKey]);
+    XCTAssertEqualObjects([NSSet setWithObject:@"second"], changes[UAInboxMessageListDeletedMessageIDsKey]);
+
+    XCTAssertEqual(2, self.messageList.messages.count);
+    XCTAssertEqualObjects(([NSSet setWithArray:@[@"first", @"third"]]), [NSSet setWithArray:[self.messageList.messages valueForKey:@"messageID"]]);
+    XCTAssertEqualObjects(@"updated title", [self.messageList messageForID:@"first"].title);
+    XCTAssertNil([self.messageList messageForID:@"second"]);
+}
+
+/**
+ * Test marking a message read only refreshes that message.
+ */
+- (void)testMarkMessagesReadAppliesChanges {
+    NSMutableDictionary *first = [[self createMessageDictionaryWithMessageID:@"first"] mutableCopy];
+    first[@"unread"] = @"1";
+    NSMutableDictionary *second = [[self createMessageDictionaryWithMessageID:@"second"] mutableCopy];
+    second[@"unread"] = @"1";
+
+    [self syncStoreWithMessages:@[first, second]];
+    [self loadSavedMessages];
+    XCTAssertEqual(2, self.messageList.unreadCount);
+
+    UAInboxMessage *unchanged = [self.messageList messageForID:@"second"];
+
+    __block NSDictionary *changes;
+    [self expectationForNotification:UAInboxMessageListUpdatedNotification object:nil notificationCenter:self.notificationCenter handler:^BOOL(NSNotification *notification) {
+        changes = notification.userInfo;
+        return YES;
+    }];
+
+    [self.messageList markMessagesRead:@[[self.messageList messageForID:@"first"]] completionHandler:nil];
+    [self waitForTestExpectations];
+
+    XCTAssertEqualObjects([NSSet set], changes[UAInboxMessageListInsertedMessageIDsKey]);
+    XCTAssertEqualObjects([NSSet setWithObject:@"first"], changes[UAInboxMessageListUpdatedMessageIDsKey]);
+    XCTAssertEqualObjects([NSSet set], changes[UAInboxMessageListDeletedMessageIDsKey]);
+
+    XCTAssertEqual(2, self.messageList.messages.count);
+    XCTAssertEqual(1, self.messageList.unreadCount);
+    XCTAssertFalse([self.messageList messageForID:@"first"].unread);
+
+    // Other messages are left alone
+    XCTAssertEqual(unchanged, [self.messageList messageForID:@"second"]);
+}
+
+/**
+ * Test deleting a message removes it from the list and its maps.
+ */
+- (void)testMarkMessagesDeletedAppliesChanges {
+    [self syncStoreWithMessages:@[[self createMessageDictionaryWithMessageID:@"first"],
+                                  [self createMessageDictionaryWithMessageID:@"second"]]];
+    [self loadSavedMessages];
+
+    __block NSDictionary *changes;
+    [self expectationForNotification:UAInboxMessageListUpdatedNotification object:nil notificationCenter:self.notificationCenter handler:^BOOL(NSNotification *notification) {
+        changes = notification.userInfo;
+        return YES;
+    }];
+
+    [self.messageList markMessagesDeleted:@[[self.messageList messageForID:@"first"]] completionHandler:nil];
+    [self waitForTestExpectations];
+
+    XCTAssertEqualObjects([NSSet setWithObject:@"first"], changes[UAInboxMessageListDeletedMessageIDsKey]);
+    XCTAssertEqual(1, self.messageList.messages.count);
+    XCTAssertEqualObjects(@"second", self.messageList.messages[0].messageID);
+    XCTAssertNil([self.messageList messageForID:@"first"]);
+}
+
+- (void)syncStoreWithMessages:(NSArray *)messages {
+    XCTestExpectation *inboxSynced = [self expectationWithDescription:@"inboxSynced"];
+    [self.testStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        [inboxSynced fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)loadSavedMessages {
+    [self expectationForNotification:UAInboxMessageListUpdatedNotification object:nil notificationCenter:self.notificationCenter handler:^BOOL(NSNotification *notification) {
+        XCTAssertNil(notification.userInfo);
+        return YES;
+    }];
+    [self.messageList loadSavedMessages];
+    [self waitForTestExpectations];
+}
+
 /**
  * Helper method for substituting UAAutoDisposable for UADisposable in test.
  */
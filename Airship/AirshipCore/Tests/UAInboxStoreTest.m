@@ -4,6 +4,12 @@
 #import "UAInboxStore+Internal.h"
 #import "UARuntimeConfig.h"
 
+@interface UAInboxStore()
+@property (strong, nonatomic) NSManagedObjectContext *managedContext;
+- (void)updateMessageData:(UAInboxMessageData *)data withDictionary:(NSDictionary *)dict;
++ (NSDictionary *)dictionaryWithoutNullValues:(NSDictionary *)dict;
+@end
+
 @interface UAInboxStoreTest : UABaseTest
 @property UAInboxStore *inboxStore;
 @end
@@ -21,6 +27,20 @@
 
     [super tearDown];
 }
+
+- (void)testStoreOpensOnFirstUse {
+    XCTAssertEqual(0, self.inboxStore.managedContext.persistentStoreCoordinator.persistentStores.count);
+
+    XCTestExpectation *testExpectation = [self expectationWithDescription:@"test finished"];
+    [self.inboxStore fetchMessagesWithPredicate:nil completionHandler:^(NSArray<UAInboxMessageData *> *messages) {
+        XCTAssertEqual(0, messages.count);
+        [testExpectation fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, self.inboxStore.managedContext.persistentStoreCoordinator.persistentStores.count);
+}
+
 - (void)testDefaultValues {
 
     XCTestExpectation *testExpectation = [self expectationWithDescription:@"test finished"];
@@ -90,6 +110,185 @@
 
 }
 
+- (void)testSyncSkipsUnchangedMessages {
+    NSArray *messages = @[ [self createMessageDictionaryWithMessageID:@"message-0"],
+                           [self createMessageDictionaryWithMessageID:@"message-1"],
+                           [self createMessageDictionaryWithMessageID:@"message-2"]];
+
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+    [self.inboxStore waitForIdle];
+
+    __block NSSet *updatedObjects;
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                    object:self.inboxStore.managedContext
+                                                                     queue:nil
+                                                                usingBlock:^(NSNotification *notification) {
+        updatedObjects = notification.userInfo[NSUpdatedObjectsKey];
+    }];
+
+    // Modify one of the messages
+    NSMutableDictionary *message = [messages[1] mutableCopy];
+    message[@"last_modified"] = @"2013-08-14 00:16:22";
+
+    [self.inboxStore syncMessagesWithResponse:@[messages[0], message, messages[2]]
+                            completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+    [self.inboxStore waitForIdle];
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+
+    // Verify only the modified message was written
+    XCTAssertEqual(1, updatedObjects.count);
+    XCTAssertEqualObjects(@"message-1", ((UAInboxMessageData *)updatedObjects.anyObject).messageID);
+}
+
+- (void)testSyncDuplicateMessages {
+    NSMutableDictionary *message = [[self createMessageDictionaryWithMessageID:@"message-0"] mutableCopy];
+    message[@"title"] = @"differentTitle";
+
+    [self.inboxStore syncMessagesWithResponse:@[[self createMessageDictionaryWithMessageID:@"message-0"], message]
+                            completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+
+    // Verify the last payload wins and only a single message is stored
+    XCTestExpectation *fetch = [self expectationWithDescription:@"fetched messages"];
+    [self.inboxStore fetchMessagesWithPredicate:nil completionHandler:^(NSArray<UAInboxMessageData *> *messages) {
+        XCTAssertEqual(1, messages.count);
+        XCTAssertEqualObjects(@"differentTitle", messages[0].title);
+        [fetch fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testSyncRemovesInvalidStoredRows {
+    [self.inboxStore syncMessagesWithResponse:@[[self createMessageDictionaryWithMessageID:@"message-0"]]
+                            completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+    [self.inboxStore waitForIdle];
+
+    // Insert a duplicate of the stored message and a row without a message ID
+    NSManagedObjectContext *context = self.inboxStore.managedContext;
+    [context performBlockAndWait:^{
+        UAInboxMessageData *duplicate = [NSEntityDescription insertNewObjectForEntityForName:@"UAInboxMessage" inManagedObjectContext:context];
+        [self.inboxStore updateMessageData:duplicate withDictionary:[self createMessageDictionaryWithMessageID:@"message-0"]];
+
+        [NSEntityDescription insertNewObjectForEntityForName:@"UAInboxMessage" inManagedObjectContext:context];
+        XCTAssertTrue([context save:nil]);
+    }];
+
+    [self.inboxStore syncMessagesWithResponse:@[[self createMessageDictionaryWithMessageID:@"message-0"]]
+                            completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+
+    // Verify only a single row remains
+    XCTestExpectation *fetch = [self expectationWithDescription:@"fetched messages"];
+    [self.inboxStore fetchMessagesWithPredicate:nil completionHandler:^(NSArray<UAInboxMessageData *> *messages) {
+        XCTAssertEqual(1, messages.count);
+        XCTAssertEqualObjects(@"message-0", messages[0].messageID);
+        [fetch fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testSync100MessagesPerformance {
+    [self measureSyncWithMessageCount:100 batched:YES];
+}
+
+- (void)testSync1000MessagesPerformance {
+    [self measureSyncWithMessageCount:1000 batched:YES];
+}
+
+- (void)testSync5000MessagesPerformance {
+    [self measureSyncWithMessageCount:5000 batched:YES];
+}
+
+- (void)testPerMessageSync100MessagesPerformance {
+    [self measureSyncWithMessageCount:100 batched:NO];
+}
+
+- (void)testPerMessageSync1000MessagesPerformance {
+    [self measureSyncWithMessageCount:1000 batched:NO];
+}
+
+- (void)testPerMessageSync5000MessagesPerformance {
+    [self measureSyncWithMessageCount:5000 batched:NO];
+}
+
+/**
+ * Measures a refresh of a full inbox where a tenth of the messages changed since the last sync.
+ */
+- (void)measureSyncWithMessageCount:(NSUInteger)count batched:(BOOL)batched {
+    NSMutableArray *messages = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [messages addObject:[self createMessageDictionaryWithMessageID:[NSString stringWithFormat:@"message-%lu", (unsigned long)i]]];
+    }
+
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {}];
+    [self.inboxStore waitForIdle];
+
+    __block NSUInteger iteration = 0;
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        iteration++;
+        NSMutableArray *response = [messages mutableCopy];
+        for (NSUInteger i = 0; i < count; i += 10) {
+            NSMutableDictionary *message = [response[i] mutableCopy];
+            message[@"title"] = [NSString stringWithFormat:@"title-%lu", (unsigned long)iteration];
+            response[i] = message;
+        }
+
+        [self startMeasuring];
+        if (batched) {
+            [self.inboxStore syncMessagesWithResponse:response completionHandler:^(BOOL success) {}];
+        } else {
+            [self syncMessagesPerMessage:response];
+        }
+        [self.inboxStore waitForIdle];
+        [self stopMeasuring];
+    }];
+}
+
+/**
+ * The previous sync path, fetching each message individually. Used as a benchmark baseline.
+ */
+- (void)syncMessagesPerMessage:(NSArray *)messages {
+    NSManagedObjectContext *context = self.inboxStore.managedContext;
+    [context performBlock:^{
+        NSMutableSet *newMessageIDs = [NSMutableSet set];
+
+        for (NSDictionary *messagePayload in messages) {
+            NSString *messageID = messagePayload[@"message_id"];
+
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAInboxMessage"];
+            request.predicate = [NSPredicate predicateWithFormat:@"messageID == %@", messageID];
+            request.fetchLimit = 1;
+
+            UAInboxMessageData *data = [[context executeFetchRequest:request error:nil] lastObject];
+            if (!data) {
+                data = [NSEntityDescription insertNewObjectForEntityForName:@"UAInboxMessage" inManagedObjectContext:context];
+            }
+
+            [self.inboxStore updateMessageData:data withDictionary:[UAInboxStore dictionaryWithoutNullValues:messagePayload]];
+            [newMessageIDs addObject:messageID];
+        }
+
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAInboxMessage"];
+        request.predicate = [NSPredicate predicateWithFormat:@"NOT (messageID IN %@)", newMessageIDs];
+        request.includesPropertyValues = NO;
+        for (NSManagedObject *data in [context executeFetchRequest:request error:nil]) {
+            [context deleteObject:data];
+        }
+
+        [context save:nil];
+    }];
+}
+
 - (NSDictionary *)createMessageDictionaryWithMessageID:(NSString *)messageID {
     return @{@"message_id": messageID,
              @"title": @"someTitle",
@@ -0,0 +1,136 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAJSONWriter+Internal.h"
+#import "NSJSONSerialization+UAAdditions.h"
+
+@interface UAJSONWriterTest : UABaseTest
+@property (nonatomic, strong) UAJSONWriter *writer;
+@end
+
+@implementation UAJSONWriterTest
+
+- (void)setUp {
+    [super setUp];
+    self.writer = [UAJSONWriter writer];
+}
+
+- (void)testWriteValue {
+    NSDictionary *value = @{ @"string": @"some \"quoted\" \\ text\n\twith ✓ and \U0001F600",
+                             @"control": @"\b\f\r\u0001",
+                             @"int": @(100),
+                             @"double": @(1.5),
+                             @"bool": @YES,
+                             @"null": [NSNull null],
+                             @"array": @[@"a", @(1), @[], @{}],
+                             @"object": @{ @"nested": @"value" } };
+
+    XCTAssertTrue([self.writer writeValue:value]);
+    XCTAssertEqualObjects(value, [self decode:self.writer.data]);
+}
+
+- (void)testWriteObject {
+    [self.writer beginObject];
+    [self.writer writeKey:@"first"];
+    [self.writer writeString:@"one"];
+    [self.writer writeKey:@"second"];
+    [self.writer beginArray];
+    [self.writer writeNumber:@(2)];
+    [self.writer writeNumber:@NO];
+    [self.writer endArray];
+    [self.writer writeKey:@"third"];
+    [self.writer beginObject];
+    [self.writer endObject];
+    [self.writer endObject];
+
+    NSString *json = [[NSString alloc] initWithData:self.writer.data encoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(@"{\"first\":\"one\",\"second\":[2,false],\"third\":{}}", json);
+}
+
+/**
+ * Test stringified values decode to the same strings NSJSONSerialization produces.
+ */
+- (void)testWriteStringifiedValue {
+    NSArray *values = @[@"plain", @"\"quoted\" \\ and\nnew line", @"✓ \U0001F600", @(123), @(123.456789), @YES, @NO];
+
+    [self.writer beginArray];
+    for (id value in values) {
+        XCTAssertTrue([self.writer writeStringifiedValue:value]);
+    }
+    [self.writer endArray];
+
+    NSArray *decoded = [self decode:self.writer.data];
+    XCTAssertEqual(values.count, decoded.count);
+
+    for (NSUInteger i = 0; i < values.count; i++) {
+        NSString *expected = [NSJSONSerialization stringWithObject:values[i] acceptingFragments:YES error:nil];
+        id expectedValue = [NSJSONSerialization JSONObjectWithData:[expected dataUsingEncoding:NSUTF8StringEncoding] options:NSJSONReadingAllowFragments error:nil];
+        id actualValue = [NSJSONSerialization JSONObjectWithData:[decoded[i] dataUsingEncoding:NSUTF8StringEncoding] options:NSJSONReadingAllowFragments error:nil];
+        XCTAssertEqualObjects(expectedValue, actualValue);
+    }
+}
+
+/**
+ * Test floating point numbers are written with enough digits to read back as the same value.
+ */
+- (void)testWriteFloatingPointNumbers {
+    NSArray<NSNumber *> *values = @[@(0.1 + 0.2), @(0.1), @(1.0 / 3.0), @(123.123456789), @(1e-7), @(DBL_MAX), @(-2.5), @(3.0)];
+
+    [self.writer beginArray];
+    for (NSNumber *value in values) {
+        XCTAssertTrue([self.writer writeNumber:value]);
+    }
+    [self.writer endArray];
+
+    NSArray<NSNumber *> *decoded = [self decode:self.writer.data];
+    for (NSUInteger i = 0; i < values.count; i++) {
+        XCTAssertEqual(values[i].doubleValue, decoded[i].doubleValue);
+    }
+
+    NSString *json = [[NSString alloc] initWithData:self.writer.data encoding:NSUTF8StringEncoding];
+    XCTAssertTrue([json hasPrefix:@"[0.30000000000000004,0.1,"]);
+    XCTAssertTrue([json hasSuffix:@",-2.5,3]"]);
+
+    UAJSONWriter *floatWriter = [UAJSONWriter writer];
+    XCTAssertTrue([floatWriter writeNumber:@(0.1f)]);
+    XCTAssertEqualObjects(@"0.1", [[NSString alloc] initWithData:floatWriter.data encoding:NSUTF8StringEncoding]);
+}
+
+/**
+ * Test a key is discarded along with a value that can not be written.
+ */
+- (void)testWriteKeyDiscardsInvalidValue {
+    [self.writer beginObject];
+    XCTAssertTrue([self.writer writeKey:@"first" value:@(1)]);
+    XCTAssertFalse([self.writer writeKey:@"nan" value:@(NAN)]);
+    XCTAssertFalse([self.writer writeKey:@"infinity" stringifiedValue:@(INFINITY)]);
+    XCTAssertTrue([self.writer writeKey:@"second" stringifiedValue:@"two"]);
+    [self.writer endObject];
+
+    NSString *json = [[NSString alloc] initWithData:self.writer.data encoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(@"{\"first\":1,\"second\":\"\\\"two\\\"\"}", json);
+
+    UAJSONWriter *writer = [UAJSONWriter writer];
+    [writer beginObject];
+    XCTAssertFalse([writer writeKey:@"nan" value:@(NAN)]);
+    XCTAssertTrue([writer writeKey:@"first" value:@(1)]);
+    [writer endObject];
+    XCTAssertEqualObjects(@"{\"first\":1}", [[NSString alloc] initWithData:writer.data encoding:NSUTF8StringEncoding]);
+}
+
+- (void)testInvalidValues {
+    XCTAssertFalse([[UAJSONWriter writer] writeValue:@(INFINITY)]);
+    XCTAssertFalse([[UAJSONWriter writer] writeValue:[NSDecimalNumber notANumber]]);
+    XCTAssertFalse([[UAJSONWriter writer] writeValue:[NSDate date]]);
+    XCTAssertFalse([[UAJSONWriter writer] writeValue:@{ @(1): @"non-string key" }]);
+    XCTAssertFalse([[UAJSONWriter writer] writeStringifiedValue:@[]]);
+}
+
+- (id)decode:(NSData *)data {
+    NSError *error;
+    id result = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
+    XCTAssertNil(error);
+    return result;
+}
+
+@end
@@ -0,0 +1,284 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAMessageCenterListIconLoader+Internal.h"
+
+@interface UAMessageCenterListIconLoaderTest : UABaseTest
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) id mockSession;
+@property (nonatomic, strong) NSMutableArray *dataTasks;
+@property (nonatomic, strong) NSMutableArray<NSURL *> *requestedURLs;
+@property (nonatomic, strong) NSMutableDictionary<NSURL *, NSData *> *responseBodies;
+@property (nonatomic, strong) UAMessageCenterListIconLoader *loader;
+@end
+
+@implementation UAMessageCenterListIconLoaderTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+
+    self.dataTasks = [NSMutableArray array];
+    self.requestedURLs = [NSMutableArray array];
+    self.responseBodies = [NSMutableDictionary dictionary];
+
+    // Serve requests from responseBodies asynchronously, with a 404 for unknown URLs
+    self.mockSession = [self mockForClass:[NSURLSession class]];
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        NSURL *URL = (__bridge NSURL *)arg;
+
+        [invocation getArgument:&arg atIndex:3];
+        void (^completionHandler)(NSData *, NSURLResponse *, NSError *) = (__bridge void (^)(NSData *, NSURLResponse *, NSError *))arg;
+
+        id mockTask = [self mockForClass:[NSURLSessionDataTask class]];
+        [[[mockTask stub] andDo:^(NSInvocation *invocation) {
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                NSData *body = self.responseBodies[URL];
+                NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:URL
+                                                                          statusCode:body ? 200 : 404
+                                                                         HTTPVersion:nil
+                                                                        headerFields:nil];
+                completionHandler(body, response, nil);
+            });
+        }] resume];
+
+        @synchronized (self) {
+            [self.requestedURLs addObject:URL];
+            [self.dataTasks addObject:mockTask];
+        }
+
+        [invocation setReturnValue:&mockTask];
+    }] dataTaskWithURL:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.loader = [self loaderWithByteBudget:1024 * 1024];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+/**
+ * Test icons are downsampled to fill the display size.
+ */
+- (void)testDownsampling {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(100, 40)];
+
+    UIImage *icon = [self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2];
+
+    // Filling 20x20 pixels scales the shortest side to 20 pixels
+    XCTAssertEqual(50, CGImageGetWidth(icon.CGImage));
+    XCTAssertEqual(20, CGImageGetHeight(icon.CGImage));
+    XCTAssertEqual(2, icon.scale);
+    XCTAssertTrue(CGSizeEqualToSize(CGSizeMake(25, 10), icon.size));
+}
+
+/**
+ * Test icons smaller than the display size are not upscaled.
+ */
+- (void)testNoUpscaling {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(8, 8)];
+
+    UIImage *icon = [self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2];
+    XCTAssertEqual(8, CGImageGetWidth(icon.CGImage));
+    XCTAssertEqual(8, CGImageGetHeight(icon.CGImage));
+}
+
+- (void)testSharedLoad {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+
+    [self.loader prefetchIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2];
+
+    XCTestExpectation *firstLoaded = [self expectationWithDescription:@"first loaded"];
+    [self.loader loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2 completionHandler:^(UIImage *icon) {
+        XCTAssertNotNil(icon);
+        [firstLoaded fulfill];
+    }];
+
+    XCTestExpectation *secondLoaded = [self expectationWithDescription:@"second loaded"];
+    [self.loader loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2 completionHandler:^(UIImage *icon) {
+        XCTAssertNotNil(icon);
+        [secondLoaded fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, self.requestedURLs.count);
+}
+
+- (void)testMemoryCache {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+
+    XCTAssertNil([self.loader cachedIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+
+    UIImage *icon = [self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2];
+    XCTAssertEqual(icon, [self.loader cachedIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+
+    // Cached by size
+    XCTAssertNil([self.loader cachedIconWithURL:iconURL size:CGSizeMake(20, 20) scale:2]);
+
+    [self.loader clearMemoryCache];
+    XCTAssertNil([self.loader cachedIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+}
+
+- (void)testDiskCache {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(100, 40)];
+
+    XCTAssertNotNil([self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+    XCTAssertEqual(1, self.requestedURLs.count);
+
+    // The thumbnail persists across instances and memory cache clears
+    self.loader = [self loaderWithByteBudget:1024 * 1024];
+    UIImage *icon = [self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2];
+    XCTAssertEqual(1, self.requestedURLs.count);
+    XCTAssertEqual(50, CGImageGetWidth(icon.CGImage));
+    XCTAssertEqual(20, CGImageGetHeight(icon.CGImage));
+
+    // A different size is loaded again
+    XCTAssertNotNil([self loadIconWithURL:iconURL size:CGSizeMake(20, 20) scale:2]);
+    XCTAssertEqual(2, self.requestedURLs.count);
+}
+
+/**
+ * Test the least recently used thumbnail is removed once the disk cache is over budget.
+ */
+- (void)testDiskCacheByteBudget {
+    NSURL *firstURL = [NSURL URLWithString:@"https://example.com/first.png"];
+    NSURL *secondURL = [NSURL URLWithString:@"https://example.com/second.png"];
+    self.responseBodies[firstURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+    self.responseBodies[secondURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+
+    XCTAssertNotNil([self loadIconWithURL:firstURL size:CGSizeMake(10, 10) scale:2]);
+    NSArray<NSURL *> *files = [self cachedFiles];
+    XCTAssertEqual(1, files.count);
+    NSURL *firstFile = files.firstObject;
+
+    // Both thumbnails are the same size, so a budget of one thumbnail fits only one of them
+    unsigned long long thumbnailSize = [self fileSizeOfURL:firstFile];
+    XCTAssertTrue(thumbnailSize > 0);
+
+    NSDate *past = [NSDate dateWithTimeIntervalSinceNow:-60];
+    [[NSFileManager defaultManager] setAttributes:@{ NSFileModificationDate : past } ofItemAtPath:firstFile.path error:nil];
+
+    self.loader = [self loaderWithByteBudget:thumbnailSize];
+    XCTAssertNotNil([self loadIconWithURL:secondURL size:CGSizeMake(10, 10) scale:2]);
+    XCTAssertEqual(2, self.requestedURLs.count);
+
+    // The older thumbnail is removed and the newer one kept
+    files = [self cachedFiles];
+    XCTAssertEqual(1, files.count);
+    XCTAssertFalse([files containsObject:firstFile]);
+
+    [self.loader clearMemoryCache];
+    XCTAssertNotNil([self loadIconWithURL:secondURL size:CGSizeMake(10, 10) scale:2]);
+    XCTAssertEqual(2, self.requestedURLs.count);
+
+    XCTAssertNotNil([self loadIconWithURL:firstURL size:CGSizeMake(10, 10) scale:2]);
+    XCTAssertEqual(3, self.requestedURLs.count);
+}
+
+/**
+ * Test replacing a stored thumbnail does not count both files toward the disk cache size.
+ */
+- (void)testDiskCacheSizeOnReplace {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+
+    XCTAssertNotNil([self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+    NSURL *file = [self cachedFiles].firstObject;
+    unsigned long long thumbnailSize = [self fileSizeOfURL:file];
+
+    // Corrupt the stored thumbnail so the next load fetches and stores it again
+    [[NSMutableData dataWithLength:(NSUInteger)thumbnailSize] writeToURL:file atomically:YES];
+    [self.loader clearMemoryCache];
+
+    XCTAssertNotNil([self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+    XCTAssertEqual(2, self.requestedURLs.count);
+    XCTAssertEqual(1, [self cachedFiles].count);
+    XCTAssertEqual(thumbnailSize, [[self.loader valueForKey:@"diskCacheSize"] unsignedLongLongValue]);
+}
+
+/**
+ * Test temp files left by an interrupted write are removed at startup.
+ */
+- (void)testStartupRemovesTemporaryFiles {
+    NSURL *temporaryFile = [self.directoryURL URLByAppendingPathComponent:@"stray.tmp"];
+    [[NSMutableData dataWithLength:1024] writeToURL:temporaryFile atomically:YES];
+
+    // Loads run after the startup trim
+    self.loader = [self loaderWithByteBudget:1024 * 1024];
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/icon.png"];
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+    XCTAssertNotNil([self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+
+    NSArray<NSURL *> *files = [self cachedFiles];
+    XCTAssertEqual(1, files.count);
+    XCTAssertNotEqualObjects(@"tmp", files.firstObject.pathExtension);
+    XCTAssertEqual([self fileSizeOfURL:files.firstObject], [[self.loader valueForKey:@"diskCacheSize"] unsignedLongLongValue]);
+}
+
+- (void)testFailedLoad {
+    NSURL *iconURL = [NSURL URLWithString:@"https://example.com/missing.png"];
+
+    XCTestExpectation *loaded = [self expectationWithDescription:@"loaded"];
+    [self.loader loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2 completionHandler:^(UIImage *icon) {
+        XCTAssertNil(icon);
+        [loaded fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // Failures are not cached
+    self.responseBodies[iconURL] = [self PNGWithPixelSize:CGSizeMake(40, 40)];
+    XCTAssertNotNil([self loadIconWithURL:iconURL size:CGSizeMake(10, 10) scale:2]);
+    XCTAssertEqual(2, self.requestedURLs.count);
+}
+
+- (UIImage *)loadIconWithURL:(NSURL *)iconURL size:(CGSize)size scale:(CGFloat)scale {
+    __block UIImage *result;
+    XCTestExpectation *loaded = [self expectationWithDescription:@"loaded"];
+    [self.loader loadIconWithURL:iconURL size:size scale:scale completionHandler:^(UIImage *icon) {
+        XCTAssertTrue([NSThread isMainThread]);
+        result = icon;
+        [loaded fulfill];
+    }];
+    [self waitForTestExpectations];
+    return result;
+}
+
+- (NSArray<NSURL *> *)cachedFiles {
+    NSArray<NSURL *> *files = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                            includingPropertiesForKeys:nil
+                                                                               options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                 error:nil];
+    return [files valueForKeyPath:@"URLByStandardizingPath"];
+}
+
+- (unsigned long long)fileSizeOfURL:(NSURL *)fileURL {
+    return [[[NSFileManager defaultManager] attributesOfItemAtPath:fileURL.path error:nil] fileSize];
+}
+
+- (UAMessageCenterListIconLoader *)loaderWithByteBudget:(unsigned long long)byteBudget {
+    return [UAMessageCenterListIconLoader loaderWithCacheURL:self.directoryURL
+                                                     session:self.mockSession
+                                                  byteBudget:byteBudget];
+}
+
+- (NSData *)PNGWithPixelSize:(CGSize)pixelSize {
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+    format.scale = 1;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:pixelSize format:format];
+    return [renderer PNGDataWithActions:^(UIGraphicsImageRendererContext *context) {
+        [[UIColor redColor] setFill];
+        [context fillRect:CGRectMake(0, 0, pixelSize.width, pixelSize.height)];
+    }];
+}
+
+@end
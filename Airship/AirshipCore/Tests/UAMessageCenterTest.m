@@ -6,6 +6,10 @@
 #import "UAUser.h"
 #import "UAInboxMessageList.h"
 #import "UAComponent+Internal.h"
+#import "UATestDispatcher.h"
+#import "UAAppStateTracker.h"
+#import "UAirship.h"
+#import "UARuntimeConfig.h"
 
 @interface UAMessageCenterTest : UABaseTest
 @property (nonatomic, strong) id mockDefaultUI;
@@ -13,6 +17,7 @@
 @property (nonatomic, strong) id mockUser;
 @property (nonatomic, strong) id mockDisplayDelegate;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
 @property (nonatomic, strong) UAMessageCenter *messageCenter;
 @end
 
@@ -22,6 +27,7 @@
     [super setUp];
 
     self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
     self.mockDefaultUI = [self strictMockForClass:[UADefaultMessageCenterUI class]];
     self.mockUser = [self mockForClass:[UAUser class]];
     self.mockMessageList = [self mockForClass:[UAInboxMessageList class]];
@@ -31,7 +37,8 @@
                                                                 user:self.mockUser
                                                          messageList:self.mockMessageList
                                                            defaultUI:self.mockDefaultUI
-                                                  notificationCenter:self.notificationCenter];
+                                                  notificationCenter:self.notificationCenter
+                                                          dispatcher:self.testDispatcher];
 }
 
 
@@ -106,4 +113,45 @@
     [self.mockMessageList verify];
 }
 
+- (void)testActivationOnFirstUse {
+    [[self.mockMessageList expect] loadSavedMessages];
+    XCTAssertEqual(self.mockMessageList, self.messageCenter.messageList);
+    [self.mockMessageList verify];
+
+    // Only loads once
+    [[self.mockMessageList reject] loadSavedMessages];
+    XCTAssertEqual(self.mockMessageList, self.messageCenter.messageList);
+    [self.mockMessageList verify];
+}
+
+- (void)testActivationAfterDelay {
+    id mockConfig = [self mockForClass:[UARuntimeConfig class]];
+    [[[mockConfig stub] andReturnValue:OCMOCK_VALUE((NSTimeInterval)10)] moduleActivationDelay];
+
+    id mockAirship = [self mockForClass:[UAirship class]];
+    [[[mockAirship stub] andReturn:mockConfig] config];
+
+    __block NSUInteger loadCount = 0;
+    [[[self.mockMessageList stub] andDo:^(NSInvocation *invocation) {
+        loadCount++;
+    }] loadSavedMessages];
+
+    __block NSUInteger refreshCount = 0;
+    [[[self.mockMessageList stub] andDo:^(NSInvocation *invocation) {
+        refreshCount++;
+    }] retrieveMessageListWithSuccessBlock:OCMOCK_ANY withFailureBlock:OCMOCK_ANY];
+
+    // Foreground refresh is deferred until activation
+    [self.notificationCenter postNotificationName:UAApplicationDidTransitionToForeground object:nil];
+    [self.messageCenter airshipReady:mockAirship];
+
+    [self.testDispatcher advanceTime:9];
+    XCTAssertEqual(0, loadCount);
+    XCTAssertEqual(0, refreshCount);
+
+    [self.testDispatcher advanceTime:1];
+    XCTAssertEqual(1, loadCount);
+    XCTAssertEqual(1, refreshCount);
+}
+
 @end
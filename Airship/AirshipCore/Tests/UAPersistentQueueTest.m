@@ -0,0 +1,167 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAPersistentQueue+Internal.h"
+#import "UAPersistentQueueLog+Internal.h"
+
+@interface UAPersistentQueueTest : UABaseTest
+@property (nonatomic, strong) UAPersistentQueue *queue;
+@property (nonatomic, strong) NSURL *logURL;
+@end
+
+@implementation UAPersistentQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"test_queue"];
+    self.logURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager removeItemAtURL:self.logURL error:nil];
+
+    for (NSString *key in @[@"test_queue", @"legacy_queue"]) {
+        [fileManager removeItemAtURL:[UAPersistentQueue logURLWithDataStore:self.dataStore key:key] error:nil];
+    }
+
+    [super tearDown];
+}
+
+- (void)testQueue {
+    [self.queue addObject:@"one"];
+    [self.queue addObjects:@[@"two", @"three"]];
+
+    XCTAssertEqualObjects(@"one", [self.queue peekObject]);
+    XCTAssertEqualObjects((@[@"one", @"two", @"three"]), [self.queue objects]);
+
+    XCTAssertEqualObjects(@"one", [self.queue popObject]);
+    XCTAssertEqualObjects(@"two", [self.queue popObject]);
+    XCTAssertEqualObjects(@"three", [self.queue popObject]);
+    XCTAssertNil([self.queue popObject]);
+    XCTAssertNil([self.queue peekObject]);
+    XCTAssertEqualObjects(@[], [self.queue objects]);
+}
+
+- (void)testSetObjectsAndClear {
+    [self.queue addObject:@"one"];
+    [self.queue setObjects:@[@"two", @"three"]];
+    XCTAssertEqualObjects((@[@"two", @"three"]), [self.queue objects]);
+
+    [self.queue clear];
+    XCTAssertEqualObjects(@[], [self.queue objects]);
+}
+
+- (void)testPersistence {
+    [self.queue addObjects:@[@"one", @"two", @"three"]];
+    [self.queue popObject];
+
+    UAPersistentQueue *queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"test_queue"];
+    XCTAssertEqualObjects((@[@"two", @"three"]), [queue objects]);
+}
+
+- (void)testMigrateFromDataStore {
+    NSData *encoded = [NSKeyedArchiver archivedDataWithRootObject:@[@"one", @"two"]];
+    [self.dataStore setObject:encoded forKey:@"legacy_queue"];
+
+    UAPersistentQueue *queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"legacy_queue"];
+    XCTAssertEqualObjects((@[@"one", @"two"]), [queue objects]);
+    XCTAssertNil([self.dataStore objectForKey:@"legacy_queue"]);
+
+    // Migrated objects are not duplicated by new instances
+    queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"legacy_queue"];
+    XCTAssertEqualObjects((@[@"one", @"two"]), [queue objects]);
+}
+
+/**
+ * Test a queue keeps using the same log file, and that clearing the data store empties it.
+ */
+- (void)testClearedDataStore {
+    NSURL *logURL = [UAPersistentQueue logURLWithDataStore:self.dataStore key:@"test_queue"];
+    XCTAssertEqualObjects(logURL, [UAPersistentQueue logURLWithDataStore:self.dataStore key:@"test_queue"]);
+    XCTAssertNotEqualObjects(logURL, [UAPersistentQueue logURLWithDataStore:self.dataStore key:@"legacy_queue"]);
+
+    [self.queue addObjects:@[@"one", @"two"]];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:logURL.path]);
+
+    [self.dataStore removeAll];
+
+    UAPersistentQueue *queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"test_queue"];
+    XCTAssertEqualObjects(@[], [queue objects]);
+
+    [queue addObject:@"three"];
+    queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"test_queue"];
+    XCTAssertEqualObjects(@[@"three"], [queue objects]);
+}
+
+- (void)testLogCompaction {
+    UAPersistentQueueLog *log = [UAPersistentQueueLog logWithURL:self.logURL];
+
+    // ~110 bytes per record
+    NSString *padding = [@"" stringByPaddingToLength:100 withString:@"-" startingAtIndex:0];
+    NSMutableArray *records = [NSMutableArray array];
+    for (int i = 0; i < 1000; i++) {
+        [records addObject:[[NSString stringWithFormat:@"%d %@", i, padding] dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    XCTAssertTrue([log appendRecords:records]);
+
+    for (int i = 0; i < 900; i++) {
+        XCTAssertEqualObjects(records[i], [log popRecord]);
+    }
+
+    // Consumed records were reclaimed
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:self.logURL.path error:nil];
+    XCTAssertLessThan([attributes fileSize], 60000ULL);
+
+    XCTAssertEqual(100, log.count);
+    XCTAssertEqualObjects([records subarrayWithRange:NSMakeRange(900, 100)], [log records]);
+}
+
+- (void)testLogDiscardsIncompleteRecord {
+    UAPersistentQueueLog *log = [UAPersistentQueueLog logWithURL:self.logURL];
+    NSData *record = [@"record" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertTrue([log appendRecords:@[record]]);
+    log = nil;
+
+    // Simulate a crash partway through an append
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath:self.logURL.path];
+    [handle seekToEndOfFile];
+    uint32_t length = CFSwapInt32HostToLittle(100);
+    [handle writeData:[NSData dataWithBytes:&length length:sizeof(length)]];
+    [handle writeData:[@"partial" dataUsingEncoding:NSUTF8StringEncoding]];
+    [handle closeFile];
+
+    log = [UAPersistentQueueLog logWithURL:self.logURL];
+    XCTAssertEqual(1, log.count);
+    XCTAssertEqualObjects(@[record], [log records]);
+
+    NSData *next = [@"next" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertTrue([log appendRecords:@[next]]);
+    XCTAssertEqualObjects((@[record, next]), [log records]);
+}
+
+- (void)testPushPerformance {
+    [self measureBlock:^{
+        for (int i = 0; i < 10000; i++) {
+            [self.queue addObject:@(i)];
+        }
+        [self.queue clear];
+    }];
+}
+
+- (void)testPopPerformance {
+    NSMutableArray *objects = [NSMutableArray array];
+    for (int i = 0; i < 10000; i++) {
+        [objects addObject:@(i)];
+    }
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [self.queue setObjects:objects];
+
+        [self startMeasuring];
+        while ([self.queue popObject]) {}
+        [self stopMeasuring];
+    }];
+}
+
+@end
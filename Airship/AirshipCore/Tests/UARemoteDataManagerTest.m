@@ -25,9 +25,9 @@
 
 @implementation UATestRemoteDataStore
 
-- (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(BOOL))completionHandler {
+- (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(BOOL, NSSet<NSString *> *))completionHandler {
     if (self.failOverwriteCachedRemoteDataWithResponse) {
-        completionHandler(NO);
+        completionHandler(NO, [NSSet set]);
     } else {
         [super overwriteCachedRemoteDataWithResponse:remoteDataPayloads completionHandler:completionHandler];
     }
@@ -577,6 +577,45 @@
     [subscription dispose];
 }
 
+// two clients (test) subscribe to different types
+// simulate a change to only one of the types
+// only the subscriber of the changed type should be notified
+- (void)testOnlyChangedTypesAreNotified {
+    NSMutableArray<UARemoteDataPayload *> *testPayloads = [[self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata] mutableCopy];
+
+    __block XCTestExpectation *firstExpectation = [self expectationWithDescription:@"First subscriber received remote data"];
+    __block NSUInteger firstCallbackCount = 0;
+    UADisposable *firstSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[0].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        [firstExpectation fulfill];
+        firstCallbackCount++;
+    }];
+
+    __block XCTestExpectation *secondExpectation = [self expectationWithDescription:@"Second subscriber received remote data"];
+    __block NSUInteger secondCallbackCount = 0;
+    UADisposable *secondSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[1].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        [secondExpectation fulfill];
+        secondCallbackCount++;
+    }];
+
+    [self refresh];
+    [self waitForTestExpectations];
+
+    // change only the second payload
+    testPayloads[1] = [self changePayload:testPayloads[1]];
+    [self setupTestWithPayloads:testPayloads];
+    secondExpectation = [self expectationWithDescription:@"Second subscriber received changed remote data"];
+
+    [self refresh];
+    [self waitForTestExpectations];
+
+    XCTAssertEqual(1, firstCallbackCount);
+    XCTAssertEqual(2, secondCallbackCount);
+
+    // cleanup
+    [firstSubscription dispose];
+    [secondSubscription dispose];
+}
+
 /**
  * Test that the result is sorted by the subscribe order.
  */
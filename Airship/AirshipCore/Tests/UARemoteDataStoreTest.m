@@ -31,7 +31,7 @@
     
     UARemoteDataPayload *testPayload = [self createRemoteDataPayload];
     [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[testPayload]
-                            completionHandler:^(BOOL success) {
+                            completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
                                 XCTAssertTrue(success);
                             }];
     
@@ -60,7 +60,7 @@
     
     
     [self.remoteDataStore overwriteCachedRemoteDataWithResponse:testPayloads
-                                   completionHandler:^(BOOL success) {
+                                   completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
                                        XCTAssertTrue(success);
                                    }];
     
@@ -93,7 +93,7 @@
     
     // Sync only the modified message
     [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[testPayload]
-                                   completionHandler:^(BOOL success) {
+                                   completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
                                        XCTAssertTrue(success);
                             }];
     
@@ -116,6 +116,48 @@
     
 }
 
+- (void)testChangedTypes {
+    UARemoteDataPayload *first = [self createRemoteDataPayload];
+    UARemoteDataPayload *second = [self createRemoteDataPayload];
+
+    XCTestExpectation *initialSync = [self expectationWithDescription:@"initial sync"];
+    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[first, second] completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
+        XCTAssertTrue(success);
+        XCTAssertEqualObjects(([NSSet setWithArray:@[first.type, second.type]]), changedTypes);
+        [initialSync fulfill];
+    }];
+
+    // Same payloads
+    XCTestExpectation *unchangedSync = [self expectationWithDescription:@"unchanged sync"];
+    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[first, second] completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
+        XCTAssertTrue(success);
+        XCTAssertEqual(0, changedTypes.count);
+        [unchangedSync fulfill];
+    }];
+
+    // Update the first payload's timestamp and drop the second payload
+    UARemoteDataPayload *updated = [first copy];
+    updated.timestamp = [first.timestamp dateByAddingTimeInterval:60];
+    updated.data = @{@"updated": @YES};
+
+    XCTestExpectation *changedSync = [self expectationWithDescription:@"changed sync"];
+    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[updated] completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
+        XCTAssertTrue(success);
+        XCTAssertEqualObjects(([NSSet setWithArray:@[first.type, second.type]]), changedTypes);
+        [changedSync fulfill];
+    }];
+
+    XCTestExpectation *fetch = [self expectationWithDescription:@"fetched remote data"];
+    [self.remoteDataStore fetchRemoteDataFromCacheWithPredicate:nil completionHandler:^(NSArray<UARemoteDataStorePayload *> *remoteDataStorePayloads) {
+        XCTAssertEqual(1, remoteDataStorePayloads.count);
+        XCTAssertEqualObjects(updated.timestamp, remoteDataStorePayloads[0].timestamp);
+        XCTAssertEqualObjects(updated.data, remoteDataStorePayloads[0].data);
+        [fetch fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (UARemoteDataPayload *)createRemoteDataPayload {
     UARemoteDataPayload *testPayload = [[UARemoteDataPayload alloc] initWithType:[[NSProcessInfo processInfo] globallyUniqueString]
                                                                        timestamp:[NSDate date]
@@ -2,6 +2,8 @@
 
 #import "UABaseTest.h"
 #import "UARequest.h"
+#import "UAGzipCompressor+Internal.h"
+#import <zlib.h>
 
 @interface UARequestTest : UABaseTest
 @end
@@ -39,4 +41,215 @@
 
 }
 
+- (void)testGZIPBodyStream {
+    NSData *body = [self largeBody];
+
+    UARequest *dataRequest = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.body = body;
+        builder.compressBody = YES;
+    }];
+
+    UARequest *streamRequest = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.bodyStream = [NSInputStream inputStreamWithData:body];
+        builder.compressBody = YES;
+    }];
+
+    XCTAssertEqualObjects(dataRequest.body, streamRequest.body);
+    XCTAssertEqualObjects(streamRequest.headers[@"Content-Encoding"], @"gzip");
+}
+
+- (void)testBodyStream {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.bodyStream = [NSInputStream inputStreamWithData:[@"body" dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    XCTAssertEqualObjects(request.body, [@"body" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertNil(request.headers[@"Content-Encoding"]);
+}
+
+- (void)testGZIPCompressionLevel {
+    NSData *body = [self largeBody];
+
+    UARequest *fastest = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.body = body;
+        builder.compressBody = YES;
+        builder.compressionLevel = 0;
+    }];
+
+    UARequest *smallest = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.body = body;
+        builder.compressBody = YES;
+        builder.compressionLevel = 9;
+    }];
+
+    // Level 0 only stores the data
+    XCTAssertGreaterThan(fastest.body.length, body.length);
+    XCTAssertLessThan(smallest.body.length, body.length);
+}
+
+- (void)testInvalidCompressionLevel {
+    UARequestBuilder *builder = [[UARequestBuilder alloc] init];
+    builder.compressionLevel = 10;
+    XCTAssertEqual(UAGzipCompressionLevelDefault, builder.compressionLevel);
+
+    builder.compressionLevel = -2;
+    XCTAssertEqual(UAGzipCompressionLevelDefault, builder.compressionLevel);
+
+    builder.compressionLevel = 9;
+    XCTAssertEqual(9, builder.compressionLevel);
+}
+
+- (void)testGZIPEmptyBodyStream {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.bodyStream = [NSInputStream inputStreamWithData:[NSData data]];
+        builder.compressBody = YES;
+    }];
+
+    // No compressed body is produced, so the body is not marked as gzip
+    XCTAssertNil(request.body);
+    XCTAssertNil(request.headers[@"Content-Encoding"]);
+}
+
+- (void)testGZIPMatchesLegacyCompression {
+    NSData *body = [self largeBody];
+    XCTAssertEqualObjects([self legacyGzipCompress:body], [UAGzipCompressor compressData:body level:UAGzipCompressionLevelDefault]);
+}
+
+- (void)testConcurrentCompression {
+    NSData *body = [self largeBody];
+    NSData *expected = [UAGzipCompressor compressData:body level:UAGzipCompressionLevelDefault];
+
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        XCTAssertEqualObjects(expected, [UAGzipCompressor compressData:body level:UAGzipCompressionLevelDefault]);
+    });
+}
+
+- (void)testCompressorReuse {
+    UAGzipCompressor *compressor = [UAGzipCompressor compressorWithLevel:UAGzipCompressionLevelDefault];
+    NSData *body = [self largeBody];
+
+    // Compress in chunks
+    NSUInteger chunkSize = 1000;
+    for (NSUInteger offset = 0; offset < body.length; offset += chunkSize) {
+        NSRange range = NSMakeRange(offset, MIN(chunkSize, body.length - offset));
+        XCTAssertTrue([compressor appendData:[body subdataWithRange:range]]);
+    }
+    NSData *chunked = [compressor finish];
+
+    // Reuse the same compressor for the whole body
+    XCTAssertTrue([compressor appendData:body]);
+    NSData *whole = [compressor finish];
+
+    XCTAssertEqualObjects(chunked, whole);
+    XCTAssertEqualObjects(whole, [UAGzipCompressor compressData:body level:UAGzipCompressionLevelDefault]);
+    XCTAssertNil([compressor finish]);
+}
+
+- (void)testGZIPPerformance {
+    NSData *body = [self largeBody];
+
+    [self measureCompression:^{
+        for (int i = 0; i < 10; i++) {
+            [UAGzipCompressor compressData:body level:UAGzipCompressionLevelDefault];
+        }
+    }];
+}
+
+- (void)testGZIPStreamPerformance {
+    NSData *body = [self largeBody];
+
+    [self measureCompression:^{
+        for (int i = 0; i < 10; i++) {
+            UAGzipCompressor *compressor = [UAGzipCompressor compressorWithLevel:UAGzipCompressionLevelDefault];
+            [compressor appendStream:[NSInputStream inputStreamWithData:body]];
+            [compressor finish];
+        }
+    }];
+}
+
+/**
+ * Baseline for the performance tests above, using the previous single-shot implementation.
+ */
+- (void)testGZIPLegacyPerformance {
+    NSData *body = [self largeBody];
+
+    [self measureCompression:^{
+        for (int i = 0; i < 10; i++) {
+            [self legacyGzipCompress:body];
+        }
+    }];
+}
+
+/**
+ * Measures time and, where available, peak memory of a compression block.
+ */
+- (void)measureCompression:(void (^)(void))block {
+    if (@available(iOS 13.0, *)) {
+        [self measureWithMetrics:@[[[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init]] block:block];
+    } else {
+        [self measureBlock:block];
+    }
+}
+
+/**
+ * The previous request body compression, which grows a single output buffer in 32K steps.
+ */
+- (NSData *)legacyGzipCompress:(NSData *)uncompressedData {
+    if ([uncompressedData length] == 0) {
+        return nil;
+    }
+
+    z_stream strm;
+
+    NSUInteger chunkSize = 32768;
+
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.total_out = 0;
+    strm.next_in=(Bytef *)[uncompressedData bytes];
+    strm.avail_in = (uInt)[uncompressedData length];
+
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return nil;
+    }
+
+    int status;
+    NSMutableData *compressed = [NSMutableData dataWithLength:chunkSize];
+    do {
+        if (strm.total_out >= [compressed length]) {
+            [compressed increaseLengthBy:chunkSize];
+        }
+
+        strm.next_out = [compressed mutableBytes] + strm.total_out;
+        strm.avail_out = (uInt)([compressed length] - strm.total_out);
+
+        status = deflate(&strm, Z_FINISH);
+
+        if (status == Z_STREAM_ERROR) {
+            deflateEnd(&strm);
+            return nil;
+        }
+    } while (strm.avail_out == 0);
+
+    deflateEnd(&strm);
+
+    [compressed setLength: strm.total_out];
+    return compressed;
+}
+
+/**
+ * Roughly 1MB of analytics-like JSON.
+ */
+- (NSData *)largeBody {
+    NSMutableArray *events = [NSMutableArray array];
+    for (int i = 0; i < 5000; i++) {
+        [events addObject:@{@"event_id": [NSUUID UUID].UUIDString,
+                            @"time": [NSString stringWithFormat:@"%d", i],
+                            @"type": @"custom_event",
+                            @"data": @{@"event_name": @"purchase", @"session_id": @"session", @"properties": @{@"index": @(i)}}}];
+    }
+    return [NSJSONSerialization dataWithJSONObject:events options:0 error:nil];
+}
+
 @end
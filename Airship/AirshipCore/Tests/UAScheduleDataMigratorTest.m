@@ -141,6 +141,60 @@
     return data;
 }
 
+- (void)testMigration2To3 {
+    NSArray *data = [[self expectedDataFor1To2] arrayByAddingObject:[self messageDataFor2To3]];
+    [self executeTestFromVersion:2 toVersion:3 originalData:data expectedData:data];
+}
+
+- (NSDictionary *)messageDataFor2To3 {
+    return @{
+             @"message_id":@"message-id",
+             @"source":@"Remote-Data",
+             @"display_type":@"custom",
+             @"display":@{
+                     @"custom":@{}
+                     }
+             };
+}
+
+- (void)testMigration2To3Backfill {
+    UAScheduleData *scheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                                 inManagedObjectContext:self.managedContext];
+    scheduleData.data = [NSJSONSerialization stringWithObject:[self messageDataFor2To3]];
+    scheduleData.dataVersion = @(2);
+
+    // Rows written before version 3 have no projection
+    [scheduleData setPrimitiveValue:nil forKey:@"messageID"];
+    [scheduleData setPrimitiveValue:nil forKey:@"messageSource"];
+    [scheduleData setPrimitiveValue:nil forKey:@"lastUpdated"];
+
+    [UAScheduleDataMigrator migrateScheduleData:scheduleData oldVersion:2 newVersion:3];
+
+    XCTAssertEqual(3, [scheduleData.dataVersion unsignedIntegerValue]);
+    XCTAssertEqualObjects(@"message-id", scheduleData.messageID);
+    XCTAssertEqualObjects(@"remote-data", scheduleData.messageSource);
+    XCTAssertNotNil(scheduleData.lastUpdated);
+}
+
+- (void)testMessageProjection {
+    UAScheduleData *scheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                                 inManagedObjectContext:self.managedContext];
+
+    scheduleData.data = [NSJSONSerialization stringWithObject:@{@"source":@"Remote-Data", @"message_id":@"message-id"}];
+    XCTAssertEqualObjects(@"message-id", scheduleData.messageID);
+    XCTAssertEqualObjects(@"remote-data", scheduleData.messageSource);
+    XCTAssertNotNil(scheduleData.lastUpdated);
+
+    // Action schedules have no message
+    scheduleData.data = [NSJSONSerialization stringWithObject:@{@"add_tags_action":@"tag"}];
+    XCTAssertNil(scheduleData.messageID);
+    XCTAssertNil(scheduleData.messageSource);
+
+    scheduleData.data = nil;
+    XCTAssertNil(scheduleData.messageID);
+    XCTAssertNil(scheduleData.messageSource);
+}
+
 - (void)executeTestFromVersion:(NSUInteger)fromVersion toVersion:(NSUInteger)toVersion originalData:(NSArray<NSDictionary *> *)originalData expectedData:(NSArray<NSDictionary *> *)expectedData {
     XCTAssertEqual(originalData.count, expectedData.count);
     for (NSUInteger index = 0; index < originalData.count; index++) {
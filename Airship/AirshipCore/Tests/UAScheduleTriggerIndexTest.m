@@ -0,0 +1,64 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAScheduleTriggerIndex+Internal.h"
+#import "UACustomEvent.h"
+
+@interface UAScheduleTriggerIndexTest : UABaseTest
+@end
+
+@implementation UAScheduleTriggerIndexTest
+
+- (void)testEventNameMatcher {
+    NSDictionary *json = @{ @"scope": @[UACustomEventNameKey], @"value": @{ @"equals": @"purchase" } };
+    XCTAssertEqualObjects([NSSet setWithObject:@"purchase"], [UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    json = @{ @"key": UACustomEventNameKey, @"value": @{ @"equals": @"purchase" } };
+    XCTAssertEqualObjects([NSSet setWithObject:@"purchase"], [UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+}
+
+- (void)testUnconstrainedMatchers {
+    // Ignore case
+    NSDictionary *json = @{ @"key": UACustomEventNameKey, @"value": @{ @"equals": @"purchase" }, @"ignore_case": @(YES) };
+    XCTAssertNil([UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    // Other key
+    json = @{ @"key": @"event_value", @"value": @{ @"equals": @"purchase" } };
+    XCTAssertNil([UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    // Non equals matcher
+    json = @{ @"key": UACustomEventNameKey, @"value": @{ @"is_present": @(YES) } };
+    XCTAssertNil([UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    // Not
+    json = @{ @"not": @[ @{ @"key": UACustomEventNameKey, @"value": @{ @"equals": @"purchase" } } ] };
+    XCTAssertNil([UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    XCTAssertNil([UAScheduleTriggerIndex eventNamesForPredicateJSON:nil]);
+}
+
+- (void)testCompoundPredicates {
+    NSDictionary *purchase = @{ @"key": UACustomEventNameKey, @"value": @{ @"equals": @"purchase" } };
+    NSDictionary *view = @{ @"key": UACustomEventNameKey, @"value": @{ @"equals": @"view" } };
+    NSDictionary *value = @{ @"key": @"event_value", @"value": @{ @"at_least": @(10) } };
+
+    NSDictionary *json = @{ @"and": @[ value, purchase ] };
+    XCTAssertEqualObjects([NSSet setWithObject:@"purchase"], [UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    json = @{ @"or": @[ view, purchase ] };
+    NSSet *expected = [NSSet setWithArray:@[@"purchase", @"view"]];
+    XCTAssertEqualObjects(expected, [UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+
+    json = @{ @"or": @[ value, purchase ] };
+    XCTAssertNil([UAScheduleTriggerIndex eventNamesForPredicateJSON:json]);
+}
+
+- (void)testNotLoadedMatchesEverything {
+    UAScheduleTriggerIndex *index = [UAScheduleTriggerIndex index];
+    XCTAssertTrue([index containsTriggersWithType:UAScheduleTriggerScreen argument:@"screen"]);
+
+    [index loadTriggers:@[]];
+    XCTAssertFalse([index containsTriggersWithType:UAScheduleTriggerScreen argument:@"screen"]);
+}
+
+@end
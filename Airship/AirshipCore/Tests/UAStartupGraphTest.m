@@ -0,0 +1,87 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAStartupGraph+Internal.h"
+
+@interface UAStartupGraphTest : UABaseTest
+@property (nonatomic, strong) UAStartupGraph *graph;
+@property (nonatomic, strong) NSMutableArray<NSString *> *order;
+@end
+
+@implementation UAStartupGraphTest
+
+- (void)setUp {
+    [super setUp];
+    self.graph = [UAStartupGraph startupGraph];
+    self.order = [NSMutableArray array];
+}
+
+- (void)testDependencies {
+    [self.graph addMainThreadTask:@"c" dependencies:@[@"a", @"b"] block:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        [self record:@"c"];
+    }];
+
+    [self.graph addTask:@"a" dependencies:@[] block:^{
+        [self record:@"a"];
+    }];
+
+    [self.graph addTask:@"b" dependencies:@[@"a"] block:^{
+        XCTAssertFalse([NSThread isMainThread]);
+        [self record:@"b"];
+    }];
+
+    [self.graph addTask:@"d" dependencies:@[@"c"] block:^{
+        [self record:@"d"];
+    }];
+
+    [self.graph run];
+
+    XCTAssertEqualObjects((@[@"a", @"b", @"c", @"d"]), self.order);
+    XCTAssertEqual(4, self.graph.taskDurations.count);
+}
+
+- (void)testIndependentTasksRunConcurrently {
+    dispatch_semaphore_t first = dispatch_semaphore_create(0);
+    dispatch_semaphore_t second = dispatch_semaphore_create(0);
+
+    // Each task waits on the other, so they only finish if they run at the same time
+    [self.graph addTask:@"first" dependencies:@[] block:^{
+        dispatch_semaphore_signal(first);
+        XCTAssertEqual(0, dispatch_semaphore_wait(second, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)));
+    }];
+
+    [self.graph addTask:@"second" dependencies:@[] block:^{
+        dispatch_semaphore_signal(second);
+        XCTAssertEqual(0, dispatch_semaphore_wait(first, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)));
+    }];
+
+    [self.graph run];
+}
+
+- (void)testCyclicDependencies {
+    [self.graph addTask:@"a" dependencies:@[@"b"] block:^{
+        [self record:@"a"];
+    }];
+
+    [self.graph addMainThreadTask:@"b" dependencies:@[@"a"] block:^{
+        [self record:@"b"];
+    }];
+
+    [self.graph addTask:@"c" dependencies:@[@"missing"] block:^{
+        [self record:@"c"];
+    }];
+
+    [self.graph run];
+
+    // Remaining tasks run in the order they were added
+    XCTAssertEqualObjects((@[@"a", @"b", @"c"]), self.order);
+}
+
+- (void)record:(NSString *)name {
+    @synchronized (self.order) {
+        [self.order addObject:name];
+    }
+}
+
+@end
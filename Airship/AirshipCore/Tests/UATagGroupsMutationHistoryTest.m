@@ -30,7 +30,7 @@
     XCTAssertEqualObjects(mutation.payload, fromHistory.payload);
 }
 
-- (void)testAddingPendingMutationsDoesntCollapseMutations {
+- (void)testAddingPendingMutationsCollapsesMutations {
     UATagGroupsMutation *add = [UATagGroupsMutation mutationToAddTags:@[@"tag1"] group:@"group"];
     UATagGroupsMutation *remove = [UATagGroupsMutation mutationToRemoveTags:@[@"tag2", @"tag1"] group:@"group"];
 
@@ -39,13 +39,42 @@
 
     UATagGroupsMutation *fromHistory = [self.mutationHistory popPendingMutation:UATagGroupsTypeChannel];
 
-    NSDictionary *expected = @{ @"remove": @{ @"group": @[@"tag2", @"tag1"] }};
+    NSDictionary *expected = @{ @"remove": @{ @"group": @[@"tag2"] }, @"add": @{ @"group": @[@"tag1"] } };
     XCTAssertEqualObjects(expected, fromHistory.payload);
+    XCTAssertNil([self.mutationHistory popPendingMutation:UATagGroupsTypeChannel]);
+}
 
-    fromHistory = [self.mutationHistory popPendingMutation:UATagGroupsTypeChannel];
-    
-    expected = @{ @"add": @{ @"group": @[@"tag1"] }};
-    XCTAssertEqualObjects(expected, fromHistory.payload);
+- (void)testPendingMutationsPersist {
+    UATagGroupsMutation *set = [UATagGroupsMutation mutationToSetTags:@[@"tag1"] group:@"group1"];
+    UATagGroupsMutation *add = [UATagGroupsMutation mutationToAddTags:@[@"tag2"] group:@"group2"];
+
+    [self.mutationHistory addPendingMutation:add type:UATagGroupsTypeChannel];
+    [self.mutationHistory addPendingMutation:set type:UATagGroupsTypeChannel];
+
+    // A new history collapses the queued mutations
+    UATagGroupsMutationHistory *history = [UATagGroupsMutationHistory historyWithDataStore:self.dataStore];
+    XCTAssertEqualObjects(set.payload, [history popPendingMutation:UATagGroupsTypeChannel].payload);
+
+    // Mutations added after the pop are kept along with the remaining collapsed mutation
+    UATagGroupsMutation *remove = [UATagGroupsMutation mutationToRemoveTags:@[@"tag3"] group:@"group3"];
+    [history addPendingMutation:remove type:UATagGroupsTypeChannel];
+
+    history = [UATagGroupsMutationHistory historyWithDataStore:self.dataStore];
+    NSDictionary *expected = @{ @"add": @{ @"group2": @[@"tag2"] }, @"remove": @{ @"group3": @[@"tag3"] } };
+    XCTAssertEqualObjects(expected, [history popPendingMutation:UATagGroupsTypeChannel].payload);
+    XCTAssertNil([history popPendingMutation:UATagGroupsTypeChannel]);
+}
+
+- (void)testPeekedMutationIsNotChanged {
+    UATagGroupsMutation *add = [UATagGroupsMutation mutationToAddTags:@[@"tag1"] group:@"group"];
+    [self.mutationHistory addPendingMutation:add type:UATagGroupsTypeChannel];
+
+    UATagGroupsMutation *peekedMutation = [self.mutationHistory peekPendingMutation:UATagGroupsTypeChannel];
+
+    UATagGroupsMutation *remove = [UATagGroupsMutation mutationToRemoveTags:@[@"tag1"] group:@"group"];
+    [self.mutationHistory addPendingMutation:remove type:UATagGroupsTypeChannel];
+
+    XCTAssertEqualObjects(add.payload, peekedMutation.payload);
 }
 
 - (void)testCollapsePendingMutations {
@@ -99,12 +128,14 @@
 
     UATagGroupsMutationHistory *history = [UATagGroupsMutationHistory historyWithDataStore:self.dataStore];
 
-    UATagGroupsMutation *oldAddRemoveFromHistory = [history popPendingMutation:UATagGroupsTypeChannel];
-    NSDictionary *expected = @{ @"add": @{ @"group1": @[@"tag1"] }, @"remove": @{ @"group2": @[@"tag2"] } };
-    XCTAssertEqualObjects(expected, oldAddRemoveFromHistory.payload);
+    // The migrated mutations are collapsed
+    NSDictionary *payload = [history popPendingMutation:UATagGroupsTypeChannel].payload;
+    XCTAssertEqualObjects(@[@"tag2"], payload[@"remove"][@"group2"]);
+
+    NSSet *expectedAddTags = [NSSet setWithArray:@[@"tag1", @"foo", @"bar"]];
+    XCTAssertEqualObjects(expectedAddTags, [NSSet setWithArray:payload[@"add"][@"group1"]]);
 
-    UATagGroupsMutation *oldMutationFromHistory = [history popPendingMutation:UATagGroupsTypeChannel];
-    XCTAssertEqualObjects(oldMutation.payload, oldMutationFromHistory.payload);
+    XCTAssertNil([history popPendingMutation:UATagGroupsTypeChannel]);
 }
 
 - (void)testApplyMutations {
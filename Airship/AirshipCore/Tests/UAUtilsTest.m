@@ -219,6 +219,50 @@
     XCTAssertEqualWithAccuracy(seconds,0.123,0.0001);
 }
 
+- (void)testParseISO8601MatchesFormatters {
+    NSMutableArray *timestamps = [@[@"2020", @"2020-12", @"2020-12-15", @"2020-12-15T11", @"2020-12-15 11",
+                                    @"2020-12-15T11:45", @"2020-12-15 11:45", @"2020-12-15T11:45:22",
+                                    @"2020-12-15 11:45:22", @"2020-12-15T11:45:22.123", @"2020-12-15 11:45:22.123",
+                                    @"2020-02-29", @"2019-02-29", @"2020-02-30", @"2020-13-01", @"2020-00-10",
+                                    @"2020-12-15T24:00", @"2020-12-15T23:60", @"2020-12-15T23:59:60",
+                                    @"2000-01-01T00:00:00.000", @"1970-01-01", @"1969-12-31T23:59:59.999",
+                                    @"1583-01-01", @"1582-10-15", @"0001-01-01", @"9999-12-31T23:59:59.999",
+                                    @"2020-1-5", @"2020-12-15X11", @"2020/12/15", @"20201215", @"2020-12-15T11:45:22Z",
+                                    @"２０２０", @"", @"not a date"] mutableCopy];
+
+    srand48(42);
+    for (int i = 0; i < 1000; i++) {
+        NSTimeInterval interval = drand48() * 4000000000.0 - 1000000000.0;
+        NSString *timestamp = [[UAUtils ISODateFormatterUTCWithDelimiter] stringFromDate:[NSDate dateWithTimeIntervalSince1970:interval]];
+        [timestamps addObject:[timestamp stringByAppendingFormat:@".%03d", i % 1000]];
+        [timestamps addObject:[timestamp stringByReplacingOccurrencesOfString:@"T" withString:@" "]];
+    }
+
+    for (NSString *timestamp in timestamps) {
+        NSDate *expected = [UAUtils parseISO8601DateWithFormattersFromString:timestamp];
+        NSDate *date = [UAUtils parseISO8601DateFromString:timestamp];
+
+        if (expected) {
+            XCTAssertEqual(expected.timeIntervalSinceReferenceDate, date.timeIntervalSinceReferenceDate, @"%@", timestamp);
+        } else {
+            XCTAssertNil(date, @"%@", timestamp);
+        }
+    }
+}
+
+- (void)testParseISO8601Performance {
+    NSMutableArray *timestamps = [NSMutableArray array];
+    for (int i = 0; i < 1000; i++) {
+        [timestamps addObject:[NSString stringWithFormat:@"2020-%02d-%02dT%02d:%02d:%02d", (i % 12) + 1, (i % 28) + 1, i % 24, i % 60, (i * 7) % 60]];
+    }
+
+    [self measureBlock:^{
+        for (int i = 0; i < 100000; i++) {
+            [UAUtils parseISO8601DateFromString:timestamps[i % timestamps.count]];
+        }
+    }];
+}
+
 /**
  * Test isSilentPush is YES when no notification alerts exist in the payload.
  */
@@ -2,6 +2,7 @@
 
 #import "UABaseTest.h"
 #import "UAVersionMatcher.h"
+#import "UAUtils.h"
 
 @interface UAVersionMatcherTests : UABaseTest
 
@@ -317,4 +318,61 @@
     XCTAssertFalse([matcher evaluateObject:@"3.0"]);
     XCTAssertFalse([matcher evaluateObject:@"999.999.999"]);
 }
+
+- (void)testVersionRangeMatchesVersionComparison {
+    NSArray *versions = @[@"0", @"1", @"1.0", @"1.0.0.1", @"1.a", @"1.2a", @"1.10", @"2.0.0", @"10.0", @"a"];
+    NSArray *constraints = @[@"[1.0,2.0]", @"]1.0,2.0[", @"[1.2,)", @"(,1.10]", @"]0,1.0.0.1]"];
+
+    for (NSString *constraint in constraints) {
+        UAVersionMatcher *matcher = [UAVersionMatcher matcherWithVersionConstraint:constraint];
+        NSString *stripped = [[constraint substringWithRange:NSMakeRange(1, constraint.length - 2)] stringByReplacingOccurrencesOfString:@" " withString:@""];
+        NSArray *bounds = [stripped componentsSeparatedByString:@","];
+
+        for (NSString *version in versions) {
+            BOOL expected = YES;
+            if ([bounds[0] length]) {
+                NSComparisonResult result = [UAUtils compareVersion:bounds[0] toVersion:version];
+                expected &= [constraint hasPrefix:@"["] ? result != NSOrderedDescending : result == NSOrderedAscending;
+            }
+            if ([bounds[1] length]) {
+                NSComparisonResult result = [UAUtils compareVersion:version toVersion:bounds[1]];
+                expected &= [constraint hasSuffix:@"]"] ? result != NSOrderedDescending : result == NSOrderedAscending;
+            }
+
+            XCTAssertEqual(expected, [matcher evaluateObject:version], @"%@ %@", constraint, version);
+        }
+    }
+}
+
+- (void)testEvaluateNonString {
+    UAVersionMatcher *matcher = [UAVersionMatcher matcherWithVersionConstraint:@"+"];
+    XCTAssertFalse([matcher evaluateObject:@(1)]);
+    XCTAssertFalse([matcher evaluateObject:[NSNull null]]);
+}
+
+- (void)testEvaluatePerformance {
+    NSMutableArray<UAVersionMatcher *> *matchers = [NSMutableArray array];
+    for (int i = 0; i < 10000; i++) {
+        NSString *constraint;
+        switch (i % 3) {
+            case 0:
+                constraint = [NSString stringWithFormat:@"%d.%d", i % 20, i % 7];
+                break;
+            case 1:
+                constraint = [NSString stringWithFormat:@"%d.+", i % 20];
+                break;
+            default:
+                constraint = [NSString stringWithFormat:@"[%d.0, %d.%d[", i % 20, i % 20 + 1, i % 5];
+                break;
+        }
+        [matchers addObject:[UAVersionMatcher matcherWithVersionConstraint:constraint]];
+    }
+
+    [self measureBlock:^{
+        for (UAVersionMatcher *matcher in matchers) {
+            [matcher evaluateObject:@"12.3.1"];
+        }
+    }];
+}
+
 @end
@@ -219,6 +219,54 @@
     XCTAssertFalse(([self.whitelist isWhitelisted:[NSURL URLWithString:@"http://lololurbanairship.com"]]));
 }
 
+/**
+ * Test hosts are matched correctly when many domains are whitelisted.
+ */
+- (void)testManyHosts {
+    for (int i = 0; i < 500; i++) {
+        XCTAssertTrue([self.whitelist addEntry:[NSString stringWithFormat:@"https://*.domain%d.com", i]]);
+        XCTAssertTrue([self.whitelist addEntry:[NSString stringWithFormat:@"https://www.host%d.com/path/*", i]]);
+    }
+    XCTAssertTrue([self.whitelist addEntry:@"https://*.com" scope:UAWhitelistScopeOpenURL]);
+
+    // Accept
+    XCTAssertTrue([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://domain42.com"]]);
+    XCTAssertTrue([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://a.b.domain42.com/anything"]]);
+    XCTAssertTrue([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://www.host499.com/path/file"]]);
+    XCTAssertTrue([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://other.com"] scope:UAWhitelistScopeOpenURL]);
+
+    // Reject
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://other.com"]]);
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://xdomain42.com"]]);
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"http://domain42.com"]]);
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://host499.com/path/file"]]);
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://sub.www.host499.com/path/file"]]);
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://www.host499.com/other"]]);
+    XCTAssertFalse([self.whitelist isWhitelisted:[NSURL URLWithString:@"https://domain42.com.hackers.io"]]);
+}
+
+/**
+ * Measures lookups against a whitelist with hundreds of domains.
+ */
+- (void)testLookupPerformance {
+    for (int i = 0; i < 500; i++) {
+        [self.whitelist addEntry:[NSString stringWithFormat:@"https://*.domain%d.com", i]];
+        [self.whitelist addEntry:[NSString stringWithFormat:@"https://www.host%d.com/path/*", i]];
+    }
+
+    NSArray *urls = @[[NSURL URLWithString:@"https://www.domain250.com/index.html"],
+                      [NSURL URLWithString:@"https://www.host499.com/path/file"],
+                      [NSURL URLWithString:@"https://not.whitelisted.io"],
+                      [NSURL URLWithString:@"uairship://close"]];
+
+    NSUInteger iterations = 10000;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < iterations; i++) {
+            [self.whitelist isWhitelisted:urls[i % urls.count]];
+        }
+    }];
+}
+
 /**
  * Test wild card matcher matches any url that has a valid file path or http/https url.
  */
@@ -21,11 +21,9 @@ NSString *const UALocationBackgroundUpdatesAllowed = @"UALocationBackgroundUpdat
     self = [super initWithDataStore:dataStore];
 
     if (self) {
-        self.locationManager = [[CLLocationManager alloc] init];
         self.dataStore = dataStore;
         self.analytics = analytics;
         self.systemVersion = [UASystemVersion systemVersion];
-        self.locationManager.delegate = self;
 
         NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
 
@@ -66,6 +64,24 @@ NSString *const UALocationBackgroundUpdatesAllowed = @"UALocationBackgroundUpdat
     return [[self alloc] initWithDataStore:dataStore channel:channel analytics:analytics];
 }
 
+/**
+ * The location manager is created on first use so apps that never enable location
+ * updates do not set one up at launch. It is always created on the main thread so
+ * its delegate callbacks are delivered there.
+ */
+- (CLLocationManager *)locationManager {
+    __block CLLocationManager *locationManager;
+    [[UADispatcher mainDispatcher] doSync:^{
+        if (!self->_locationManager) {
+            self->_locationManager = [[CLLocationManager alloc] init];
+            self->_locationManager.delegate = self;
+        }
+        locationManager = self->_locationManager;
+    }];
+
+    return locationManager;
+}
+
 #pragma mark -
 #pragma mark Channel Registration
 
@@ -17,4 +17,5 @@
 #import "UAExtendableAnalyticsHeaders.h"
 #import "UAAppStateTracker.h"
 #import "UAChannel.h"
+#import "UADispatcher.h"
 #endif
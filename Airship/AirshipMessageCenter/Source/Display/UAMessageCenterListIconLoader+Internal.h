@@ -0,0 +1,85 @@
+/* Copyright Airship and Contributors */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Loads message list icons as thumbnails.
+ *
+ * Icons are downloaded asynchronously and downsampled while decoding to the pixel size they are
+ * displayed at, so the full size image is never decoded. Thumbnails are kept in a memory cache in
+ * front of an on-disk cache keyed by icon URL and pixel size, so icons survive memory warnings and
+ * relaunches without being downloaded again. The disk cache is kept under a byte budget by removing
+ * the least recently used thumbnails. Concurrent loads of the same thumbnail share a single download.
+ */
+@interface UAMessageCenterListIconLoader : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name List Icon Loader Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * The loader shared by the message center list view controllers.
+ *
+ * @return The shared loader.
+ */
++ (instancetype)sharedLoader;
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param cacheURL The directory for the disk cache.
+ * @param session The URL session used for downloads.
+ * @param byteBudget The maximum size of the disk cache in bytes.
+ * @return The loader.
+ */
++ (instancetype)loaderWithCacheURL:(NSURL *)cacheURL
+                           session:(NSURLSession *)session
+                        byteBudget:(unsigned long long)byteBudget;
+
+///---------------------------------------------------------------------------------------
+/// @name List Icon Loader Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Returns a thumbnail from the memory cache. Does not touch the disk or network.
+ *
+ * @param iconURL The icon URL.
+ * @param size The display size in points.
+ * @param scale The display scale.
+ * @return The thumbnail, or `nil` if it is not in the memory cache.
+ */
+- (nullable UIImage *)cachedIconWithURL:(NSURL *)iconURL size:(CGSize)size scale:(CGFloat)scale;
+
+/**
+ * Loads a thumbnail from the memory cache, the disk cache, or the network.
+ *
+ * @param iconURL The icon URL.
+ * @param size The display size in points. The thumbnail fills the size, keeping its aspect ratio.
+ * @param scale The display scale.
+ * @param completionHandler The completion handler, called on the main queue with the thumbnail or
+ * `nil` if the icon could not be loaded.
+ */
+- (void)loadIconWithURL:(NSURL *)iconURL
+                   size:(CGSize)size
+                  scale:(CGFloat)scale
+      completionHandler:(nullable void (^)(UIImage * _Nullable))completionHandler;
+
+/**
+ * Loads a thumbnail into the caches ahead of display.
+ *
+ * @param iconURL The icon URL.
+ * @param size The display size in points.
+ * @param scale The display scale.
+ */
+- (void)prefetchIconWithURL:(NSURL *)iconURL size:(CGSize)size scale:(CGFloat)scale;
+
+/**
+ * Removes all thumbnails from the memory cache. The disk cache is not affected.
+ */
+- (void)clearMemoryCache;
+
+@end
+
+NS_ASSUME_NONNULL_END
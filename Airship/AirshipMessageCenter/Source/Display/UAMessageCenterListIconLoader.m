@@ -0,0 +1,360 @@
+/* Copyright Airship and Contributors */
+
+#import <ImageIO/ImageIO.h>
+#import <MobileCoreServices/MobileCoreServices.h>
+
+#import "UAMessageCenterListIconLoader+Internal.h"
+#import "UAAirshipMessageCenterCoreImport.h"
+
+#define kUAMessageCenterListIconMemoryCacheMaxCount 100
+#define kUAMessageCenterListIconMemoryCacheMaxByteCost (8 * 1024 * 1024) /* 8MB */
+#define kUAMessageCenterListIconDiskCacheDefaultByteBudget (20 * 1024 * 1024) /* 20MB */
+
+@interface UAMessageCenterListIconLoader()
+@property (nonatomic, strong) NSURL *cacheURL;
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, assign) unsigned long long byteBudget;
+@property (nonatomic, strong) NSCache<NSString *, UIImage *> *memoryCache;
+@property (nonatomic, strong) dispatch_queue_t workQueue;
+
+// Guarded by pendingLoads, so loads started on the main thread never wait on disk work
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<void (^)(UIImage * _Nullable)> *> *pendingLoads;
+
+// Guarded by self
+@property (nonatomic, assign) unsigned long long diskCacheSize;
+@end
+
+@implementation UAMessageCenterListIconLoader
+
++ (instancetype)sharedLoader {
+    static UAMessageCenterListIconLoader *sharedLoader;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *cacheDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        NSURL *cacheURL = [NSURL fileURLWithPath:[cacheDirectory stringByAppendingPathComponent:@"com.urbanairship.messagecenter.listicons"]];
+        sharedLoader = [self loaderWithCacheURL:cacheURL
+                                        session:[NSURLSession sharedSession]
+                                     byteBudget:kUAMessageCenterListIconDiskCacheDefaultByteBudget];
+    });
+    return sharedLoader;
+}
+
++ (instancetype)loaderWithCacheURL:(NSURL *)cacheURL session:(NSURLSession *)session byteBudget:(unsigned long long)byteBudget {
+    return [[self alloc] initWithCacheURL:cacheURL session:session byteBudget:byteBudget];
+}
+
+- (instancetype)initWithCacheURL:(NSURL *)cacheURL session:(NSURLSession *)session byteBudget:(unsigned long long)byteBudget {
+    self = [super init];
+    if (self) {
+        self.cacheURL = cacheURL;
+        self.session = session;
+        self.byteBudget = byteBudget;
+        self.pendingLoads = [NSMutableDictionary dictionary];
+        self.memoryCache = [[NSCache alloc] init];
+        self.memoryCache.countLimit = kUAMessageCenterListIconMemoryCacheMaxCount;
+        self.memoryCache.totalCostLimit = kUAMessageCenterListIconMemoryCacheMaxByteCost;
+
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_CONCURRENT, QOS_CLASS_USER_INITIATED, 0);
+        self.workQueue = dispatch_queue_create("com.urbanairship.messagecenter.ListIconQueue", attributes);
+
+        NSError *error;
+        [[NSFileManager defaultManager] createDirectoryAtURL:cacheURL withIntermediateDirectories:YES attributes:nil error:&error];
+        if (error) {
+            UA_LERR(@"Unable to create list icon cache directory at %@: %@", cacheURL, error);
+        }
+
+        // A barrier, so no thumbnail is being written while stray temp files are removed
+        dispatch_barrier_async(self.workQueue, ^{
+            @synchronized (self) {
+                [self trimDiskCacheRemovingTemporaryFiles:YES];
+            }
+        });
+    }
+    return self;
+}
+
+- (nullable UIImage *)cachedIconWithURL:(NSURL *)iconURL size:(CGSize)size scale:(CGFloat)scale {
+    return [self.memoryCache objectForKey:[self cacheKeyWithURL:iconURL pixelSize:[self pixelSizeWithSize:size scale:scale]]];
+}
+
+- (void)prefetchIconWithURL:(NSURL *)iconURL size:(CGSize)size scale:(CGFloat)scale {
+    [self loadIconWithURL:iconURL size:size scale:scale completionHandler:nil];
+}
+
+- (void)loadIconWithURL:(NSURL *)iconURL
+                   size:(CGSize)size
+                  scale:(CGFloat)scale
+      completionHandler:(nullable void (^)(UIImage * _Nullable))completionHandler {
+    CGSize pixelSize = [self pixelSizeWithSize:size scale:scale];
+    if (!pixelSize.width || !pixelSize.height) {
+        [self callCompletionHandlers:completionHandler ? @[completionHandler] : @[] image:nil];
+        return;
+    }
+
+    NSString *key = [self cacheKeyWithURL:iconURL pixelSize:pixelSize];
+
+    UIImage *cachedImage = [self.memoryCache objectForKey:key];
+    if (cachedImage) {
+        [self callCompletionHandlers:completionHandler ? @[completionHandler] : @[] image:cachedImage];
+        return;
+    }
+
+    @synchronized (self.pendingLoads) {
+        // Share an in-flight load
+        NSMutableArray *pending = self.pendingLoads[key];
+        if (pending) {
+            if (completionHandler) {
+                [pending addObject:completionHandler];
+            }
+            return;
+        }
+
+        self.pendingLoads[key] = completionHandler ? [NSMutableArray arrayWithObject:completionHandler] : [NSMutableArray array];
+    }
+
+    UA_WEAKIFY(self)
+    dispatch_async(self.workQueue, ^{
+        UA_STRONGIFY(self)
+        UIImage *diskImage = [self diskThumbnailForKey:key scale:scale];
+        if (diskImage) {
+            [self finishLoadForKey:key image:diskImage];
+            return;
+        }
+
+        UA_LTRACE(@"Fetching list icon: %@", iconURL);
+        [[self.session dataTaskWithURL:iconURL completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+            UA_STRONGIFY(self)
+            NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 200;
+            if (error || !data.length || status < 200 || status > 299) {
+                UA_LDEBUG(@"Unable to fetch list icon: %@, status: %ld, error: %@", iconURL, (long)status, error);
+                [self finishLoadForKey:key image:nil];
+                return;
+            }
+
+            // Decode off the session's delegate queue
+            dispatch_async(self.workQueue, ^{
+                UA_STRONGIFY(self)
+                UIImage *image = [self thumbnailWithData:data pixelSize:pixelSize scale:scale];
+                if (image) {
+                    [self storeThumbnail:image forKey:key];
+                }
+                [self finishLoadForKey:key image:image];
+            });
+        }] resume];
+    });
+}
+
+- (void)clearMemoryCache {
+    [self.memoryCache removeAllObjects];
+}
+
+- (void)finishLoadForKey:(NSString *)key image:(nullable UIImage *)image {
+    if (image) {
+        CGImageRef imageRef = image.CGImage;
+        [self.memoryCache setObject:image forKey:key cost:CGImageGetHeight(imageRef) * CGImageGetBytesPerRow(imageRef)];
+    }
+
+    NSArray *completionHandlers;
+    @synchronized (self.pendingLoads) {
+        completionHandlers = self.pendingLoads[key];
+        [self.pendingLoads removeObjectForKey:key];
+    }
+
+    [self callCompletionHandlers:completionHandlers image:image];
+}
+
+- (void)callCompletionHandlers:(NSArray<void (^)(UIImage * _Nullable)> *)completionHandlers image:(nullable UIImage *)image {
+    if (!completionHandlers.count) {
+        return;
+    }
+
+    [[UADispatcher mainDispatcher] dispatchAsync:^{
+        for (void (^completionHandler)(UIImage * _Nullable) in completionHandlers) {
+            completionHandler(image);
+        }
+    }];
+}
+
+#pragma mark -
+#pragma mark Decoding
+
+/**
+ * Decodes an image straight to a thumbnail that fills the pixel size, without decoding the full size image.
+ */
+- (nullable UIImage *)thumbnailWithData:(NSData *)data pixelSize:(CGSize)pixelSize scale:(CGFloat)scale {
+    NSDictionary *sourceOptions = @{ (NSString *)kCGImageSourceShouldCache : @NO };
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, (__bridge CFDictionaryRef)sourceOptions);
+    if (!source) {
+        return nil;
+    }
+
+    // Reading the properties only parses the image header
+    NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+    CGFloat width = [properties[(NSString *)kCGImagePropertyPixelWidth] doubleValue];
+    CGFloat height = [properties[(NSString *)kCGImagePropertyPixelHeight] doubleValue];
+    if (!width || !height) {
+        CFRelease(source);
+        return nil;
+    }
+
+    // Orientations 5 through 8 are rotated a quarter turn
+    if ([properties[(NSString *)kCGImagePropertyOrientation] integerValue] >= 5) {
+        CGFloat swap = width;
+        width = height;
+        height = swap;
+    }
+
+    // The thumbnail size limits the longest side, so scale it to fill the pixel size without upscaling
+    CGFloat factor = MIN(MAX(pixelSize.width / width, pixelSize.height / height), 1);
+    NSDictionary *thumbnailOptions = @{ (NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                                        (NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                                        (NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+                                        (NSString *)kCGImageSourceThumbnailMaxPixelSize : @(ceil(MAX(width, height) * factor)) };
+
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)thumbnailOptions);
+    CFRelease(source);
+    if (!imageRef) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+#pragma mark -
+#pragma mark Disk Cache
+
+/**
+ * Reads and decodes a stored thumbnail, marking it as recently used.
+ */
+- (nullable UIImage *)diskThumbnailForKey:(NSString *)key scale:(CGFloat)scale {
+    NSURL *fileURL = [self.cacheURL URLByAppendingPathComponent:key];
+
+    NSDictionary *sourceOptions = @{ (NSString *)kCGImageSourceShouldCache : @NO };
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)fileURL, (__bridge CFDictionaryRef)sourceOptions);
+    if (!source) {
+        return nil;
+    }
+
+    // Decode now rather than on the main thread when first drawn
+    NSDictionary *imageOptions = @{ (NSString *)kCGImageSourceShouldCacheImmediately : @YES };
+    CGImageRef imageRef = CGImageSourceCreateImageAtIndex(source, 0, (__bridge CFDictionaryRef)imageOptions);
+    CFRelease(source);
+    if (!imageRef) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+
+    [[NSFileManager defaultManager] setAttributes:@{ NSFileModificationDate : [NSDate date] } ofItemAtPath:fileURL.path error:nil];
+
+    return image;
+}
+
+- (void)storeThumbnail:(UIImage *)image forKey:(NSString *)key {
+    NSURL *fileURL = [self.cacheURL URLByAppendingPathComponent:key];
+    NSURL *temporaryURL = [self.cacheURL URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.tmp", [NSUUID UUID].UUIDString]];
+
+    // PNG keeps the icon's alpha channel
+    CGImageDestinationRef destination = CGImageDestinationCreateWithURL((__bridge CFURLRef)temporaryURL, kUTTypePNG, 1, NULL);
+    if (!destination) {
+        return;
+    }
+
+    CGImageDestinationAddImage(destination, image.CGImage, NULL);
+    BOOL written = CGImageDestinationFinalize(destination);
+    CFRelease(destination);
+
+    NSFileManager *fm = [NSFileManager defaultManager];
+    if (!written) {
+        UA_LERR(@"Unable to write list icon thumbnail for key %@", key);
+        [fm removeItemAtURL:temporaryURL error:nil];
+        return;
+    }
+
+    unsigned long long size = [[fm attributesOfItemAtPath:temporaryURL.path error:nil] fileSize];
+
+    @synchronized (self) {
+        // An existing thumbnail for the key is replaced, so it no longer counts toward the cache size
+        NSDictionary *existingAttributes = [fm attributesOfItemAtPath:fileURL.path error:nil];
+        if (existingAttributes && [fm removeItemAtURL:fileURL error:nil]) {
+            self.diskCacheSize -= MIN(existingAttributes.fileSize, self.diskCacheSize);
+        }
+
+        NSError *error;
+        if (![fm moveItemAtURL:temporaryURL toURL:fileURL error:&error]) {
+            UA_LERR(@"Unable to store list icon thumbnail for key %@: %@", key, error);
+            [fm removeItemAtURL:temporaryURL error:nil];
+            return;
+        }
+
+        self.diskCacheSize += size;
+        if (self.diskCacheSize > self.byteBudget) {
+            [self trimDiskCacheRemovingTemporaryFiles:NO];
+        }
+    }
+}
+
+/**
+ * Removes the least recently used thumbnails until the disk cache is within its byte budget,
+ * and updates the cache size. Temp files left by an interrupted write are only removed when
+ * requested, as they may otherwise belong to a write in progress. Must be called while synchronized.
+ */
+- (void)trimDiskCacheRemovingTemporaryFiles:(BOOL)removeTemporaryFiles {
+    NSArray<NSURLResourceKey> *keys = @[NSURLContentModificationDateKey, NSURLFileSizeKey];
+    NSArray<NSURL *> *fileURLs = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.cacheURL
+                                                               includingPropertiesForKeys:keys
+                                                                                  options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                    error:nil];
+
+    NSMutableDictionary<NSURL *, NSDictionary *> *resources = [NSMutableDictionary dictionary];
+    unsigned long long size = 0;
+    for (NSURL *fileURL in fileURLs) {
+        if ([fileURL.pathExtension isEqualToString:@"tmp"]) {
+            if (removeTemporaryFiles) {
+                [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+            }
+            continue;
+        }
+
+        NSDictionary *values = [fileURL resourceValuesForKeys:keys error:nil];
+        if (values) {
+            resources[fileURL] = values;
+            size += [values[NSURLFileSizeKey] unsignedLongLongValue];
+        }
+    }
+
+    if (size > self.byteBudget) {
+        NSArray<NSURL *> *sortedURLs = [resources keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *values1, NSDictionary *values2) {
+            return [values1[NSURLContentModificationDateKey] compare:values2[NSURLContentModificationDateKey]];
+        }];
+
+        for (NSURL *fileURL in sortedURLs) {
+            if (size <= self.byteBudget) {
+                break;
+            }
+
+            if ([[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil]) {
+                size -= MIN([resources[fileURL][NSURLFileSizeKey] unsignedLongLongValue], size);
+            }
+        }
+    }
+
+    self.diskCacheSize = size;
+}
+
+#pragma mark -
+#pragma mark Utilities
+
+- (CGSize)pixelSizeWithSize:(CGSize)size scale:(CGFloat)scale {
+    return CGSizeMake(ceil(size.width * scale), ceil(size.height * scale));
+}
+
+- (NSString *)cacheKeyWithURL:(NSURL *)iconURL pixelSize:(CGSize)pixelSize {
+    NSString *key = [NSString stringWithFormat:@"%@|%.0fx%.0f", iconURL.absoluteString, pixelSize.width, pixelSize.height];
+    return [UAUtils sha256HashWithString:key];
+}
+
+@end
@@ -9,20 +9,19 @@
 #import "UAMessageCenterLocalization.h"
 #import "UAMessageCenterStyle.h"
 #import "UAMessageCenterResources.h"
+#import "UAMessageCenterListIconLoader+Internal.h"
 
 #import "UAAirshipMessageCenterCoreImport.h"
 
 
 
 /*
- * List-view image controls: default image path and cache values
+ * List-view image controls: default image path
  */
 #define kUAPlaceholderIconImage @"ua-inbox-icon-placeholder"
-#define kUAIconImageCacheMaxCount 100
-#define kUAIconImageCacheMaxByteCost (2 * 1024 * 1024) /* 2MB */
 #define kUAMessageCenterListCellNibName @"UAMessageCenterListCell"
 
-@interface UAMessageCenterListViewController()
+@interface UAMessageCenterListViewController() <UITableViewDataSourcePrefetching>
 
 /**
  * The placeholder image to display in lieu of the icon
@@ -39,6 +38,22 @@
  */
 @property (nonatomic, copy) NSArray *messages;
 
+/**
+ * A map of message IDs to the index of the message in messages.
+ */
+@property (nonatomic, copy) NSDictionary<NSString *, NSNumber *> *messageIndexMap;
+
+/**
+ * The IDs of the messages the table view is displaying, in row order.
+ */
+@property (nonatomic, copy) NSArray<NSString *> *displayedMessageIDs;
+
+/**
+ * The display state of each message the table view is displaying, keyed by message ID.
+ * Used to reload only the rows that changed.
+ */
+@property (nonatomic, copy) NSDictionary<NSString *, NSArray *> *displayedMessageStates;
+
 /**
  * The default tint color to use when overriding the inherited tint.
  */
@@ -75,19 +90,15 @@
 @property (nonatomic, assign) BOOL collapsed;
 
 /**
- * A dictionary of sets of (NSIndexPath *) with absolute URLs (NSString *) for keys.
- * Used to track current list icon fetches.
- * Try to use this on the main thread.
+ * Loads list icons as thumbnails sized for the icon view, backed by memory and disk caches.
  */
-@property (nonatomic, strong) NSMutableDictionary *currentIconURLRequests;
+@property (nonatomic, strong) UAMessageCenterListIconLoader *iconLoader;
 
 /**
- * An icon cache that stores UIImage representations of fetched icon images
- * The default limit is 1MB or 100 items
- * Images are also stored in the Airship HTTP Cache, so a re-fetch will typically only
- * incur the decoding (PNG->UIImage) costs.
+ * The size of the list icon view, in points. Zero until the first cell is configured.
+ * Used to size prefetched icons.
  */
-@property (nonatomic, strong) NSCache *iconCache;
+@property (nonatomic, assign) CGSize iconSize;
 
 /**
  * A refresh control used for "pull to refresh" behavior.
@@ -99,11 +110,6 @@
  */
 @property (nonatomic, assign) BOOL refreshControlAnimating;
 
-/**
- * A concurrent dispatch queue to use for fetching icon images.
- */
-@property (nonatomic, strong) dispatch_queue_t iconFetchQueue;
-
 /**
  * Split view controller managing the inbox and message views
  */
@@ -132,12 +138,8 @@
     if (self = [super initWithNibName:nibNameOrNil bundle:nibBundleOrNil]) {
         self.splitViewController = splitViewController;
         
-        self.iconCache = [[NSCache alloc] init];
-        self.iconCache.countLimit = kUAIconImageCacheMaxCount;
-        self.iconCache.totalCostLimit = kUAIconImageCacheMaxByteCost;
-        self.currentIconURLRequests = [NSMutableDictionary dictionary];
+        self.iconLoader = [UAMessageCenterListIconLoader sharedLoader];
         self.refreshControl = [[UIRefreshControl alloc] init];
-        self.iconFetchQueue = dispatch_queue_create("com.urbanairship.messagecenter.ListIconQueue", DISPATCH_QUEUE_CONCURRENT);
 
         // grab the default tint color from a dummy view
         self.defaultTintColor = [[UIView alloc] init].tintColor;
@@ -178,6 +180,9 @@
     tableController.refreshControl = self.refreshControl;
     tableController.clearsSelectionOnViewWillAppear = false;
 
+    // Load icons for rows about to scroll into view
+    self.messageTable.prefetchDataSource = self;
+
     [self applyStyle];
 
     // This allows us to use the UITableViewController for managing the refresh control, while keeping the
@@ -231,7 +236,9 @@
 
 - (void)didReceiveMemoryWarning {
     [super didReceiveMemoryWarning];
-    [self.iconCache removeAllObjects];
+
+    // Thumbnails remain in the disk cache
+    [self.iconLoader clearMemoryCache];
 }
 
 - (void)setFilter:(NSPredicate *)filter {
@@ -276,7 +283,7 @@
     [self applyMessageViewNavBarStyles];
 
     // apply styles to table cells
-    [self.messageTable reloadData];
+    [self reloadTableData];
 }
 
 - (void)applyToolbarItemStyles {
@@ -399,19 +406,17 @@
 }
 
 - (void)reload {
-    [self.messageTable reloadData];
+    [self updateTableRows];
     
     if (self.editing) {
         if (self.selectedMessageIDs.count > 0) {
             // re-select previously selected cells
             NSMutableArray *reSelectedMessageIDs = [[NSMutableArray alloc] init];
-            for (UAInboxMessage *message in self.messages) {
-                if ([self.selectedMessageIDs containsObject:message.messageID]) {
-                    NSIndexPath *selectedIndexPath = [self indexPathForMessage:message];
-                    if (selectedIndexPath) {
-                        [self.messageTable selectRowAtIndexPath:selectedIndexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
-                    }
-                    [reSelectedMessageIDs addObject:message.messageID];
+            for (NSString *messageID in self.selectedMessageIDs) {
+                NSIndexPath *selectedIndexPath = [self indexPathForMessage:[self messageForID:messageID]];
+                if (selectedIndexPath) {
+                    [self.messageTable selectRowAtIndexPath:selectedIndexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
+                    [reSelectedMessageIDs addObject:messageID];
                 }
             }
             [self.messageTable scrollToNearestSelectedRowAtScrollPosition:UITableViewScrollPositionNone animated:YES];
@@ -427,6 +432,113 @@
     }
 }
 
+/**
+ * Updates the table view to the current messages. If the table view is displaying a previous
+ * snapshot of the messages, only the rows that were inserted, deleted or changed are updated.
+ * Otherwise, the table view is reloaded.
+ */
+- (void)updateTableRows {
+    NSArray<NSString *> *previousIDs = self.displayedMessageIDs;
+    NSDictionary<NSString *, NSArray *> *previousStates = self.displayedMessageStates;
+    UITableView *messageTable = self.messageTable;
+
+    // Row updates are only safe when the table view's rows match the previous snapshot
+    if (!previousIDs || !messageTable.window || previousStates.count != previousIDs.count ||
+        self.messageIndexMap.count != self.messages.count ||
+        [messageTable numberOfRowsInSection:0] != (NSInteger)previousIDs.count) {
+        [self reloadTableData];
+        return;
+    }
+
+    NSMutableArray<NSIndexPath *> *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray<NSIndexPath *> *insertedIndexPaths = [NSMutableArray array];
+    NSMutableArray<NSIndexPath *> *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray<NSString *> *previousRetainedIDs = [NSMutableArray array];
+    NSMutableArray<NSString *> *retainedIDs = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NSNumber *> *previousIndexMap = [NSMutableDictionary dictionaryWithCapacity:previousIDs.count];
+
+    for (NSUInteger index = 0; index < previousIDs.count; index++) {
+        NSString *messageID = previousIDs[index];
+        previousIndexMap[messageID] = @(index);
+        if (self.messageIndexMap[messageID]) {
+            [previousRetainedIDs addObject:messageID];
+        } else {
+            [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:index inSection:0]];
+        }
+    }
+
+    for (NSUInteger index = 0; index < self.messages.count; index++) {
+        UAInboxMessage *message = self.messages[index];
+        NSNumber *previousIndex = previousIndexMap[message.messageID];
+        if (!previousIndex) {
+            [insertedIndexPaths addObject:[NSIndexPath indexPathForRow:index inSection:0]];
+            continue;
+        }
+
+        [retainedIDs addObject:message.messageID];
+
+        // Reloaded rows are identified by their index before the update
+        if (![previousStates[message.messageID] isEqualToArray:[self displayStateForMessage:message]]) {
+            [reloadedIndexPaths addObject:[NSIndexPath indexPathForRow:previousIndex.unsignedIntegerValue inSection:0]];
+        }
+    }
+
+    // Messages are not expected to move, so reload rather than computing moves
+    if (![previousRetainedIDs isEqualToArray:retainedIDs]) {
+        [self reloadTableData];
+        return;
+    }
+
+    [self captureDisplayedMessages];
+
+    if (!deletedIndexPaths.count && !insertedIndexPaths.count && !reloadedIndexPaths.count) {
+        return;
+    }
+
+    [messageTable performBatchUpdates:^{
+        [messageTable deleteRowsAtIndexPaths:deletedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+        [messageTable insertRowsAtIndexPaths:insertedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+        [messageTable reloadRowsAtIndexPaths:reloadedIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+    } completion:nil];
+}
+
+/**
+ * Reloads every row of the table view.
+ */
+- (void)reloadTableData {
+    [self.messageTable reloadData];
+    [self captureDisplayedMessages];
+}
+
+/**
+ * Records the messages the table view is displaying.
+ */
+- (void)captureDisplayedMessages {
+    NSMutableArray<NSString *> *messageIDs = [NSMutableArray arrayWithCapacity:self.messages.count];
+    NSMutableDictionary<NSString *, NSArray *> *messageStates = [NSMutableDictionary dictionaryWithCapacity:self.messages.count];
+
+    for (UAInboxMessage *message in self.messages) {
+        if (message.messageID) {
+            [messageIDs addObject:message.messageID];
+            messageStates[message.messageID] = [self displayStateForMessage:message];
+        }
+    }
+
+    self.displayedMessageIDs = messageIDs;
+    self.displayedMessageStates = messageStates;
+}
+
+/**
+ * Returns the values a message's cell displays. Messages are updated in place,
+ * so the values are copied rather than compared by message.
+ */
+- (NSArray *)displayStateForMessage:(UAInboxMessage *)message {
+    return @[@(message.unread),
+             message.title ?: @"",
+             message.messageSent ?: [NSNull null],
+             [self iconURLForMessage:message] ?: [NSNull null]];
+}
+
 - (void)handlePreviouslySelectedIndexPathsAnimated:(BOOL)animated {
     // If a cell was previously selected and there are messages to display
     if ((self.selectedMessage || self.selectedIndexPath) && (self.messages.count > 0)) {
@@ -823,6 +935,20 @@
     }
 }
 
+- (void)setMessages:(NSArray *)messages {
+    _messages = [messages copy];
+
+    NSMutableDictionary *messageIndexMap = [NSMutableDictionary dictionaryWithCapacity:_messages.count];
+    for (NSUInteger index = 0; index < _messages.count; index++) {
+        UAInboxMessage *message = _messages[index];
+        if (message.messageID) {
+            [messageIndexMap setObject:@(index) forKey:message.messageID];
+        }
+    }
+
+    self.messageIndexMap = messageIndexMap;
+}
+
 - (UAInboxMessage *)messageAtIndex:(NSUInteger)index {
     if (index < self.messages.count) {
         return [self.messages objectAtIndex:index];
@@ -832,31 +958,21 @@
 }
 
 - (NSUInteger)indexOfMessage:(UAInboxMessage *)messageToFind {
-    if (!messageToFind) {
+    if (!messageToFind.messageID) {
         return NSNotFound;
     }
-    
-    for (NSUInteger index = 0;index<self.messages.count;index++) {
-        UAInboxMessage *message = [self messageAtIndex:index];
-        if ([messageToFind.messageID isEqualToString:message.messageID]) {
-            return index;
-        }
-    }
-    
-    return NSNotFound;
+
+    NSNumber *index = [self.messageIndexMap objectForKey:messageToFind.messageID];
+    return index ? index.unsignedIntegerValue : NSNotFound;
 }
 
 - (UAInboxMessage *)messageForID:(NSString *)messageIDToFind {
     if (!messageIDToFind) {
         return nil;
-    } else {
-        for (UAInboxMessage *message in self.messages) {
-            if ([messageIDToFind isEqualToString:message.messageID]) {
-                return message;
-            }
-        }
-        return nil;
     }
+
+    NSNumber *index = [self.messageIndexMap objectForKey:messageIDToFind];
+    return index ? [self messageAtIndex:index.unsignedIntegerValue] : nil;
 }
 
 - (void)deleteMessageAtIndexPath:(NSIndexPath *)indexPath {
@@ -906,21 +1022,17 @@
     [cell setData:message];
 
     UIImageView *localImageView = cell.listIconView;
+    self.iconSize = localImageView.frame.size;
 
-    if ([self.iconCache objectForKey:[self iconURLStringForMessage:message]]) {
-        localImageView.image = [self.iconCache objectForKey:[self iconURLStringForMessage:message]];
-    } else {
-        [self retrieveIconForIndexPath:indexPath iconSize:localImageView.frame.size];
-
-        UIImage *placeholderIcon = self.placeholderIcon;
-
-        CGRect frame = cell.listIconView.frame;
-
-        // If a download is deferred or in progress, set a placeholder image
-        localImageView.image = placeholderIcon;
+    NSURL *iconURL = [self iconURLForMessage:message];
+    UIImage *cachedIcon = iconURL ? [self.iconLoader cachedIconWithURL:iconURL size:self.iconSize scale:self.iconScale] : nil;
 
-        // Resize to match the original frame if needed
-        cell.listIconView.frame = CGRectMake(frame.origin.x, frame.origin.y, CGRectGetWidth(frame), CGRectGetHeight(frame));
+    if (cachedIcon) {
+        localImageView.image = cachedIcon;
+    } else {
+        // If a load is in progress, or there is no icon, set a placeholder image
+        localImageView.image = self.placeholderIcon;
+        [self retrieveIconForMessage:message];
     }
 
     return cell;
@@ -966,6 +1078,22 @@
     self.navigationItem.rightBarButtonItem.enabled = YES;
 }
 
+#pragma mark -
+#pragma mark UITableViewDataSourcePrefetching
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    if (!self.style.iconsEnabled || CGSizeEqualToSize(self.iconSize, CGSizeZero)) {
+        return;
+    }
+
+    for (NSIndexPath *indexPath in indexPaths) {
+        NSURL *iconURL = [self iconURLForMessage:[self messageAtIndex:indexPath.row]];
+        if (iconURL) {
+            [self.iconLoader prefetchIconWithURL:iconURL size:self.iconSize scale:self.iconScale];
+        }
+    }
+}
+
 #pragma mark -
 #pragma mark UITableViewDelegate
 
@@ -1080,118 +1208,47 @@
 #pragma mark - List Icon Load + Fetch
 
 /**
- * Scales a source image to the provided size.
- */
-- (UIImage *)scaleImage:(UIImage *)source toSize:(CGSize)size {
-
-    CGFloat sourceWidth = source.size.width;
-    CGFloat sourceHeight = source.size.height;
-
-    CGFloat widthFactor = size.width / sourceWidth;
-    CGFloat heightFactor = size.height / sourceHeight;
-    CGFloat maxFactor = MAX(widthFactor, heightFactor);
-
-    CGFloat scaledWidth = truncf(sourceWidth * maxFactor);
-    CGFloat scaledHeight = truncf(sourceHeight * maxFactor);
-
-    CGAffineTransform transform = CGAffineTransformMakeScale(maxFactor, maxFactor);
-    CGSize transformSize = CGSizeApplyAffineTransform(source.size, transform);
-
-    // Note: passing 0.0 causes the function below to use the scale factor of the main screen
-    CGFloat transformScaleFactor = 0.0;
-
-    UIGraphicsBeginImageContextWithOptions(transformSize, NO, transformScaleFactor);
-
-    CGContextRef context = UIGraphicsGetCurrentContext();
-    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
-
-    [source drawInRect:CGRectMake(0, 0, scaledWidth, scaledHeight)];
-    UIImage* scaledImage = UIGraphicsGetImageFromCurrentImageContext();
-
-    UIGraphicsEndImageContext();
-
-    return scaledImage;
-}
-
-/**
- * Retrieves the list view icon for a given index path, if available.
+ * Loads the list view icon for a message, if it has one, and displays it in the cells still showing the message.
  */
-- (void)retrieveIconForIndexPath:(NSIndexPath *)indexPath iconSize:(CGSize)iconSize {
-
-    UAInboxMessage *message = [self messageAtIndex:indexPath.row];
-
-    NSString *iconListURLString = [self iconURLStringForMessage:message];
-
-    if (!iconListURLString) {
+- (void)retrieveIconForMessage:(UAInboxMessage *)message {
+    NSURL *iconURL = [self iconURLForMessage:message];
+    if (!iconURL || !self.style.iconsEnabled) {
         // Nothing to do here
         return;
     }
 
-    // If the icon isn't already in the cache
-    if (![self.iconCache objectForKey:iconListURLString]) {
-
-        NSURL *iconListURL = [NSURL URLWithString:iconListURLString];
-
-        // NOTE: All add/remove operations on the cache & in-progress set should be done
-        // on the main thread. They'll be cleared below in a dispatch_async/main queue block.
-
-        // Next, check to see if we're currently requesting the icon
-        // Add the index path to the set of paths to update when a request is completed and then proceed if necessary
-        NSMutableSet *currentRequestedIndexPaths = [self.currentIconURLRequests objectForKey:iconListURLString];
-        if (currentRequestedIndexPaths.count) {
-            [currentRequestedIndexPaths addObject:indexPath];
-            // Wait for the in-flight request to finish
+    UA_WEAKIFY(self)
+    [self.iconLoader loadIconWithURL:iconURL size:self.iconSize scale:self.iconScale completionHandler:^(UIImage *iconImage) {
+        UA_STRONGIFY(self)
+        if (!iconImage) {
             return;
-        } else {
-            // No in-flight request. Add and continue.
-            [self.currentIconURLRequests setValue:[NSMutableSet setWithObject:indexPath] forKey:iconListURLString];
         }
 
-        UA_WEAKIFY(self)
-
-        dispatch_async(self.iconFetchQueue, ^{
-            UA_STRONGIFY(self)
-
-            UA_LTRACE(@"Fetching RP Icon: %@", iconListURLString);
-
-            // Note: this decodes the source image at full size
-            NSData *iconImageData = [NSData dataWithContentsOfURL:iconListURL];
-            UIImage *iconImage = [UIImage imageWithData:iconImageData];
-            iconImage = [self scaleImage:iconImage toSize:iconSize];
-
-           [[UADispatcher mainDispatcher] dispatchAsync:^{
-                // Recapture self for the duration of this block
-                UA_STRONGIFY(self)
-
-                // Place the icon image in the cache and reload the row
-                if (iconImage) {
-
-                    NSUInteger sizeInBytes = CGImageGetHeight(iconImage.CGImage) * CGImageGetBytesPerRow(iconImage.CGImage);
-
-                    [self.iconCache setObject:iconImage forKey:iconListURLString];
-                    UA_LTRACE(@"Added image to cache (%@) with size in bytes: %lu", iconListURL, (unsigned long)sizeInBytes);
+        // Rows may have moved while loading, so match visible rows by icon URL.
+        // Update cells directly rather than forcing a reload (which deselects)
+        for (NSIndexPath *indexPath in self.messageTable.indexPathsForVisibleRows) {
+            if ([[self iconURLForMessage:[self messageAtIndex:indexPath.row]] isEqual:iconURL]) {
+                UAMessageCenterListCell *cell = (UAMessageCenterListCell *)[self.messageTable cellForRowAtIndexPath:indexPath];
+                cell.listIconView.image = iconImage;
+            }
+        }
+    }];
+}
 
-                    // Update cells directly rather than forcing a reload (which deselects)
-                    UAMessageCenterListCell *cell;
-                    for (NSIndexPath *indexPath in (NSSet *)[self.currentIconURLRequests objectForKey:iconListURLString]) {
-                        cell = (UAMessageCenterListCell *)[self.messageTable cellForRowAtIndexPath:indexPath];
-                        cell.listIconView.image = iconImage;
-                    }
-                }
-                
-                // Clear the request marker
-                [self.currentIconURLRequests removeObjectForKey:iconListURLString];
-           }];
-        });
-    }
+/**
+ * The scale list icons are displayed at.
+ */
+- (CGFloat)iconScale {
+    return self.messageTable.window.screen.scale ?: [UIScreen mainScreen].scale;
 }
 
 /**
  * Returns the URL for a given message's list view icon (or nil if not set).
  */
-- (NSString *)iconURLStringForMessage:(UAInboxMessage *) message {
+- (NSURL *)iconURLForMessage:(UAInboxMessage *)message {
     NSDictionary *icons = [message.rawMessageObject objectForKey:@"icons"];
-    return [icons objectForKey:@"list_icon"];
+    id iconURLString = [icons isKindOfClass:[NSDictionary class]] ? [icons objectForKey:@"list_icon"] : nil;
+    return [iconURLString isKindOfClass:[NSString class]] ? [NSURL URLWithString:iconURLString] : nil;
 }
 
 - (BOOL)collapsed {
@@ -15,7 +15,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Manager class for the Rich Push CoreData store. Use this class
- * to add, delete, fetch and update messages in the database.
+ * to add, delete, fetch and update messages in the database. The
+ * persistent store is opened on first use.
  */
 @interface UAInboxStore : NSObject
 
@@ -61,6 +62,16 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)syncMessagesWithResponse:(NSArray *)messages
                completionHandler:(void(^)(BOOL))completionHandler;
 
+/**
+ * Updates the inbox store with the array of messages, reporting which messages changed.
+ *
+ * @param messages An array of messages.
+ * @param changesHandler The handler with the sync result and the IDs of the messages that were
+ * inserted, updated or deleted. The IDs are empty if the sync failed.
+ */
+- (void)syncMessagesWithResponse:(NSArray *)messages
+                  changesHandler:(void(^)(BOOL success, NSSet<NSString *> *changedMessageIDs))changesHandler;
+
 
 /**
  * Waits for the store to become idle and then returns. Used by Unit Tests.
@@ -12,6 +12,7 @@
 @property (strong, nonatomic) NSManagedObjectContext *managedContext;
 @property (nonatomic, assign) BOOL inMemory;
 @property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL storeOpened;
 @end
 
 @implementation UAInboxStore
@@ -30,25 +31,6 @@
         self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
                                                                       concurrencyType:NSPrivateQueueConcurrencyType];
 
-        
-        UA_WEAKIFY(self);
-        [self.managedContext performBlock:^{
-            UA_STRONGIFY(self)
-            [self moveDatabase];
-        }];
-
-        void (^completion)(BOOL, NSError*) = ^void(BOOL success, NSError *error) {
-            if (!success) {
-                UA_LERR(@"Failed to create inbox message persistent store: %@", error);
-            }
-        };
-
-        if (inMemory) {
-            [self.managedContext addPersistentInMemoryStore:self.storeName completionHandler:completion];
-        } else {
-            [self.managedContext addPersistentSqlStore:self.storeName completionHandler:completion];
-        }
-
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(protectedDataAvailable)
                                                      name:UIApplicationProtectedDataDidBecomeAvailable
@@ -67,13 +49,44 @@
 }
 
 - (void)protectedDataAvailable {
-    if (!self.managedContext.persistentStoreCoordinator.persistentStores.count) {
-        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:^(BOOL success, NSError *error) {
-            if (!success) {
-                UA_LERR(@"Failed to create inbox persistent store: %@", error);
-                return;
-            }
-        }];
+    @synchronized(self) {
+        if (self.storeOpened && !self.managedContext.persistentStoreCoordinator.persistentStores.count) {
+            [self openStore];
+        }
+    }
+}
+
+/**
+ * Opens the persistent store on first use, so launches that never touch the inbox
+ * do not pay for the SQLite open and migration. Must be called while synchronized on self.
+ */
+- (void)openStoreIfNeeded {
+    if (self.storeOpened) {
+        return;
+    }
+
+    self.storeOpened = YES;
+
+    UA_WEAKIFY(self);
+    [self.managedContext performBlock:^{
+        UA_STRONGIFY(self)
+        [self moveDatabase];
+    }];
+
+    [self openStore];
+}
+
+- (void)openStore {
+    void (^completion)(BOOL, NSError*) = ^void(BOOL success, NSError *error) {
+        if (!success) {
+            UA_LERR(@"Failed to create inbox message persistent store: %@", error);
+        }
+    };
+
+    if (self.inMemory) {
+        [self.managedContext addPersistentInMemoryStore:self.storeName completionHandler:completion];
+    } else {
+        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:completion];
     }
 }
 
@@ -110,15 +123,31 @@
 }
 
 - (void)syncMessagesWithResponse:(NSArray *)messages completionHandler:(void(^)(BOOL))completionHandler {
+    [self syncMessagesWithResponse:messages changesHandler:^(BOOL success, NSSet<NSString *> *changedMessageIDs) {
+        completionHandler(success);
+    }];
+}
+
+- (void)syncMessagesWithResponse:(NSArray *)messages
+                  changesHandler:(void(^)(BOOL, NSSet<NSString *> *))changesHandler {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
-            completionHandler(NO);
+            changesHandler(NO, [NSSet set]);
+            return;
+        }
+
+        // Prefetch every stored message so the response can be applied without a fetch per message
+        NSMutableDictionary<NSString *, UAInboxMessageData *> *storedMessages = [[self fetchMessagesByID] mutableCopy];
+        if (!storedMessages) {
+            changesHandler(NO, [NSSet set]);
             return;
         }
 
+        NSMutableSet<NSString *> *changedMessageIDs = [NSMutableSet set];
+
         // Track the response messageIDs so we can remove any messages that are
         // no longer in the response.
-        NSMutableSet *newMessageIDs = [NSMutableSet set];
+        NSMutableSet *newMessageIDs = [NSMutableSet setWithCapacity:messages.count];
 
         for (NSDictionary *messagePayload in messages) {
             NSString *messageID = messagePayload[@"message_id"];
@@ -128,39 +157,76 @@
                 continue;
             }
 
-            if (![self updateMessageWithDictionary:messagePayload]) {
-                [self addMessageFromDictionary:messagePayload];
+            NSDictionary *messageDictionary = [UAInboxStore dictionaryWithoutNullValues:messagePayload];
+            UAInboxMessageData *data = storedMessages[messageID];
+
+            if (!data) {
+                data = (UAInboxMessageData *)[NSEntityDescription insertNewObjectForEntityForName:kUAInboxDBEntityName
+                                                                           inManagedObjectContext:self.managedContext];
+                [self updateMessageData:data withDictionary:messageDictionary];
+                storedMessages[messageID] = data;
+                [changedMessageIDs addObject:messageID];
+            } else if (!data.isGone && ![data.rawMessageObject isEqual:messageDictionary]) {
+                // The raw payload includes the message's last modified date, so unchanged messages are left alone
+                [self updateMessageData:data withDictionary:messageDictionary];
+                [changedMessageIDs addObject:messageID];
             }
 
             [newMessageIDs addObject:messageID];
         }
 
         // Delete any messages that are no longer in the array
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUAInboxDBEntityName];
-        request.predicate = [NSPredicate predicateWithFormat:@"NOT (messageID IN %@)", newMessageIDs];
-
-        NSError *error;
-        if (self.inMemory) {
-            request.includesPropertyValues = NO;
-            NSArray *events = [self.managedContext executeFetchRequest:request error:&error];
-            for (NSManagedObject *event in events) {
-                [self.managedContext deleteObject:event];
+        for (NSString *messageID in storedMessages) {
+            if (![newMessageIDs containsObject:messageID]) {
+                [self.managedContext deleteObject:storedMessages[messageID]];
+                [changedMessageIDs addObject:messageID];
             }
-        } else {
-            NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
-            [self.managedContext executeRequest:deleteRequest error:&error];
         }
 
-        completionHandler([self.managedContext safeSave]);
+        BOOL success = [self.managedContext safeSave];
+        changesHandler(success, success ? changedMessageIDs : [NSSet set]);
     }];
 }
 
-- (void)updateMessageData:(UAInboxMessageData *)data withDictionary:(NSDictionary *)dict {
+/**
+ * Fetches all stored messages in a single request. Must be called on the context's queue.
+ *
+ * @return A map of message ID to message data, or nil if the fetch failed.
+ */
+- (nullable NSDictionary<NSString *, UAInboxMessageData *> *)fetchMessagesByID {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUAInboxDBEntityName];
+    request.returnsObjectsAsFaults = NO;
 
-    dict = [dict dictionaryWithValuesForKeys:[[dict keysOfEntriesPassingTest:^BOOL(id key, id obj, BOOL *stop) {
-        return ![obj isEqual:[NSNull null]];
-    }] allObjects]];
+    NSError *error = nil;
+    NSArray<UAInboxMessageData *> *result = [self.managedContext executeFetchRequest:request error:&error];
 
+    if (error) {
+        UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
+        return nil;
+    }
+
+    NSMutableDictionary<NSString *, UAInboxMessageData *> *messages = [NSMutableDictionary dictionaryWithCapacity:result.count];
+    for (UAInboxMessageData *data in result) {
+        if (!data.messageID) {
+            UA_LERR(@"Deleting stored message without a message ID: %@", data);
+            [self.managedContext deleteObject:data];
+            continue;
+        }
+
+        // Drop duplicate rows so each message ID maps to a single row
+        if (messages[data.messageID]) {
+            UA_LERR(@"Deleting duplicate stored message: %@", data.messageID);
+            [self.managedContext deleteObject:data];
+            continue;
+        }
+
+        messages[data.messageID] = data;
+    }
+
+    return messages;
+}
+
+- (void)updateMessageData:(UAInboxMessageData *)data withDictionary:(NSDictionary *)dict {
     if (!data.isGone) {
         data.messageID = dict[@"message_id"];
         data.contentType = dict[@"content_type"];
@@ -181,43 +247,10 @@
     }
 }
 
-
-- (void)addMessageFromDictionary:(NSDictionary *)dictionary {
-    UAInboxMessageData *data = (UAInboxMessageData *)[NSEntityDescription insertNewObjectForEntityForName:kUAInboxDBEntityName
-                                                                                   inManagedObjectContext:self.managedContext];
-
-    [self updateMessageData:data withDictionary:dictionary];
-}
-
-- (BOOL)updateMessageWithDictionary:(NSDictionary *)dictionary {
-    NSString *messageID = dictionary[@"message_id"];
-    NSError *error = nil;
-
-    if (!messageID) {
-        UA_LDEBUG(@"Missing message ID: %@", dictionary);
-        return NO;
-    }
-
-    NSFetchRequest *request = [[NSFetchRequest alloc] init];
-    request.entity = [NSEntityDescription entityForName:kUAInboxDBEntityName
-                                 inManagedObjectContext:self.managedContext];
-    request.predicate = [NSPredicate predicateWithFormat:@"messageID == %@", messageID];
-    request.fetchLimit = 1;
-
-    NSArray *resultData = [self.managedContext executeFetchRequest:request error:&error];
-
-    if (error) {
-        UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
-    }
-
-    UAInboxMessageData *data;
-    if (resultData.count) {
-        data = [resultData lastObject];
-        [self updateMessageData:data withDictionary:dictionary];
-        return YES;
-    }
-    
-    return NO;
++ (NSDictionary *)dictionaryWithoutNullValues:(NSDictionary *)dict {
+    return [dict dictionaryWithValuesForKeys:[[dict keysOfEntriesPassingTest:^BOOL(id key, id obj, BOOL *stop) {
+        return ![obj isEqual:[NSNull null]];
+    }] allObjects]];
 }
 
 - (void)moveDatabase {
@@ -274,6 +307,7 @@
 - (void)safePerformBlock:(void (^)(BOOL))block {
     @synchronized(self) {
         if (!self.finished) {
+            [self openStoreIfNeeded];
             [self.managedContext safePerformBlock:block];
         }
     }
@@ -48,14 +48,14 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) NSArray<UAInboxMessage *> *messages;
 
 /**
- * A dictionary of messages mapped to their IDs
+ * A dictionary of messages mapped to their IDs. Updated in place as messages change.
  */
-@property (nonatomic, strong) NSDictionary *messageIDMap;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAInboxMessage *> *messageIDMap;
 
 /**
- * A dictionary of messages mapped to their URLs
+ * A dictionary of messages mapped to their URLs. Updated in place as messages change.
  */
-@property (nonatomic, strong) NSDictionary *messageURLMap;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAInboxMessage *> *messageURLMap;
 
 /**
  * Flag indicating whether the mesage list is enabled. Clear to disable. Set to enable.
@@ -25,9 +25,29 @@ extern NSString * const UAInboxMessageListWillUpdateNotification;
  *
  * Note: this notification is posted regardless of the type of update (retrieval, batch)
  * and regardless of the success/failure of the underlying operation.
+ *
+ * When the update was applied incrementally, the user info contains the IDs of the inserted,
+ * updated and deleted messages under `UAInboxMessageListInsertedMessageIDsKey`,
+ * `UAInboxMessageListUpdatedMessageIDsKey` and `UAInboxMessageListDeletedMessageIDsKey`.
+ * The user info is `nil` when the whole list was reloaded.
  */
 extern NSString * const UAInboxMessageListUpdatedNotification;
 
+/**
+ * User info key for the set of IDs of the messages added to the list.
+ */
+extern NSString * const UAInboxMessageListInsertedMessageIDsKey;
+
+/**
+ * User info key for the set of IDs of the messages in the list that changed.
+ */
+extern NSString * const UAInboxMessageListUpdatedMessageIDsKey;
+
+/**
+ * User info key for the set of IDs of the messages removed from the list.
+ */
+extern NSString * const UAInboxMessageListDeletedMessageIDsKey;
+
 @class UAInboxMessage;
 
 /**
@@ -13,6 +13,10 @@
 NSString * const UAInboxMessageListWillUpdateNotification = @"com.urbanairship.notification.message_list_will_update";
 NSString * const UAInboxMessageListUpdatedNotification = @"com.urbanairship.notification.message_list_updated";
 
+NSString * const UAInboxMessageListInsertedMessageIDsKey = @"inserted_message_ids";
+NSString * const UAInboxMessageListUpdatedMessageIDsKey = @"updated_message_ids";
+NSString * const UAInboxMessageListDeletedMessageIDsKey = @"deleted_message_ids";
+
 typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 
 @interface UAInboxMessageList()
@@ -20,6 +24,11 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 @property (nonatomic, strong) UADispatcher *dispatcher;
 @property (nonatomic, strong) UADate *date;
 
+/**
+ * Whether the messages have been loaded from the store. Until then, changes cannot be applied incrementally.
+ */
+@property (nonatomic, assign) BOOL loaded;
+
 @end
 
 @implementation UAInboxMessageList
@@ -97,20 +106,31 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 - (void)setMessages:(NSArray *)messages {
     _messages = [messages copy];
 
-    NSMutableDictionary *messageIDMap = [NSMutableDictionary dictionary];
-    NSMutableDictionary *messageURLMap = [NSMutableDictionary dictionary];
+    self.messageIDMap = [NSMutableDictionary dictionaryWithCapacity:_messages.count];
+    self.messageURLMap = [NSMutableDictionary dictionaryWithCapacity:_messages.count];
 
     for (UAInboxMessage *message in _messages) {
-        if (message.messageBodyURL.absoluteString) {
-            [messageURLMap setObject:message forKey:message.messageBodyURL.absoluteString];
-        }
-        if (message.messageID) {
-            [messageIDMap setObject:message forKey:message.messageID];
-        }
+        [self addMessageToMaps:message];
     }
+}
 
-    self.messageIDMap = [messageIDMap copy];
-    self.messageURLMap = [messageURLMap copy];
+- (void)addMessageToMaps:(UAInboxMessage *)message {
+    if (message.messageBodyURL.absoluteString) {
+        [self.messageURLMap setObject:message forKey:message.messageBodyURL.absoluteString];
+    }
+    if (message.messageID) {
+        [self.messageIDMap setObject:message forKey:message.messageID];
+    }
+}
+
+- (void)removeMessageFromMaps:(UAInboxMessage *)message {
+    NSString *messageURL = message.messageBodyURL.absoluteString;
+    if (messageURL && [self.messageURLMap objectForKey:messageURL] == message) {
+        [self.messageURLMap removeObjectForKey:messageURL];
+    }
+    if (message.messageID && [self.messageIDMap objectForKey:message.messageID] == message) {
+        [self.messageIDMap removeObjectForKey:message.messageID];
+    }
 }
 
 - (NSArray *)messages {
@@ -129,8 +149,8 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
     [self.notificationCenter postNotificationName:UAInboxMessageListWillUpdateNotification object:nil];
 }
 
-- (void)sendMessageListUpdatedNotification {
-    [self.notificationCenter postNotificationName:UAInboxMessageListUpdatedNotification object:nil];
+- (void)sendMessageListUpdatedNotificationWithChanges:(NSDictionary *)changes {
+    [self.notificationCenter postNotificationName:UAInboxMessageListUpdatedNotification object:nil userInfo:changes];
 }
 
 #pragma mark Update/Delete/Mark Messages
@@ -156,11 +176,11 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
         retrieveMessageListFailureBlock = nil;
     }];
 
-    void (^completionBlock)(BOOL) = ^(BOOL success){
+    // Changed message IDs are nil if the whole listing needs to be reloaded
+    void (^completionBlock)(BOOL, NSSet<NSString *> *) = ^(BOOL success, NSSet<NSString *> *changedMessageIDs){
         UA_STRONGIFY(self)
 
-        // Always refresh the listing even if it's a failure
-        [self refreshInboxWithCompletionHandler:^ {
+        void (^refreshCompletionHandler)(NSDictionary *) = ^(NSDictionary *changes) {
             if (self.retrieveOperationCount > 0) {
                 self.retrieveOperationCount--;
             }
@@ -173,8 +193,17 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                     retrieveMessageListFailureBlock();
                 }
             }
-            [self sendMessageListUpdatedNotification];
-        }];
+            [self sendMessageListUpdatedNotificationWithChanges:changes];
+        };
+
+        // Always refresh the listing even if it's a failure, so expired messages are removed
+        if (changedMessageIDs) {
+            [self refreshMessagesWithIDs:changedMessageIDs completionHandler:refreshCompletionHandler];
+        } else {
+            [self refreshInboxWithCompletionHandler:^{
+                refreshCompletionHandler(nil);
+            }];
+        }
     };
 
     // Fetch
@@ -187,22 +216,22 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
         UA_LDEBUG(@"Retrieve message list succeeded with status: %lu", (unsigned long)status);
 
         if (status == 200) {
-            [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+            [self.inboxStore syncMessagesWithResponse:messages changesHandler:^(BOOL success, NSSet<NSString *> *changedMessageIDs) {
                 UA_STRONGIFY(self)
                 if (!success) {
                     [self.client clearLastModifiedTime];
-                    completionBlock(NO);
+                    completionBlock(NO, nil);
                 } else {
-                    completionBlock(YES);
+                    completionBlock(YES, changedMessageIDs);
                 }
             }];
         } else {
             // 304
-            completionBlock(YES);
+            completionBlock(YES, [NSSet set]);
         }
     } onFailure:^(){
         UA_LDEBUG(@"Retrieve message list failed");
-        completionBlock(NO);
+        completionBlock(NO, [NSSet set]);
     }];
 
     return disposable;
@@ -239,8 +268,8 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                       messageData.unreadClient = NO;
                                   }
 
-                                  // Refresh the messages
-                                  [self refreshInboxWithCompletionHandler:^{
+                                  // Refresh the marked messages
+                                  [self refreshMessagesWithIDs:[NSSet setWithArray:messageIDs] completionHandler:^(NSDictionary *changes) {
                                       UA_STRONGIFY(self)
                                       if (self.batchOperationCount > 0) {
                                           self.batchOperationCount--;
@@ -250,7 +279,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                           inboxMessageListCompletionBlock();
                                       }
 
-                                      [self sendMessageListUpdatedNotification];
+                                      [self sendMessageListUpdatedNotificationWithChanges:changes];
                                   }];
 
                                   [self syncLocalMessageState];
@@ -292,8 +321,9 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                       messageData.deletedClient = YES;
                                   }
 
-                                  // Refresh the messages
-                                  [self refreshInboxWithCompletionHandler:^{
+                                  // Refresh the deleted messages
+                                  [self refreshMessagesWithIDs:[NSSet setWithArray:messageIDs] completionHandler:^(NSDictionary *changes) {
+                                      UA_STRONGIFY(self)
                                       if (self.batchOperationCount > 0) {
                                           self.batchOperationCount--;
                                       }
@@ -302,7 +332,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                           inboxMessageListCompletionBlock();
                                       }
 
-                                      [self sendMessageListUpdatedNotification];
+                                      [self sendMessageListUpdatedNotificationWithChanges:changes];
                                   }];
 
                                   [self syncLocalMessageState];
@@ -316,7 +346,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
     // First load
     [self sendMessageListWillUpdateNotification];
     [self refreshInboxWithCompletionHandler:^ {
-        [self sendMessageListUpdatedNotification];
+        [self sendMessageListUpdatedNotificationWithChanges:nil];
     }];
 }
 
@@ -325,7 +355,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 
 
 /**
- * Refreshes the publicly exposed inbox messages on the private context.
+ * Reloads all of the publicly exposed inbox messages on the private context.
  * The completion handler is executed on the main context.
  *
  * @param completionHandler Optional completion handler.
@@ -355,6 +385,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                       UA_LTRACE(@"Loaded saved messages: %@.", messages);
                                       self.unreadCount = unreadCount;
                                       self.messages = messages;
+                                      self.loaded = YES;
 
                                       if (completionHandler) {
                                           completionHandler();
@@ -363,6 +394,121 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                               }];
 }
 
+/**
+ * Refreshes only the given messages on the private context, applying them to the existing
+ * messages along with removing any expired messages. Reloads all of the messages instead if they
+ * have not been loaded yet. The completion handler is executed on the main context with the
+ * change set, or nil if all of the messages were reloaded.
+ *
+ * @param messageIDs The IDs of the messages that were inserted, updated or deleted in the store.
+ * @param completionHandler The completion handler.
+ */
+- (void)refreshMessagesWithIDs:(NSSet<NSString *> *)messageIDs completionHandler:(void (^)(NSDictionary * _Nullable))completionHandler {
+    NSString *predicateFormat = @"messageID IN %@ && (messageExpiration == nil || messageExpiration >= %@) && (deletedClient == NO || deletedClient == nil)";
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:predicateFormat, messageIDs, [self.date now]];
+
+    UA_WEAKIFY(self)
+    [self.inboxStore fetchMessagesWithPredicate:predicate
+                              completionHandler:^(NSArray<UAInboxMessageData *> *data) {
+                                  UA_STRONGIFY(self)
+                                  NSMutableDictionary<NSString *, UAInboxMessage *> *messages = [NSMutableDictionary dictionaryWithCapacity:data.count];
+                                  for (UAInboxMessageData *messageData in data) {
+                                      if (messageData.messageID) {
+                                          messages[messageData.messageID] = [self messageFromMessageData:messageData];
+                                      }
+                                  }
+
+                                  [self.dispatcher dispatchAsync:^{
+                                      UA_STRONGIFY(self)
+                                      if (!self.loaded) {
+                                          [self refreshInboxWithCompletionHandler:^{
+                                              completionHandler(nil);
+                                          }];
+                                          return;
+                                      }
+
+                                      NSDictionary *changes = [self applyMessages:messages forMessageIDs:messageIDs];
+                                      UA_LDEBUG(@"Inbox messages updated.");
+                                      UA_LTRACE(@"Applied message changes: %@.", changes);
+                                      completionHandler(changes);
+                                  }];
+                              }];
+}
+
+/**
+ * Applies refreshed messages to the existing messages, and removes any expired messages.
+ * Must be called on the main context.
+ *
+ * @param refreshedMessages The refreshed messages that are still visible, mapped to their IDs.
+ * @param messageIDs The IDs of the refreshed messages. IDs without a refreshed message are removed.
+ * @return The change set.
+ */
+- (NSDictionary *)applyMessages:(NSDictionary<NSString *, UAInboxMessage *> *)refreshedMessages
+                  forMessageIDs:(NSSet<NSString *> *)messageIDs {
+    NSDate *now = [self.date now];
+    NSMutableSet<NSString *> *insertedMessageIDs = [NSMutableSet set];
+    NSMutableSet<NSString *> *updatedMessageIDs = [NSMutableSet set];
+    NSMutableSet<NSString *> *deletedMessageIDs = [NSMutableSet set];
+
+    for (NSString *messageID in refreshedMessages) {
+        if (![self.messageIDMap objectForKey:messageID]) {
+            [insertedMessageIDs addObject:messageID];
+        }
+    }
+
+    NSMutableArray<UAInboxMessage *> *messages = [NSMutableArray arrayWithCapacity:_messages.count + insertedMessageIDs.count];
+    NSInteger unreadCount = 0;
+    BOOL needsSort = insertedMessageIDs.count > 0;
+
+    for (UAInboxMessage *message in _messages) {
+        UAInboxMessage *current = message;
+        if ([messageIDs containsObject:message.messageID]) {
+            current = refreshedMessages[message.messageID];
+        } else if (message.messageExpiration && [message.messageExpiration compare:now] == NSOrderedAscending) {
+            current = nil;
+        }
+
+        if (current != message) {
+            [self removeMessageFromMaps:message];
+            if (current) {
+                [updatedMessageIDs addObject:message.messageID];
+                needsSort = needsSort || (current.messageSent != message.messageSent && ![current.messageSent isEqualToDate:message.messageSent]);
+            } else {
+                [deletedMessageIDs addObject:message.messageID];
+                continue;
+            }
+        }
+
+        [messages addObject:current];
+        unreadCount += current.unread ? 1 : 0;
+    }
+
+    for (NSString *messageID in insertedMessageIDs) {
+        UAInboxMessage *message = refreshedMessages[messageID];
+        [messages addObject:message];
+        unreadCount += message.unread ? 1 : 0;
+    }
+
+    // Add after removing so replaced messages sharing a URL are not dropped
+    for (NSString *messageID in refreshedMessages) {
+        [self addMessageToMaps:refreshedMessages[messageID]];
+    }
+
+    if (needsSort) {
+        // Match the store's newest first order
+        [messages sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(UAInboxMessage *message1, UAInboxMessage *message2) {
+            return [(message2.messageSent ?: [NSDate distantPast]) compare:(message1.messageSent ?: [NSDate distantPast])];
+        }];
+    }
+
+    _messages = [messages copy];
+    self.unreadCount = unreadCount;
+
+    return @{ UAInboxMessageListInsertedMessageIDsKey : insertedMessageIDs,
+              UAInboxMessageListUpdatedMessageIDsKey : updatedMessageIDs,
+              UAInboxMessageListDeletedMessageIDsKey : deletedMessageIDs };
+}
+
 /**
  * Synchronizes local read messages state with the server, on the private context.
  */
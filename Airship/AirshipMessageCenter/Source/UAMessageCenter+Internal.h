@@ -38,13 +38,15 @@ NS_ASSUME_NONNULL_BEGIN
  * @param messageList The message list.
  * @param defaultUI The default UI.
  * @param notificationCenter The notification center.
+ * @param dispatcher The dispatcher used to delay activation.
  * @return A message center instance.
 */
 + (instancetype)messageCenterWithDataStore:(UAPreferenceDataStore *)dataStore
                                       user:(UAUser *)user
                                messageList:(UAInboxMessageList *)messageList
                                  defaultUI:(UADefaultMessageCenterUI *)defaultUI
-                        notificationCenter:(NSNotificationCenter *)notificationCenter;
+                        notificationCenter:(NSNotificationCenter *)notificationCenter
+                                dispatcher:(UADispatcher *)dispatcher;
 
 @end
 
@@ -68,7 +68,7 @@ extern NSString *const UAMessageDataScheme;
 @property (nonatomic, readonly) UADefaultMessageCenterUI *defaultUI;
 
 /**
- * The list of messages.
+ * The list of messages. Saved messages are loaded the first time the list is accessed.
  */
 @property (nonatomic, readonly) UAInboxMessageList *messageList;
 
@@ -15,6 +15,9 @@
 @property (nonatomic, strong) UADefaultMessageCenterUI *defaultUI;
 @property (nonatomic, strong) UAInboxMessageList *messageList;
 @property (nonatomic, strong) UAUser *user;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, assign) BOOL activated;
+@property (nonatomic, assign) BOOL refreshPending;
 @end
 
 @implementation UAMessageCenter
@@ -25,16 +28,18 @@ NSString *const UAMessageDataScheme = @"message";
                              user:(UAUser *)user
                       messageList:(UAInboxMessageList *)messageList
                         defaultUI:(UADefaultMessageCenterUI *)defaultUI
-               notificationCenter:(NSNotificationCenter *)notificationCenter {
+               notificationCenter:(NSNotificationCenter *)notificationCenter
+                       dispatcher:(UADispatcher *)dispatcher {
 
     self = [super initWithDataStore:dataStore];
     if (self) {
         self.user = user;
-        self.messageList = messageList;
+        _messageList = messageList;
         self.defaultUI = defaultUI;
+        self.dispatcher = dispatcher;
 
         self.user.enabled = self.componentEnabled;
-        self.messageList.enabled = self.componentEnabled;
+        _messageList.enabled = self.componentEnabled;
 
         [notificationCenter addObserver:self
                                selector:@selector(userCreated)
@@ -45,8 +50,6 @@ NSString *const UAMessageDataScheme = @"message";
                                selector:@selector(applicationDidTransitionToForeground)
                                    name:UAApplicationDidTransitionToForeground
                                  object:nil];
-
-        [self.messageList loadSavedMessages];
     }
 
     return self;
@@ -72,20 +75,58 @@ NSString *const UAMessageDataScheme = @"message";
                                       user:user
                                messageList:messageList
                                  defaultUI:defaultUI
-                        notificationCenter:notificationCenter];
+                        notificationCenter:notificationCenter
+                                dispatcher:[UADispatcher mainDispatcher]];
 }
 
 + (instancetype)messageCenterWithDataStore:(UAPreferenceDataStore *)dataStore
                                       user:(UAUser *)user
                                messageList:(UAInboxMessageList *)messageList
                                  defaultUI:(UADefaultMessageCenterUI *)defaultUI
-                        notificationCenter:(NSNotificationCenter *)notificationCenter {
+                        notificationCenter:(NSNotificationCenter *)notificationCenter
+                                dispatcher:(UADispatcher *)dispatcher {
 
     return [[self alloc] initWithDataStore:dataStore
                                       user:user
                                messageList:messageList
                                  defaultUI:defaultUI
-                        notificationCenter:notificationCenter];
+                        notificationCenter:notificationCenter
+                                dispatcher:dispatcher];
+}
+
+- (UAInboxMessageList *)messageList {
+    [self activateIfNeeded];
+    return _messageList;
+}
+
+- (void)airshipReady:(UAirship *)airship {
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAfter:airship.config.moduleActivationDelay block:^{
+        UA_STRONGIFY(self)
+        [self activateIfNeeded];
+    }];
+}
+
+/**
+ * Loads the saved messages, which opens the inbox store, the first time the message list is used
+ * or once the activation delay has passed, whichever comes first.
+ */
+- (void)activateIfNeeded {
+    BOOL refresh;
+    @synchronized (self) {
+        if (self.activated) {
+            return;
+        }
+
+        self.activated = YES;
+        refresh = self.refreshPending;
+    }
+
+    [_messageList loadSavedMessages];
+
+    if (refresh) {
+        [_messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:nil];
+    }
 }
 
 - (void)display:(BOOL)animated {
@@ -116,6 +157,14 @@ NSString *const UAMessageDataScheme = @"message";
 }
 
 - (void)applicationDidTransitionToForeground {
+    @synchronized (self) {
+        // Refresh once activated instead of opening the store on the launch path
+        if (!self.activated) {
+            self.refreshPending = YES;
+            return;
+        }
+    }
+
     [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:nil];
 }
 
@@ -125,7 +174,7 @@ NSString *const UAMessageDataScheme = @"message";
 
 - (void)onComponentEnableChange {
     self.user.enabled = self.componentEnabled;
-    self.messageList.enabled = self.componentEnabled;
+    _messageList.enabled = self.componentEnabled;
 }
 
 #pragma mark -